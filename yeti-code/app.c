@@ -19,6 +19,8 @@
  * at no charge.
  */
 
+#include "em_common.h"
+#include "app.h"
 #include "sl_sleeptimer.h"
 
 #include "gpio_led.h"
@@ -30,10 +32,12 @@
 #include "lcd.h"
 #include "debug_uart.h"
 #include "debug_log.h"
+#include "perf_probe.h"
 #include "beeper.h"
 #include "buzzer_pwm.h"
 #include "watchdog.h"
 #include "lcd.h"
+#include "screen.h"
 
 /*****************************
  * Local Defines
@@ -79,8 +83,14 @@ beeper_t    beeper = {.cfg.freq          = (CB_BUZ_PARAM_DATA1_FREQ_LOWER_LIMIT
                       .cfg.timer.ch      = 0,
                       .cfg.timer.freq    = BEEPER_TIMER_FREQUENCY_DEFAULT};
 
+static debug_log_t logger;
+static lcd_t       lcd;
+static screen_t    screen;
+static cbroker_t   cbroker;
+
 static uint8_t buttons_overall_status = 0;
 static uint8_t cycle_to_next_qr = 0;
+static volatile bool lcd_flush_idle = true; // No flush is running, the next QR code of the cycle can be shown
 //Definiton for lcd alignment
 static lcd_line_t lcd_layout[LCD_LINE_NUM] = {{0, LCD_LINE_PIXEL_HEIGHT}, {4, LCD_LINE_PIXEL_HEIGHT}, {1, LCD_LINE_PIXEL_HEIGHT}, {3, LCD_LINE_PIXEL_HEIGHT}};
 
@@ -108,6 +118,17 @@ void cycle_qr()
     }
 }
 
+/**
+ * @brief LCD flush end, interrupt context
+ */
+static void lcd_flush_done_cb(lcd_t *self, void *arg)
+{
+    (void)self;
+    (void)arg;
+    PERF_PROBE_BOOT(PERF_PROBE_BOOT_FIRST_FRAME)
+    lcd_flush_idle = true;
+}
+
 #pragma region buttons_callback
 
 /**
@@ -178,10 +199,13 @@ void pin_loopback_cb(uint8_t *status)
 /**
  * @brief Main callback function
  */
-void main_callback(cbroker_cmd_id_e                    cmd_id,
+void main_callback(void                               *arg,
+                   cbroker_cmd_id_e                    cmd_id,
                    const cbroker_request_data_t *const payload,
                    cbroker_response_data_t *const      output)
 {
+    screen_t *display = (screen_t *)arg;
+
     switch(cmd_id)
     {
         case DISP_READ_KEYS:
@@ -200,7 +224,8 @@ void main_callback(cbroker_cmd_id_e                    cmd_id,
                    For now, the circular buffer is very small to save memory but
                    can be increased if needed.
              */
-            lcd_put_line(payload->write_line.data, sizeof(payload->write_line.data), payload->write_line.line, 0);
+            screen_set_line(display, payload->write_line.line, payload->write_line.data,
+                            sizeof(payload->write_line.data));
             APP_PRINTF("App - WRITE_LINE[Line:0x%.2X, [%s]]\r\n", payload->write_line.line, payload->write_line.data);
         }
         break;
@@ -209,11 +234,11 @@ void main_callback(cbroker_cmd_id_e                    cmd_id,
             APP_PRINTF("App - SET_BGLIGHT[0x%.2X]\r\n", payload->set_bglight);
             if(CB_SET_BGLIGHT_DATA_ON == payload->set_bglight)
             {
-                lcd_gpio_backlight_on();
+                screen_set_backlight(display, true);
             }
             else if(CB_SET_BGLIGHT_DATA_OFF == payload->set_bglight)
             {
-                lcd_gpio_backlight_off();
+                screen_set_backlight(display, false);
             }
         }
         break;
@@ -314,13 +339,16 @@ void app_init(void)
     init_settings();
 
     debug_uart_init(&debug_uart);
-    debug_log_init(&debug_uart);
+    debug_log_init(&logger, &debug_uart);
     APP_PRINTF("App - Debug log initialized\r\n");
+    PERF_PROBE_INIT()
 
     led_d10_on();
     lcd_spi_init(&spi_port);
-    lcd_init(&spi_port, lcd_layout_full_height);
-    lcd_backlight_on();
+    lcd_init(&lcd, &spi_port, lcd_layout_full_height);
+    screen_init(&screen, &lcd);
+    screen_set_qr(&screen, qr_version_to_display);
+    screen_set_backlight(&screen, true);
 
     button_init(button_open_cb, button_close_cb, button_stop_cb, pin_loopback_cb, BUTTONS_DEBOUNCER_DELAY);
 
@@ -332,7 +360,7 @@ void app_init(void)
     beeper.set_percent(&beeper);
 
     powered_uart_init(&powered_uart);
-    cbroker_init(&powered_uart, main_callback);
+    cbroker_init(&cbroker, &powered_uart, main_callback, &screen);
 
 }
 
@@ -345,6 +373,7 @@ void app_process_action(void)
     uint8_t open_status = 0;
     uint8_t close_status = 0;
     uint8_t stop_status = 0;
+    PERF_PROBE_BEGIN(PERF_PROBE_APP_PROCESS_ACTION)
 
     button_poll_all();
 
@@ -371,15 +400,35 @@ void app_process_action(void)
     else{
     }
 
-    if(cycle_to_next_qr == 1)
+    // One QR code per flush while the cycle runs, as fast as the panel takes them
+    if((cycle_to_next_qr == 1) && lcd_flush_idle)
     {
         cycle_qr();
+        screen_set_qr(&screen, qr_version_to_display);
     }
 
-    lcd_clear();
-    lcd_put_qr_code(qr_version_to_display, 0, 0, 0, 0);
-    while(!lcd_update(1))
-    {
+    // Draws and commits only what changed since the last pass: in steady state nothing is drawn nor sent
+    screen_refresh(&screen);
 
+    // Returns right away, the committed pages go out from the SPI interrupt. Idle again from the completion of the
+    // last page, or right away if there was nothing to send
+    if(lcd_flush_idle)
+    {
+        lcd_flush_idle = false;
+        if(!lcd_flush_async(&lcd, lcd_flush_done_cb, 0))
+        {
+            lcd_flush_idle = true;
+        }
     }
+
+    PERF_PROBE_POLL()
+    app_idle();
+    PERF_PROBE_END(PERF_PROBE_APP_PROCESS_ACTION)
+}
+
+/**
+ * @brief Main loop idle hook, nothing to do on the target
+ */
+SL_WEAK void app_idle(void)
+{
 }
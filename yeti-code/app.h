@@ -28,4 +28,10 @@ void app_init(void);
  ******************************************************************************/
 void app_process_action(void);
 
+/***************************************************************************//**
+ * Main loop idle hook, called at the end of every app_process_action() pass.
+ * Empty on the target, the host build overrides it to advance its virtual clock.
+ ******************************************************************************/
+void app_idle(void);
+
 #endif  // APP_H
@@ -0,0 +1,71 @@
+/** @file bench_clock.h
+ *
+ * @brief Host timing helpers shared by the benchmarks: monotonic clock and the host ns to Cortex-M33 cycles scale.
+ *
+ * @author Rene Delgado
+ *
+ * @copyright 2023 The Chamberlain Group, LLC. All rights reserved. All
+ * information within this file and associated files, including all
+ * information and files transmitted with this file are CONFIDENTIAL
+ * and the proprietary property of The Chamberlain Group, LLC.
+ *
+ * In using the Licensed Software, Company shall not use with, combine, or
+ * incorporate any viral open source software with or into any of the Licensed
+ * Software in a manner that would require any portion of the Licensed software to
+ * be (i) disclosed or distributed in source code form; (ii) licensed for the
+ * purpose of making derivative works; or (iii) distributable or redistributable
+ * at no charge.
+ */
+
+#ifndef HOST_BENCH_INC_BENCH_CLOCK_H_
+#define HOST_BENCH_INC_BENCH_CLOCK_H_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define BENCH_CLOCK_CPU_HZ_DEFAULT (19000000UL) ///< SYSCLK: HFRCODPLL at its reset band, no HFRCO init in autogen.
+#define BENCH_CLOCK_NS_IN_S (1000000000ULL)
+
+/**
+ * @brief  Monotonic host time.
+ *
+ * @return Nanoseconds.
+ */
+uint64_t bench_clock_now_ns(void);
+
+/**
+ * @brief  Estimated Cortex-M33 cycles per host nanosecond.
+ *
+ * A dependent shift-and-add chain is timed: the M33 retires each step in one cycle (ADD with a shifted register).
+ * Host time converted with this ratio assumes the host runs the code under test at the IPC of an in-order M33, so
+ * the estimates are a lower bound: only the perf probes give the real count on target.
+ *
+ * @return M33 cycles per host ns.
+ */
+double bench_clock_m33_per_ns(void);
+
+/**
+ * @brief  Median cost of reading the clock, to subtract from single call samples.
+ *
+ * @return Nanoseconds.
+ */
+uint64_t bench_clock_overhead_ns(void);
+
+/**
+ * @brief  Median of samples, sorted in place.
+ *
+ * @param [in,out] samples - Samples.
+ * @param [in] count - Number of samples, at least 1.
+ * @return Median sample.
+ */
+uint64_t bench_clock_median(uint64_t *samples, uint32_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HOST_BENCH_INC_BENCH_CLOCK_H_ */
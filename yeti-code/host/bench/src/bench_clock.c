@@ -0,0 +1,87 @@
+/** @file bench_clock.c
+ *
+ * @brief Host timing helpers shared by the benchmarks.
+ *
+ * @author Rene Delgado
+ *
+ * @copyright 2023 The Chamberlain Group, LLC. All rights reserved. All
+ * information within this file and associated files, including all
+ * information and files transmitted with this file are CONFIDENTIAL
+ * and the proprietary property of The Chamberlain Group, LLC.
+ *
+ * In using the Licensed Software, Company shall not use with, combine, or
+ * incorporate any viral open source software with or into any of the Licensed
+ * Software in a manner that would require any portion of the Licensed software to
+ * be (i) disclosed or distributed in source code form; (ii) licensed for the
+ * purpose of making derivative works; or (iii) distributable or redistributable
+ * at no charge.
+ */
+
+#include <stdlib.h>
+#include <time.h>
+
+#include "bench_clock.h"
+
+#define BENCH_CLOCK_CALIBRATION_OPS (1U << 24) ///< Dependent ALU operations per calibration batch.
+#define BENCH_CLOCK_BATCHES (7U)               ///< Calibration batches, the fastest one is kept.
+#define BENCH_CLOCK_OVERHEAD_SAMPLES (1001U)   ///< Clock reads for the overhead median.
+
+uint64_t bench_clock_now_ns(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((uint64_t)now.tv_sec * BENCH_CLOCK_NS_IN_S) + (uint64_t)now.tv_nsec;
+}
+
+double bench_clock_m33_per_ns(void)
+{
+    uint32_t x    = 1;
+    uint64_t best = UINT64_MAX;
+
+    for(uint8_t batch = 0; batch < BENCH_CLOCK_BATCHES; batch++)
+    {
+        uint64_t start = bench_clock_now_ns();
+
+        for(uint32_t i = 0; i < BENCH_CLOCK_CALIBRATION_OPS; i++)
+        {
+            // The barrier keeps the chain: x is an input and an output of every step, and never read after it
+            x += (x >> 1);
+            __asm__ volatile("" : "+r"(x));
+        }
+        uint64_t elapsed = bench_clock_now_ns() - start;
+
+        if(elapsed < best)
+        {
+            best = elapsed;
+        }
+    }
+    return (double)BENCH_CLOCK_CALIBRATION_OPS / (double)best;
+}
+
+static int bench_clock_compare(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a;
+    uint64_t y = *(const uint64_t *)b;
+
+    return (x > y) - (x < y);
+}
+
+uint64_t bench_clock_median(uint64_t *samples, uint32_t count)
+{
+    qsort(samples, count, sizeof(samples[0]), bench_clock_compare);
+    return samples[count / 2U];
+}
+
+uint64_t bench_clock_overhead_ns(void)
+{
+    static uint64_t samples[BENCH_CLOCK_OVERHEAD_SAMPLES];
+
+    for(uint32_t i = 0; i < BENCH_CLOCK_OVERHEAD_SAMPLES; i++)
+    {
+        uint64_t start = bench_clock_now_ns();
+
+        samples[i] = bench_clock_now_ns() - start;
+    }
+    return bench_clock_median(samples, BENCH_CLOCK_OVERHEAD_SAMPLES);
+}
@@ -0,0 +1,601 @@
+/** @file cbroker_bench.c
+ *
+ * @brief Host microbenchmarks of the command broker byte path, with per byte budgets against the powered UART.
+ *
+ * @author Rene Delgado
+ *
+ * @copyright 2023 The Chamberlain Group, LLC. All rights reserved. All
+ * information within this file and associated files, including all
+ * information and files transmitted with this file are CONFIDENTIAL
+ * and the proprietary property of The Chamberlain Group, LLC.
+ *
+ * In using the Licensed Software, Company shall not use with, combine, or
+ * incorporate any viral open source software with or into any of the Licensed
+ * Software in a manner that would require any portion of the Licensed software to
+ * be (i) disclosed or distributed in source code form; (ii) licensed for the
+ * purpose of making derivative works; or (iii) distributable or redistributable
+ * at no charge.
+ */
+
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "bench_clock.h"
+
+// The byte path is made of static functions: the broker is built into this translation unit as is.
+#include "source/hal/src/command_broker.c"
+
+#define CBROKER_BENCH_BITS_PER_UART_BYTE (10U)    ///< 8N1: start + 8 data + stop.
+#define CBROKER_BENCH_BATCH_BYTES (1U << 20)      ///< Bytes pushed through a function per timed batch.
+#define CBROKER_BENCH_BATCHES (7U)                ///< Timed batches per function, the fastest one is kept.
+#define CBROKER_BENCH_PROFILE_REPS (1001U)        ///< Samples per byte position of the per byte profile.
+#define CBROKER_BENCH_FRAME_MAX (64U)             ///< Longest request frame in the corpus (WRITE_LINE is 49).
+#define CBROKER_BENCH_RESPONSE_FRAMING (3U)       ///< STX, ETX and NULL are not counted by cbroker_tx_fill_buff().
+
+/**
+ * @brief Request frame of the benchmark corpus.
+ */
+typedef struct
+{
+    cbroker_cmd_id_e cmd_id;                                ///< Command id.
+    uint8_t          payload[CB_BYTES_IN_WRITE_LINE_DATA]; ///< Binary payload.
+    uint8_t          payload_size;                          ///< Binary payload size.
+    uint8_t          bytes[CBROKER_BENCH_FRAME_MAX];       ///< Encoded frame, STX to ETX.
+    uint8_t          size;                                  ///< Encoded frame size.
+} cbroker_bench_frame_t;
+
+/**
+ * @brief Result of one benchmarked function.
+ */
+typedef struct
+{
+    const char *name;             ///< Function under test.
+    const char *unit;             ///< What a "byte" is for this function.
+    double      ns_per_byte;      ///< Host time per byte, fastest batch.
+    double      m33_per_byte;     ///< Estimated Cortex-M33 cycles per byte.
+    double      ns_per_call;      ///< Host time per call.
+    double      m33_per_call;     ///< Estimated Cortex-M33 cycles per call.
+    uint32_t    max_m33_per_byte; ///< Regression threshold.
+    bool        pass;             ///< Estimate within threshold.
+} cbroker_bench_result_t;
+
+/**
+ * @brief Command line options.
+ */
+typedef struct
+{
+    bool     json;       ///< Machine readable output.
+    uint32_t cpu_hz;     ///< Target core clock.
+    double   m33_per_ns; ///< Host ns to M33 cycles scale, 0 to calibrate.
+} cbroker_bench_options_t;
+
+/**
+ * @brief Regression thresholds, estimated M33 cycles per byte. 4 to 6 times the estimate on the reference host; a
+ * failure means the byte path got several times slower, not that a noisy run was slightly slower.
+ */
+enum
+{
+    CBROKER_BENCH_MAX_CRC16        = 100, ///< cborker_calc_crc16arc(), one byte per call as in cbroker_rx_byte().
+    CBROKER_BENCH_MAX_ASCIIHEX     = 20,  ///< cbroker_rx_asciihex_to_bin().
+    CBROKER_BENCH_MAX_FILL_DATA    = 30,  ///< cbroker_rx_fill_data_buffer().
+    CBROKER_BENCH_MAX_RX_BYTE      = 150, ///< cbroker_rx_byte(), mean over the corpus.
+    CBROKER_BENCH_MAX_TX_FILL_BUFF = 50,  ///< cbroker_tx_fill_buff(), per response byte.
+    CBROKER_BENCH_MAX_TX_CB        = 100, ///< cbroker_tx_cb(), per response byte.
+};
+
+static cbroker_bench_options_t options = {.json = false, .cpu_hz = BENCH_CLOCK_CPU_HZ_DEFAULT, .m33_per_ns = 0};
+static cbroker_bench_frame_t   corpus[DISP_CMD_ID_MAX - 1];
+static uint8_t                 corpus_size = 0;
+static volatile uint32_t       sink        = 0;
+static bool                    tx_pending  = false;
+static cbroker_t               broker;
+
+/************************************************ BROKER STAND-INS ***************************************************/
+
+static void cbroker_bench_request_callback(void *arg, cbroker_cmd_id_e cmd_id,
+                                           const cbroker_request_data_t *const payload,
+                                           cbroker_response_data_t *const      output)
+{
+    (void)arg;
+    (void)payload;
+    if(DISP_GET_VERSION == cmd_id)
+    {
+        output->version = 0x0046;
+    }
+    else if(DISP_READ_KEYS == cmd_id)
+    {
+        output->read_keys = 0x01;
+    }
+}
+
+// The response byte is only flagged: the benchmark plays the UART and completes it with cbroker_tx_cb().
+static int cbroker_bench_write_non_blocking(void *self, const uint8_t *buff, size_t size, callback_transmit_t callback)
+{
+    (void)self;
+    (void)size;
+    (void)callback;
+    sink       = sink + buff[0];
+    tx_pending = true;
+    return 0;
+}
+
+static int cbroker_bench_read_non_blocking(void *self, const uint8_t *buff, size_t size, callback_receive_t callback)
+{
+    (void)self;
+    (void)buff;
+    (void)size;
+    (void)callback;
+    return 0;
+}
+
+static base_driver bench_sercomm = {
+    .write_non_blocking = cbroker_bench_write_non_blocking,
+    .read_non_blocking  = cbroker_bench_read_non_blocking,
+    .handle             = &bench_sercomm,
+};
+
+/************************************************** REQUEST CORPUS ***************************************************/
+
+static void cbroker_bench_add_frame(cbroker_cmd_id_e cmd_id, const uint8_t *payload, uint8_t payload_size)
+{
+    cbroker_bench_frame_t *frame = &corpus[corpus_size];
+    char                   text[CBROKER_BENCH_FRAME_MAX];
+    int                    len   = 0;
+    uint16_t               crc   = 0;
+
+    frame->cmd_id       = cmd_id;
+    frame->payload_size = payload_size;
+    memcpy(frame->payload, payload, payload_size);
+
+    len = snprintf(text, sizeof(text), "%02X%02X", (unsigned)(0x10U + corpus_size), (unsigned)cmd_id);
+    for(uint8_t i = 0; i < payload_size; i++)
+    {
+        len += snprintf(&text[len], sizeof(text) - (size_t)len, "%02X", payload[i]);
+    }
+    crc = cborker_calc_crc16arc(0, text, (size_t)len);
+    len += snprintf(&text[len], sizeof(text) - (size_t)len, "%04X", crc);
+
+    frame->bytes[0] = CB_FRAME_BYTE_STX;
+    memcpy(&frame->bytes[1], text, (size_t)len);
+    frame->bytes[len + 1] = CB_FRAME_BYTE_ETX;
+    frame->size           = (uint8_t)(len + 2);
+    corpus_size++;
+}
+
+// One valid request per command, as sent by the main board.
+static void cbroker_bench_build_corpus(void)
+{
+    static const uint8_t read_keys[]   = {CB_READ_KEYS_DATA_LED_ON};
+    static const uint8_t set_bglight[] = {CB_SET_BGLIGHT_DATA_ON};
+    static const uint8_t language[]    = {CB_SET_LANGUAGE_DATA_ENGLISH};
+    static const uint8_t buz_param[]   = {CB_BUZ_PARAM_DATA0_FREQ, 0x28};
+    static const uint8_t buz_ctrl[]    = {CB_BUZ_CTRL_DATA0_ACTION_BEEP | 0x03, 0x04, 0x04};
+    uint8_t              write_line[CB_BYTES_IN_WRITE_LINE_DATA];
+
+    write_line[0] = CB_WRITE_LINE_DATA0_LINE_2;
+    memcpy(&write_line[1], "   DOOR CLOSING    ", CB_BYTES_IN_WRITE_LINE_DATA - 1);
+
+    cbroker_bench_add_frame(DISP_READ_KEYS, read_keys, sizeof(read_keys));
+    cbroker_bench_add_frame(DISP_WRITE_LINE, write_line, sizeof(write_line));
+    cbroker_bench_add_frame(DISP_SET_BGLIGHT, set_bglight, sizeof(set_bglight));
+    cbroker_bench_add_frame(DISP_CLEAR, NULL, 0);
+    cbroker_bench_add_frame(DISP_SET_LANGUAGE, language, sizeof(language));
+    cbroker_bench_add_frame(DISP_GET_VERSION, NULL, 0);
+    cbroker_bench_add_frame(DISP_BUZZER_PARAM, buz_param, sizeof(buz_param));
+    cbroker_bench_add_frame(DISP_BUZZER_CTRL, buz_ctrl, sizeof(buz_ctrl));
+}
+
+/**************************************************** BENCHMARKS *****************************************************/
+
+static void cbroker_bench_reset(void)
+{
+    cbroker_init(&broker, &bench_sercomm, cbroker_bench_request_callback, NULL);
+    tx_pending = false;
+}
+
+static void cbroker_bench_finish(cbroker_bench_result_t *result, uint64_t best_ns, uint32_t bytes, uint32_t calls)
+{
+    result->ns_per_byte  = (double)best_ns / (double)bytes;
+    result->ns_per_call  = (double)best_ns / (double)calls;
+    result->m33_per_byte = result->ns_per_byte * options.m33_per_ns;
+    result->m33_per_call = result->ns_per_call * options.m33_per_ns;
+    result->pass         = (result->m33_per_byte <= (double)result->max_m33_per_byte);
+}
+
+static void cbroker_bench_crc16(cbroker_bench_result_t *result)
+{
+    const cbroker_bench_frame_t *frame  = &corpus[DISP_WRITE_LINE - 1];
+    const uint32_t               text   = frame->size - CB_BYTES_IN_FRAME;
+    const uint32_t               rounds = CBROKER_BENCH_BATCH_BYTES / text;
+    uint64_t                     best   = UINT64_MAX;
+    uint16_t                     crc    = 0;
+
+    for(uint8_t batch = 0; batch < CBROKER_BENCH_BATCHES; batch++)
+    {
+        uint64_t start = bench_clock_now_ns();
+
+        for(uint32_t round = 0; round < rounds; round++)
+        {
+            // Each request restarts from 0, as cbroker_rx_validate_frame() clears crc16_calc.
+            crc = 0;
+            for(uint32_t i = 0; i < text; i++)
+            {
+                crc = cborker_calc_crc16arc(crc, &frame->bytes[1 + i], 1);
+            }
+            sink = crc;
+        }
+        uint64_t elapsed = bench_clock_now_ns() - start;
+
+        best = (elapsed < best) ? elapsed : best;
+    }
+    cbroker_bench_finish(result, best, rounds * text, rounds * text);
+}
+
+static void cbroker_bench_asciihex(cbroker_bench_result_t *result)
+{
+    static const char digits[] = "0123456789ABCDEF";
+    uint64_t          best     = UINT64_MAX;
+    uint32_t          sum      = 0;
+
+    cbroker_bench_reset();
+    for(uint8_t batch = 0; batch < CBROKER_BENCH_BATCHES; batch++)
+    {
+        uint64_t start = bench_clock_now_ns();
+
+        for(uint32_t i = 0; i < CBROKER_BENCH_BATCH_BYTES; i++)
+        {
+            uint8_t byte = (uint8_t)digits[i & 0x0FU];
+
+            cbroker_rx_asciihex_to_bin(&broker, &byte);
+            sum += byte;
+        }
+        uint64_t elapsed = bench_clock_now_ns() - start;
+
+        best = (elapsed < best) ? elapsed : best;
+    }
+    sink = sum;
+    cbroker_bench_finish(result, best, CBROKER_BENCH_BATCH_BYTES, CBROKER_BENCH_BATCH_BYTES);
+}
+
+static void cbroker_bench_fill_data(cbroker_bench_result_t *result)
+{
+    const uint32_t nibbles  = CB_NIBBLES_IN_A_BYTE * CB_BYTES_IN_WRITE_LINE_DATA;
+    const uint32_t payloads = CBROKER_BENCH_BATCH_BYTES / nibbles;
+    uint64_t       best     = UINT64_MAX;
+
+    cbroker_bench_reset();
+    broker.request.data[0].buff.cmd.id_with_status = DISP_WRITE_LINE | CB_CMD_ID_STATUS_BIT_NO_ERR;
+    for(uint8_t batch = 0; batch < CBROKER_BENCH_BATCHES; batch++)
+    {
+        uint64_t start = bench_clock_now_ns();
+
+        for(uint32_t payload = 0; payload < payloads; payload++)
+        {
+            // A new request starts from a cleared buffer, as cbroker_rx_validate_frame() leaves it.
+            memset(broker.request.data[0].buff.data.raw, 0x00, CB_BYTES_IN_WRITE_LINE_DATA);
+            for(uint32_t i = 0; i < nibbles; i++)
+            {
+                uint8_t nibble = (uint8_t)(i & 0x0FU);
+
+                sink = cbroker_rx_fill_data_buffer(&broker, &nibble);
+            }
+        }
+        uint64_t elapsed = bench_clock_now_ns() - start;
+
+        best = (elapsed < best) ? elapsed : best;
+    }
+    cbroker_bench_finish(result, best, payloads * nibbles, payloads * nibbles);
+}
+
+static void cbroker_bench_rx_byte(cbroker_bench_result_t *result)
+{
+    uint32_t corpus_bytes = 0;
+    uint32_t rounds       = 0;
+    uint64_t best         = UINT64_MAX;
+
+    for(uint8_t f = 0; f < corpus_size; f++)
+    {
+        corpus_bytes += corpus[f].size;
+    }
+    rounds = CBROKER_BENCH_BATCH_BYTES / corpus_bytes;
+
+    cbroker_bench_reset();
+    // Responses are queued but never started, the TX path is measured by cbroker_bench_tx_cb().
+    broker.response.state_machine.is_transmiting = true;
+    for(uint8_t batch = 0; batch < CBROKER_BENCH_BATCHES; batch++)
+    {
+        uint64_t start = bench_clock_now_ns();
+
+        for(uint32_t round = 0; round < rounds; round++)
+        {
+            for(uint8_t f = 0; f < corpus_size; f++)
+            {
+                for(uint8_t i = 0; i < corpus[f].size; i++)
+                {
+                    cbroker_rx_byte(&broker, corpus[f].bytes[i]);
+                }
+            }
+        }
+        uint64_t elapsed = bench_clock_now_ns() - start;
+
+        best = (elapsed < best) ? elapsed : best;
+    }
+    cbroker_bench_finish(result, best, rounds * corpus_bytes, rounds * corpus_bytes);
+}
+
+static void cbroker_bench_tx_fill_buff(cbroker_bench_result_t *result)
+{
+    uint32_t bytes = 0;
+    uint32_t calls = 0;
+    uint64_t best  = UINT64_MAX;
+
+    cbroker_bench_reset();
+    // GET_VERSION and BUZ_PARAM carry the longest response.
+    broker.request.data[0].buff.packet_number      = 0x46;
+    broker.request.data[0].buff.cmd.id_with_status = DISP_GET_VERSION | CB_CMD_ID_STATUS_BIT_NO_ERR;
+    for(uint8_t batch = 0; batch < CBROKER_BENCH_BATCHES; batch++)
+    {
+        uint64_t start = bench_clock_now_ns();
+
+        bytes = 0;
+        calls = 0;
+        while(bytes < CBROKER_BENCH_BATCH_BYTES)
+        {
+            bytes += cbroker_tx_fill_buff(&broker, broker.response.buff, 0) + CBROKER_BENCH_RESPONSE_FRAMING;
+            calls++;
+        }
+        uint64_t elapsed = bench_clock_now_ns() - start;
+
+        best = (elapsed < best) ? elapsed : best;
+    }
+    cbroker_bench_finish(result, best, bytes, calls);
+}
+
+// Sends one response per corpus request: STX from cbroker_tx_send_response(), every next byte from cbroker_tx_cb().
+static uint32_t cbroker_bench_send_responses(void)
+{
+    uint32_t bytes = 0;
+
+    for(uint8_t f = 0; f < corpus_size; f++)
+    {
+        broker.request.data[0].buff.packet_number      = (uint8_t)(0x10U + f);
+        broker.request.data[0].buff.cmd.id_with_status = corpus[f].cmd_id | CB_CMD_ID_STATUS_BIT_NO_ERR;
+        memcpy(broker.request.data[0].buff.data.raw, corpus[f].payload, corpus[f].payload_size);
+        broker.request.data[0].ack_status = CB_ACK_TO_BE_SEND;
+        broker.response.index             = 0;
+
+        cbroker_tx_send_response(&broker);
+        while(tx_pending)
+        {
+            tx_pending = false;
+            bytes++;
+            cbroker_tx_cb(0, &broker.response.txByte, 1);
+        }
+    }
+    return bytes;
+}
+
+static void cbroker_bench_tx_cb(cbroker_bench_result_t *result)
+{
+    uint32_t rounds = 0;
+    uint32_t bytes  = 0;
+    uint64_t best   = UINT64_MAX;
+
+    cbroker_bench_reset();
+    rounds = CBROKER_BENCH_BATCH_BYTES / cbroker_bench_send_responses();
+    for(uint8_t batch = 0; batch < CBROKER_BENCH_BATCHES; batch++)
+    {
+        uint64_t start = bench_clock_now_ns();
+
+        bytes = 0;
+        for(uint32_t round = 0; round < rounds; round++)
+        {
+            bytes += cbroker_bench_send_responses();
+        }
+        uint64_t elapsed = bench_clock_now_ns() - start;
+
+        best = (elapsed < best) ? elapsed : best;
+    }
+    cbroker_bench_finish(result, best, bytes, bytes);
+}
+
+/************************************************* PER BYTE PROFILE **************************************************/
+
+/**
+ * @brief The batches above give the mean, the UART budget needs the slowest byte: the ETX byte runs the request
+ * callback and queues the response. Every byte position of every request is timed alone and the median of the
+ * repetitions is kept, the worst position across the corpus is returned.
+ */
+static double cbroker_bench_worst_rx_byte_ns(uint8_t *worst_cmd, uint8_t *worst_pos)
+{
+    static uint64_t samples[CBROKER_BENCH_FRAME_MAX][CBROKER_BENCH_PROFILE_REPS];
+    uint64_t        overhead = bench_clock_overhead_ns();
+    uint64_t        worst    = 0;
+
+    cbroker_bench_reset();
+    broker.response.state_machine.is_transmiting = true;
+    for(uint8_t f = 0; f < corpus_size; f++)
+    {
+        for(uint32_t rep = 0; rep < CBROKER_BENCH_PROFILE_REPS; rep++)
+        {
+            for(uint8_t i = 0; i < corpus[f].size; i++)
+            {
+                uint64_t start = bench_clock_now_ns();
+
+                cbroker_rx_byte(&broker, corpus[f].bytes[i]);
+                samples[i][rep] = bench_clock_now_ns() - start;
+            }
+        }
+        for(uint8_t i = 0; i < corpus[f].size; i++)
+        {
+            uint64_t median = bench_clock_median(samples[i], CBROKER_BENCH_PROFILE_REPS);
+
+            median = (median > overhead) ? (median - overhead) : 0;
+            if(median > worst)
+            {
+                worst      = median;
+                *worst_cmd = corpus[f].cmd_id;
+                *worst_pos = i;
+            }
+        }
+    }
+    return (double)worst;
+}
+
+/****************************************************** REPORT *******************************************************/
+
+static void cbroker_bench_report(const cbroker_bench_result_t *results, uint8_t count, double worst_rx_ns,
+                                 uint8_t worst_cmd, uint8_t worst_pos)
+{
+    static const uint32_t bauds[] = {9600, 19200, 38400, 57600, 115200, 230400, 460800};
+    const double          scale   = options.m33_per_ns;
+    // An RX byte and a TX byte may complete in the same byte time: responses start on the command id. The slowest
+    // TX byte is the one filling the response buffer.
+    double   worst_tx     = results[count - 2].m33_per_call + results[count - 1].m33_per_byte;
+    double   worst_cycles = (worst_rx_ns * scale) + worst_tx;
+    uint64_t max_baud     = (uint64_t)(((double)options.cpu_hz * CBROKER_BENCH_BITS_PER_UART_BYTE) / worst_cycles);
+
+    if(options.json)
+    {
+        printf("{\n  \"cpu_hz\": %lu,\n  \"m33_cycles_per_host_ns\": %.4f,\n  \"functions\": [\n",
+               (unsigned long)options.cpu_hz, scale);
+        for(uint8_t i = 0; i < count; i++)
+        {
+            printf("    {\"name\": \"%s\", \"unit\": \"%s\", \"ns_per_byte\": %.3f, \"m33_cycles_per_byte\": %.1f, "
+                   "\"ns_per_call\": %.3f, \"m33_cycles_per_call\": %.1f, \"max_m33_cycles_per_byte\": %u, "
+                   "\"pass\": %s}%s\n",
+                   results[i].name, results[i].unit, results[i].ns_per_byte, results[i].m33_per_byte,
+                   results[i].ns_per_call, results[i].m33_per_call, results[i].max_m33_per_byte,
+                   results[i].pass ? "true" : "false", (i + 1U < count) ? "," : "");
+        }
+        printf("  ],\n  \"worst_rx_byte\": {\"cmd_id\": %u, \"position\": %u, \"m33_cycles\": %.1f},\n", worst_cmd,
+               worst_pos, worst_rx_ns * scale);
+        printf("  \"worst_tx_byte_m33_cycles\": %.1f,\n  \"worst_byte_time_m33_cycles\": %.1f,\n", worst_tx,
+               worst_cycles);
+        printf("  \"budget\": [\n");
+        for(uint8_t i = 0; i < sizeof(bauds) / sizeof(bauds[0]); i++)
+        {
+            double budget = ((double)options.cpu_hz * CBROKER_BENCH_BITS_PER_UART_BYTE) / bauds[i];
+
+            printf("    {\"baud\": %u, \"m33_cycles_per_byte_time\": %.0f, \"load_percent\": %.2f}%s\n", bauds[i],
+                   budget, (100.0 * worst_cycles) / budget, (i + 1U < sizeof(bauds) / sizeof(bauds[0])) ? "," : "");
+        }
+        printf("  ],\n  \"max_baud\": %llu\n}\n", (unsigned long long)max_baud);
+        return;
+    }
+
+    printf("command broker byte path, %.2f M33 cycles per host ns, M33 at %lu Hz\n", scale,
+           (unsigned long)options.cpu_hz);
+    printf("  %-28s %-18s %9s %10s %9s %10s %8s\n", "function", "per", "ns/byte", "cyc/byte", "ns/call", "cyc/call",
+           "limit");
+    for(uint8_t i = 0; i < count; i++)
+    {
+        printf("  %-28s %-18s %9.2f %10.1f %9.2f %10.1f %8u%s\n", results[i].name, results[i].unit,
+               results[i].ns_per_byte, results[i].m33_per_byte, results[i].ns_per_call, results[i].m33_per_call,
+               results[i].max_m33_per_byte, results[i].pass ? "" : "  REGRESSION");
+    }
+    printf("worst rx byte: command 0x%02X byte %u, %.1f cycles; worst tx byte %.1f cycles; "
+           "worst byte time %.1f cycles\n",
+           worst_cmd, worst_pos, worst_rx_ns * scale, worst_tx, worst_cycles);
+    for(uint8_t i = 0; i < sizeof(bauds) / sizeof(bauds[0]); i++)
+    {
+        double budget = ((double)options.cpu_hz * CBROKER_BENCH_BITS_PER_UART_BYTE) / bauds[i];
+
+        printf("  %7u baud: %8.0f cycles per byte time, broker load %6.2f%%\n", bauds[i], budget,
+               (100.0 * worst_cycles) / budget);
+    }
+    printf("max baud with the broker alone on the CPU: %llu (UARTDRV and interrupt entry are not included)\n",
+           (unsigned long long)max_baud);
+}
+
+static void cbroker_bench_usage(const char *name)
+{
+    fprintf(stderr,
+            "usage: %s [--json] [--cpu-mhz N] [--scale X]\n"
+            "  Times the command broker byte path on the host and estimates Cortex-M33 cycles per byte.\n"
+            "  --json prints machine readable results, --cpu-mhz sets the target core clock (default %lu),\n"
+            "  --scale sets M33 cycles per host ns instead of calibrating it.\n"
+            "  Exits with 1 when an estimate is above its regression threshold.\n",
+            name, (unsigned long)(BENCH_CLOCK_CPU_HZ_DEFAULT / 1000000UL));
+}
+
+static int cbroker_bench_parse_options(int argc, char **argv)
+{
+    static const struct option long_options[] = {
+        {"json", no_argument, NULL, 'j'},
+        {"cpu-mhz", required_argument, NULL, 'c'},
+        {"scale", required_argument, NULL, 's'},
+        {"help", no_argument, NULL, 'h'},
+        {NULL, 0, NULL, 0},
+    };
+    int opt;
+
+    while(-1 != (opt = getopt_long(argc, argv, "jc:s:h", long_options, NULL)))
+    {
+        switch(opt)
+        {
+            case 'j':
+                options.json = true;
+                break;
+            case 'c':
+                options.cpu_hz = (uint32_t)(strtod(optarg, NULL) * 1000000.0);
+                break;
+            case 's':
+                options.m33_per_ns = strtod(optarg, NULL);
+                break;
+            default:
+                cbroker_bench_usage(argv[0]);
+                return ('h' == opt) ? 0 : 1;
+        }
+    }
+
+    return -1;
+}
+
+int main(int argc, char **argv)
+{
+    cbroker_bench_result_t results[] = {
+        {.name = "cborker_calc_crc16arc", .unit = "rx byte", .max_m33_per_byte = CBROKER_BENCH_MAX_CRC16},
+        {.name = "cbroker_rx_asciihex_to_bin", .unit = "rx byte", .max_m33_per_byte = CBROKER_BENCH_MAX_ASCIIHEX},
+        {.name             = "cbroker_rx_fill_data_buffer",
+         .unit             = "payload nibble",
+         .max_m33_per_byte = CBROKER_BENCH_MAX_FILL_DATA},
+        {.name = "cbroker_rx_byte", .unit = "rx byte", .max_m33_per_byte = CBROKER_BENCH_MAX_RX_BYTE},
+        {.name = "cbroker_tx_fill_buff", .unit = "tx byte", .max_m33_per_byte = CBROKER_BENCH_MAX_TX_FILL_BUFF},
+        {.name = "cbroker_tx_cb", .unit = "tx byte", .max_m33_per_byte = CBROKER_BENCH_MAX_TX_CB},
+    };
+    const uint8_t count     = sizeof(results) / sizeof(results[0]);
+    uint8_t       worst_cmd = 0;
+    uint8_t       worst_pos = 0;
+    double        worst_rx  = 0;
+    bool          pass      = true;
+    int           exit_code = cbroker_bench_parse_options(argc, argv);
+
+    if(exit_code >= 0)
+    {
+        return exit_code;
+    }
+
+    if(0 == options.m33_per_ns)
+    {
+        options.m33_per_ns = bench_clock_m33_per_ns();
+    }
+    cbroker_bench_build_corpus();
+
+    cbroker_bench_crc16(&results[0]);
+    cbroker_bench_asciihex(&results[1]);
+    cbroker_bench_fill_data(&results[2]);
+    cbroker_bench_rx_byte(&results[3]);
+    cbroker_bench_tx_fill_buff(&results[4]);
+    cbroker_bench_tx_cb(&results[5]);
+    worst_rx = cbroker_bench_worst_rx_byte_ns(&worst_cmd, &worst_pos);
+
+    cbroker_bench_report(results, count, worst_rx, worst_cmd, worst_pos);
+
+    for(uint8_t i = 0; i < count; i++)
+    {
+        pass = pass && results[i].pass;
+    }
+    return pass ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,716 @@
+/** @file lcd_bench.c
+ *
+ * @brief Host microbenchmarks of the LCD renderer over every glyph, alignment, inversion and app.c layout.
+ *
+ * @author Rene Delgado
+ *
+ * @copyright 2023 The Chamberlain Group, LLC. All rights reserved. All
+ * information within this file and associated files, including all
+ * information and files transmitted with this file are CONFIDENTIAL
+ * and the proprietary property of The Chamberlain Group, LLC.
+ *
+ * In using the Licensed Software, Company shall not use with, combine, or
+ * incorporate any viral open source software with or into any of the Licensed
+ * Software in a manner that would require any portion of the Licensed software to
+ * be (i) disclosed or distributed in source code form; (ii) licensed for the
+ * purpose of making derivative works; or (iii) distributable or redistributable
+ * at no charge.
+ */
+
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "bench_clock.h"
+#include "host_irq.h"
+#include "host_spi.h"
+#include "lcd_spi.h"
+
+// The renderer is made of static functions and state: lcd.c is built into this translation unit as is.
+#include "source/hal/src/lcd.c"
+
+#define LCD_BENCH_REPS_DEFAULT (5U)   ///< Repetitions of every case, the fastest one is kept.
+#define LCD_BENCH_BATCH (64U)         ///< Calls per timed batch for the functions below a microsecond.
+#define LCD_BENCH_GLYPHS (255U)       ///< Character codes.
+#define LCD_BENCH_PANEL_ROWS (NUM_PIX_ROW_PER_COL_BYTES * 8U)
+#define LCD_BENCH_LABEL_MAX (96U)
+#define LCD_BENCH_BAUD (9600U)        ///< Powered UART baud rate.
+#define LCD_BENCH_BITS_PER_UART_BYTE (10U)
+#define LCD_BENCH_QR_FIRST (3U)       ///< lcd_put_qr_code() versions.
+#define LCD_BENCH_QR_LAST (7U)
+#if LCD_GRAY_ENABLE == true
+#define LCD_BENCH_GRAY_PERIOD_MAX (16U) ///< Slowest sub-frame cadence tried, in ms.
+#define LCD_BENCH_GRAY_RUN_MS (600U)    ///< Virtual time each cadence runs.
+#define LCD_BENCH_GRAY_LEVELS (4U)
+#endif /* LCD_GRAY_ENABLE */
+
+/**
+ * @brief Line layouts of app.c, the arrays there are static.
+ */
+typedef struct
+{
+    const char *name;
+    lcd_line_t  layout[LCD_LINE_NUM];
+} lcd_bench_layout_t;
+
+/**
+ * @brief Cost of one function over a sweep.
+ */
+typedef struct
+{
+    const char *name;                       ///< Function under test.
+    uint32_t    cases;                      ///< Timed cases.
+    double      sum_ns;                     ///< Sum of the case costs.
+    double      worst_ns;                   ///< Slowest case.
+    char        worst[LCD_BENCH_LABEL_MAX]; ///< Slowest case description.
+} lcd_bench_stats_t;
+
+#if LCD_GRAY_ENABLE == true
+/**
+ * @brief Grayscale flush at one sub-frame cadence.
+ */
+typedef struct
+{
+    uint32_t period_ms; ///< Sub-frame cadence.
+    uint32_t subframes; ///< Sub-frames scheduled.
+    uint32_t late;      ///< Sub-frames due before the previous one was on the panel.
+    double   bus_pct;   ///< Share of the run the SPI bus was clocking frames.
+} lcd_bench_gray_t;
+#endif /* LCD_GRAY_ENABLE */
+
+/**
+ * @brief Command line options.
+ */
+typedef struct
+{
+    bool     json;       ///< Machine readable output.
+    uint32_t cpu_hz;     ///< Target core clock.
+    double   m33_per_ns; ///< Host ns to M33 cycles scale, 0 to calibrate.
+    uint32_t reps;       ///< Repetitions per case.
+} lcd_bench_options_t;
+
+static const lcd_bench_layout_t layouts[] = {
+    {"lcd_layout",
+     {{0, LCD_LINE_PIXEL_HEIGHT}, {4, LCD_LINE_PIXEL_HEIGHT}, {1, LCD_LINE_PIXEL_HEIGHT}, {3, LCD_LINE_PIXEL_HEIGHT}}},
+    {"lcd_layout_full_height",
+     {{0, LCD_LINE_PIXEL_HEIGHT}, {0, LCD_LINE_PIXEL_HEIGHT}, {0, LCD_LINE_PIXEL_HEIGHT}, {0, LCD_LINE_PIXEL_HEIGHT}}},
+};
+
+static const struct
+{
+    const char *name;
+    uint8_t     state;
+} formats[] = {
+    {"default", 0},
+    {"left", LINE_ALIGNMENT_LEFT},
+    {"right", LINE_ALIGNMENT_RIGHT},
+    {"center", LINE_ALIGNMENT_CENTER},
+    {"default inverted", LINE_INVERTED},
+    {"left inverted", LINE_ALIGNMENT_LEFT | LINE_INVERTED},
+    {"right inverted", LINE_ALIGNMENT_RIGHT | LINE_INVERTED},
+    {"center inverted", LINE_ALIGNMENT_CENTER | LINE_INVERTED},
+};
+
+static lcd_bench_options_t options = {
+    .json = false, .cpu_hz = BENCH_CLOCK_CPU_HZ_DEFAULT, .m33_per_ns = 0, .reps = LCD_BENCH_REPS_DEFAULT};
+static uint64_t          clock_overhead = 0;
+static volatile uint32_t sink           = 0;
+static uint32_t          skipped_lines  = 0;
+static base_driver       spi_port;
+static lcd_t             lcd;
+
+static lcd_bench_stats_t put_line_stats   = {.name = "lcd_put_line"};
+static lcd_bench_stats_t update_stats     = {.name = "lcd_put_line update"};
+static lcd_bench_stats_t stuff_char_stats = {.name = "stuff_char"};
+static lcd_bench_stats_t blit_stats       = {.name = "blit_column"};
+static lcd_bench_stats_t distance_stats   = {.name = "pixel_distant_measure"};
+static lcd_bench_stats_t qr_stats         = {.name = "lcd_put_qr_code"};
+static lcd_bench_stats_t layout_stats[sizeof(layouts) / sizeof(layouts[0])];
+#if LCD_GRAY_ENABLE == true
+static lcd_bench_gray_t  gray_stats[LCD_BENCH_GRAY_PERIOD_MAX];
+static uint32_t          gray_sustained_ms = 0; ///< Fastest cadence without a late sub-frame, 0 for none.
+#endif /* LCD_GRAY_ENABLE */
+
+static void lcd_bench_add(lcd_bench_stats_t *stats, double ns, const char *label)
+{
+    stats->cases++;
+    stats->sum_ns += ns;
+    if(ns > stats->worst_ns)
+    {
+        stats->worst_ns = ns;
+        snprintf(stats->worst, sizeof(stats->worst), "%s", label);
+    }
+}
+
+static double lcd_bench_single_ns(uint64_t start)
+{
+    uint64_t elapsed = bench_clock_now_ns() - start;
+
+    return (elapsed > clock_overhead) ? (double)(elapsed - clock_overhead) : 0.0;
+}
+
+// The blink timer is a real periodic sleeptimer: the benchmark stops it before it can fire between two cases.
+static void lcd_bench_stop_blinking(void)
+{
+    task_worker(&lcd, false);
+    for(uint8_t line = 0; line < LCD_LINE_NUM; line++)
+    {
+        blink_task_remove(&lcd, line);
+    }
+}
+
+static bool lcd_bench_line_fits(const lcd_line_t *layout, uint8_t line)
+{
+    size_t shift = layout[line].upper_indent;
+
+    for(uint8_t cnt = 0; cnt < line; cnt++)
+    {
+        shift += layout[cnt].upper_indent + layout[cnt].height;
+    }
+    return (shift + layout[line].height) <= LCD_BENCH_PANEL_ROWS;
+}
+
+/*************************************************** LCD_PUT_LINE ****************************************************/
+
+/**
+ * @brief One lcd_put_line() case, the fastest of the repetitions. The cached copy of the line is cleared first so the
+ * line is always rendered, as when the main board sends a new text.
+ */
+static double lcd_bench_put_line(const uint8_t *str, uint8_t line)
+{
+    double best = 0;
+
+    for(uint32_t rep = 0; rep < options.reps; rep++)
+    {
+        memset(lcd.cached_str[line], 0x00, LCD_CHAR_NUM);
+        uint64_t start = bench_clock_now_ns();
+
+        lcd_put_line(&lcd, str, LCD_CHAR_NUM, line, ENGLISH);
+        double ns = lcd_bench_single_ns(start);
+
+        best = ((0U == rep) || (ns < best)) ? ns : best;
+        lcd_bench_stop_blinking();
+    }
+    return best;
+}
+
+static void lcd_bench_put_line_case(uint8_t layout, uint8_t line, uint8_t format, const uint8_t *str, const char *what)
+{
+    char   label[LCD_BENCH_LABEL_MAX];
+    double ns = lcd_bench_put_line(str, line);
+
+    snprintf(label, sizeof(label), "%s, line %u, %s, %s", layouts[layout].name, line, formats[format].name, what);
+    lcd_bench_add(&put_line_stats, ns, label);
+    lcd_bench_add(&layout_stats[layout], ns, label);
+}
+
+/**
+ * @brief Every glyph fills the text of a line, and every icon is also put on the alignment bytes, for every format,
+ * line and layout. Lines that end below the panel are skipped: their clipped rows would skew the figures.
+ */
+static void lcd_bench_sweep_put_line(void)
+{
+    for(uint8_t layout = 0; layout < sizeof(layouts) / sizeof(layouts[0]); layout++)
+    {
+        layout_stats[layout].name = layouts[layout].name;
+        lcd_init(&lcd, &spi_port, layouts[layout].layout);
+
+        for(uint8_t line = 0; line < LCD_LINE_NUM; line++)
+        {
+            if(!lcd_bench_line_fits(layouts[layout].layout, line))
+            {
+                skipped_lines++;
+                continue;
+            }
+
+            for(uint8_t format = 0; format < sizeof(formats) / sizeof(formats[0]); format++)
+            {
+                for(uint16_t glyph = 1; glyph < LCD_BENCH_GLYPHS; glyph++)
+                {
+                    uint8_t str[LCD_CHAR_NUM];
+                    char    what[32];
+
+                    if(NULL == font_glyph((uint8_t)glyph))
+                    {
+                        continue;
+                    }
+
+                    memset(str, glyph, sizeof(str));
+                    str[LEFT_ALIGNMENT_BYTE]  = ' ';
+                    str[FORMAT_BYTE_CHAR]     = formats[format].state;
+                    str[RIGHT_ALIGNMENT_BYTE] = ' ';
+                    snprintf(what, sizeof(what), "text of glyph 0x%02X", glyph);
+                    lcd_bench_put_line_case(layout, line, format, str, what);
+
+                    if(glyph > LAST_ASCII_CHAR_DEF)
+                    {
+                        memset(str, 'W', sizeof(str));
+                        str[LEFT_ALIGNMENT_BYTE]  = (uint8_t)glyph;
+                        str[FORMAT_BYTE_CHAR]     = formats[format].state;
+                        str[RIGHT_ALIGNMENT_BYTE] = (uint8_t)glyph;
+                        snprintf(what, sizeof(what), "icons 0x%02X", glyph);
+                        lcd_bench_put_line_case(layout, line, format, str, what);
+                    }
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief One lcd_put_line() update case, the fastest of the repetitions. The line is rendered from the first text
+ * before each repetition, so only the characters the second one changes are drawn.
+ */
+static double lcd_bench_update_line(const uint8_t *from, const uint8_t *to, uint8_t line)
+{
+    double best = 0;
+
+    for(uint32_t rep = 0; rep < options.reps; rep++)
+    {
+        memset(lcd.cached_str[line], 0x00, LCD_CHAR_NUM);
+        lcd_put_line(&lcd, from, LCD_CHAR_NUM, line, ENGLISH);
+        uint64_t start = bench_clock_now_ns();
+
+        lcd_put_line(&lcd, to, LCD_CHAR_NUM, line, ENGLISH);
+        double ns = lcd_bench_single_ns(start);
+
+        best = ((0U == rep) || (ns < best)) ? ns : best;
+        lcd_bench_stop_blinking();
+    }
+    return best;
+}
+
+/**
+ * @brief Texts the main board updates in place: a countdown digit and a status word, for every format, line and
+ * layout. lcd_put_line() compares the cached copy as a string, so formats with a zero byte would not be drawn at all.
+ */
+static void lcd_bench_sweep_update_line(void)
+{
+    static const struct
+    {
+        const char *name;
+        const char *from;
+        const char *to;
+    } updates[] = {
+        {"countdown digit", "COUNT   00:15   ", "COUNT   00:14   "},
+        {"status word", "DOOR   OPENING  ", "DOOR   CLOSING  "},
+    };
+
+    for(uint8_t layout = 0; layout < sizeof(layouts) / sizeof(layouts[0]); layout++)
+    {
+        lcd_init(&lcd, &spi_port, layouts[layout].layout);
+
+        for(uint8_t line = 0; line < LCD_LINE_NUM; line++)
+        {
+            if(!lcd_bench_line_fits(layouts[layout].layout, line))
+            {
+                continue;
+            }
+
+            for(uint8_t format = 0; format < sizeof(formats) / sizeof(formats[0]); format++)
+            {
+                if(0U == formats[format].state)
+                {
+                    continue;
+                }
+
+                for(uint8_t update = 0; update < sizeof(updates) / sizeof(updates[0]); update++)
+                {
+                    uint8_t from[LCD_CHAR_NUM];
+                    uint8_t to[LCD_CHAR_NUM];
+                    char    label[LCD_BENCH_LABEL_MAX];
+
+                    from[LEFT_ALIGNMENT_BYTE] = to[LEFT_ALIGNMENT_BYTE] = ' ';
+                    from[FORMAT_BYTE_CHAR] = to[FORMAT_BYTE_CHAR] = formats[format].state;
+                    from[RIGHT_ALIGNMENT_BYTE] = to[RIGHT_ALIGNMENT_BYTE] = ' ';
+                    memcpy(&from[PRINT_LINE_CHARS], updates[update].from, RIGHT_ALIGNMENT_BYTE - PRINT_LINE_CHARS);
+                    memcpy(&to[PRINT_LINE_CHARS], updates[update].to, RIGHT_ALIGNMENT_BYTE - PRINT_LINE_CHARS);
+
+                    double ns = lcd_bench_update_line(from, to, line);
+
+                    snprintf(label, sizeof(label), "%s, line %u, %s, %s", layouts[layout].name, line,
+                             formats[format].name, updates[update].name);
+                    lcd_bench_add(&update_stats, ns, label);
+                }
+            }
+        }
+    }
+}
+
+/************************************************* RENDER FUNCTIONS **************************************************/
+
+static void lcd_bench_sweep_stuff_char(void)
+{
+    lcd_init(&lcd, &spi_port, layouts[1].layout);
+    for(uint16_t glyph = 1; glyph < LCD_BENCH_GLYPHS; glyph++)
+    {
+        char_context_t context = {.my_char = (uint8_t)glyph, .line_size = LCD_LINE_PIXEL_HEIGHT};
+        double         best    = 0;
+        char           label[LCD_BENCH_LABEL_MAX];
+
+        if(NULL == font_glyph((uint8_t)glyph))
+        {
+            continue;
+        }
+        for(uint32_t rep = 0; rep < options.reps; rep++)
+        {
+            uint64_t start = bench_clock_now_ns();
+
+            for(uint32_t i = 0; i < LCD_BENCH_BATCH; i++)
+            {
+                sink = stuff_char(&lcd, &context, NUM_PIX_COL_PER_ROW_BYTES);
+            }
+            double ns = (double)(bench_clock_now_ns() - start) / LCD_BENCH_BATCH;
+
+            best = ((0U == rep) || (ns < best)) ? ns : best;
+        }
+        snprintf(label, sizeof(label), "glyph 0x%02X, %u columns", glyph, get_font((uint8_t)glyph)->size);
+        lcd_bench_add(&stuff_char_stats, best, label);
+    }
+}
+
+// Every start row of a 12 and of an 8 row span, over the 128 columns of the panel. The span is computed once per
+// line by the renderer, it is left out of the timing.
+static void lcd_bench_sweep_blit(void)
+{
+    static const uint8_t sizes[] = {LCD_LINE_PIXEL_HEIGHT, CHARACTER_HEIGHT};
+
+    for(uint8_t s = 0; s < sizeof(sizes); s++)
+    {
+        for(uint8_t start_bit = 0; (start_bit + sizes[s]) <= LCD_BENCH_PANEL_ROWS; start_bit++)
+        {
+            lcd_span_t span = span_of(start_bit, sizes[s]);
+            double     best = 0;
+            char       label[LCD_BENCH_LABEL_MAX];
+
+            for(uint32_t rep = 0; rep < options.reps; rep++)
+            {
+                uint64_t start = bench_clock_now_ns();
+
+                for(uint8_t pos = 0; pos < NUM_PIX_COL_PER_ROW_BYTES; pos++)
+                {
+                    blit_column(&lcd, &span, (uint16_t)(0x0A5AU ^ pos), pos);
+                }
+                double ns = (double)(bench_clock_now_ns() - start) / NUM_PIX_COL_PER_ROW_BYTES;
+
+                best = ((0U == rep) || (ns < best)) ? ns : best;
+            }
+            snprintf(label, sizeof(label), "start row %u, %u rows", start_bit, sizes[s]);
+            lcd_bench_add(&blit_stats, best, label);
+        }
+    }
+}
+
+static void lcd_bench_sweep_distance(void)
+{
+    for(uint16_t glyph = 1; glyph < LCD_BENCH_GLYPHS; glyph++)
+    {
+        uint8_t str[LCD_CHAR_NUM];
+        double  best = 0;
+        char    label[LCD_BENCH_LABEL_MAX];
+
+        if(NULL == font_glyph((uint8_t)glyph))
+        {
+            continue;
+        }
+        memset(str, glyph, sizeof(str));
+        for(uint32_t rep = 0; rep < options.reps; rep++)
+        {
+            uint64_t start = bench_clock_now_ns();
+
+            for(uint32_t i = 0; i < LCD_BENCH_BATCH; i++)
+            {
+                sink = pixel_distant_measure(str);
+            }
+            double ns = (double)(bench_clock_now_ns() - start) / LCD_BENCH_BATCH;
+
+            best = ((0U == rep) || (ns < best)) ? ns : best;
+        }
+        snprintf(label, sizeof(label), "text of glyph 0x%02X", glyph);
+        lcd_bench_add(&distance_stats, best, label);
+    }
+}
+
+static void lcd_bench_sweep_qr(void)
+{
+    for(uint8_t version = LCD_BENCH_QR_FIRST; version <= LCD_BENCH_QR_LAST; version++)
+    {
+        double best = 0;
+        char   label[LCD_BENCH_LABEL_MAX];
+
+        for(uint32_t rep = 0; rep < options.reps; rep++)
+        {
+            uint64_t start = bench_clock_now_ns();
+
+            for(uint32_t i = 0; i < LCD_BENCH_BATCH; i++)
+            {
+                lcd_put_qr_code(&lcd, version, 0, 0, 0, 0);
+            }
+            double ns = (double)(bench_clock_now_ns() - start) / LCD_BENCH_BATCH;
+
+            best = ((0U == rep) || (ns < best)) ? ns : best;
+        }
+        snprintf(label, sizeof(label), "version %u", version);
+        lcd_bench_add(&qr_stats, best, label);
+    }
+}
+
+#if LCD_GRAY_ENABLE == true
+/************************************************** GRAYSCALE FLUSH **************************************************/
+
+// Sends whatever is left to the panel, on the virtual clock.
+static void lcd_bench_gray_drain(void)
+{
+    while(lcd_flush_async(&lcd, NULL, NULL) || lcd.burst.flushing)
+    {
+        sl_sleeptimer_delay_millisecond(1);
+    }
+}
+
+/**
+ * @brief Worst case of the grayscale mode: every column holds the four levels, so every sub-frame sends the whole
+ * panel. Each cadence runs on the virtual clock with the emulated bus timing, the fastest one that never falls behind
+ * is the sustained sub-frame rate.
+ */
+static void lcd_bench_sweep_gray(void)
+{
+    for(uint8_t page = 0; page < NUM_PIX_ROW_PER_COL_BYTES; page++)
+    {
+        for(uint8_t col = 0; col < NUM_PIX_COL_PER_ROW_BYTES; col++)
+        {
+            // Two rows per level, shifted by one level per column.
+            uint8_t high = 0;
+            uint8_t low  = 0;
+
+            for(uint8_t bit = 0; bit < 8U; bit++)
+            {
+                uint8_t level = (uint8_t)(((bit / 2U) + col) % LCD_BENCH_GRAY_LEVELS);
+
+                high |= (uint8_t)(((level >> 1) & 1U) << bit);
+                low |= (uint8_t)((level & 1U) << bit);
+            }
+            lcd_put_gray_data(&lcd, high, low, page, col);
+        }
+    }
+    lcd_bench_gray_drain();
+
+    for(uint32_t period = 1; period <= LCD_BENCH_GRAY_PERIOD_MAX; period++)
+    {
+        lcd_bench_gray_t *stats = &gray_stats[period - 1U];
+        host_spi_stats_t  spi;
+
+        host_spi_reset_stats();
+        lcd_gray_start(&lcd, period);
+        sl_sleeptimer_delay_millisecond(LCD_BENCH_GRAY_RUN_MS);
+        spi = host_spi_get_stats();
+        stats->period_ms = period;
+        stats->subframes = lcd.gray_subframes;
+        stats->late      = lcd.gray_late;
+        stats->bus_pct   = (100.0 * (double)spi.wire_us) / (LCD_BENCH_GRAY_RUN_MS * 1000.0);
+        // The last sub-frame and the stop leave the wire before the next cadence starts.
+        lcd_gray_stop(&lcd);
+        lcd_bench_gray_drain();
+
+        if((0U == gray_sustained_ms) && (0U == stats->late))
+        {
+            gray_sustained_ms = period;
+        }
+    }
+}
+
+static void lcd_bench_report_gray(void)
+{
+    if(options.json)
+    {
+        printf(",\n  \"gray_full_screen\": [\n");
+        for(uint32_t i = 0; i < LCD_BENCH_GRAY_PERIOD_MAX; i++)
+        {
+            printf("    {\"subframe_ms\": %u, \"subframes\": %u, \"late\": %u, \"bus_pct\": %.1f}%s\n",
+                   gray_stats[i].period_ms, gray_stats[i].subframes, gray_stats[i].late, gray_stats[i].bus_pct,
+                   ((i + 1U) == LCD_BENCH_GRAY_PERIOD_MAX) ? "" : ",");
+        }
+        printf("  ],\n  \"gray_sustained_subframe_ms\": %u", gray_sustained_ms);
+        return;
+    }
+
+    printf("grayscale flush, full screen of the %u levels, %u ms per cadence on the emulated bus\n",
+           LCD_BENCH_GRAY_LEVELS, LCD_BENCH_GRAY_RUN_MS);
+    printf("  %-12s %10s %6s %6s\n", "sub-frame ms", "sub-frames", "late", "bus %");
+    for(uint32_t i = 0; i < LCD_BENCH_GRAY_PERIOD_MAX; i++)
+    {
+        printf("  %-12u %10u %6u %6.1f\n", gray_stats[i].period_ms, gray_stats[i].subframes, gray_stats[i].late,
+               gray_stats[i].bus_pct);
+    }
+    if(0U != gray_sustained_ms)
+    {
+        printf("sustained: a sub-frame every %u ms, %.1f Hz, %.1f Hz per gray period\n", gray_sustained_ms,
+               1000.0 / gray_sustained_ms, 1000.0 / (gray_sustained_ms * LCD_GRAY_SUBFRAMES));
+    }
+    else
+    {
+        printf("sustained: none of the cadences up to %u ms\n", LCD_BENCH_GRAY_PERIOD_MAX);
+    }
+}
+#endif /* LCD_GRAY_ENABLE */
+
+/****************************************************** REPORT *******************************************************/
+
+static void lcd_bench_print(const lcd_bench_stats_t *stats, bool last)
+{
+    const double scale = options.m33_per_ns;
+    double       mean  = (0U != stats->cases) ? (stats->sum_ns / stats->cases) : 0.0;
+
+    if(options.json)
+    {
+        printf("    {\"name\": \"%s\", \"cases\": %u, \"mean_ns\": %.2f, \"mean_m33_cycles\": %.0f, "
+               "\"worst_ns\": %.2f, \"worst_m33_cycles\": %.0f, \"worst_case\": \"%s\"}%s\n",
+               stats->name, stats->cases, mean, mean * scale, stats->worst_ns, stats->worst_ns * scale, stats->worst,
+               last ? "" : ",");
+        return;
+    }
+    printf("  %-28s %6u %10.0f %10.0f  %s\n", stats->name, stats->cases, mean * scale, stats->worst_ns * scale,
+           stats->worst);
+}
+
+static void lcd_bench_report(void)
+{
+    const lcd_bench_stats_t *functions[] = {&put_line_stats, &update_stats, &stuff_char_stats, &blit_stats,
+                                            &distance_stats, &qr_stats};
+    const uint8_t            count       = sizeof(functions) / sizeof(functions[0]);
+    const double             byte_cycles =
+        ((double)options.cpu_hz * LCD_BENCH_BITS_PER_UART_BYTE) / (double)LCD_BENCH_BAUD;
+    double worst_cycles = put_line_stats.worst_ns * options.m33_per_ns;
+
+    if(options.json)
+    {
+        printf("{\n  \"cpu_hz\": %lu,\n  \"m33_cycles_per_host_ns\": %.4f,\n  \"skipped_lines\": %u,\n"
+               "  \"functions\": [\n",
+               (unsigned long)options.cpu_hz, options.m33_per_ns, skipped_lines);
+        for(uint8_t i = 0; i < count; i++)
+        {
+            lcd_bench_print(functions[i], (i + 1U) == count);
+        }
+        printf("  ],\n  \"lcd_put_line_per_layout\": [\n");
+        for(uint8_t i = 0; i < sizeof(layouts) / sizeof(layouts[0]); i++)
+        {
+            lcd_bench_print(&layout_stats[i], (i + 1U) == (sizeof(layouts) / sizeof(layouts[0])));
+        }
+        printf("  ],\n  \"lcd_put_line_worst_uart_byte_times\": %.2f", worst_cycles / byte_cycles);
+#if LCD_GRAY_ENABLE == true
+        lcd_bench_report_gray();
+#endif /* LCD_GRAY_ENABLE */
+        printf("\n}\n");
+        return;
+    }
+
+    printf("lcd renderer, %.2f M33 cycles per host ns, M33 at %lu Hz, fastest of %u repetitions per case\n",
+           options.m33_per_ns, (unsigned long)options.cpu_hz, options.reps);
+    printf("  %-28s %6s %10s %10s  %s\n", "function", "cases", "mean cyc", "worst cyc", "worst case");
+    for(uint8_t i = 0; i < count; i++)
+    {
+        lcd_bench_print(functions[i], (i + 1U) == count);
+    }
+    printf("lcd_put_line per app.c layout\n");
+    for(uint8_t i = 0; i < sizeof(layouts) / sizeof(layouts[0]); i++)
+    {
+        lcd_bench_print(&layout_stats[i], (i + 1U) == (sizeof(layouts) / sizeof(layouts[0])));
+    }
+    if(0U != skipped_lines)
+    {
+        printf("%u layout lines end below row %u and were skipped: their rows below it are clipped\n",
+               skipped_lines, LCD_BENCH_PANEL_ROWS);
+    }
+    printf("worst lcd_put_line: %.0f cycles, %.1f us at %lu Hz, %.2f byte times at %u baud in the RX callback\n",
+           worst_cycles, (worst_cycles * 1000000.0) / options.cpu_hz, (unsigned long)options.cpu_hz,
+           worst_cycles / byte_cycles, LCD_BENCH_BAUD);
+#if LCD_GRAY_ENABLE == true
+    lcd_bench_report_gray();
+#endif /* LCD_GRAY_ENABLE */
+}
+
+static void lcd_bench_usage(const char *name)
+{
+    fprintf(stderr,
+            "usage: %s [--json] [--cpu-mhz N] [--scale X] [--reps N]\n"
+            "  Times the LCD renderer on the host over every glyph, alignment, inversion and app.c layout, and\n"
+            "  estimates Cortex-M33 cycles. --json prints machine readable results, --cpu-mhz sets the target core\n"
+            "  clock (default %lu), --scale sets M33 cycles per host ns instead of calibrating it, --reps sets the\n"
+            "  repetitions per case (default %u).\n",
+            name, (unsigned long)(BENCH_CLOCK_CPU_HZ_DEFAULT / 1000000UL), LCD_BENCH_REPS_DEFAULT);
+}
+
+static int lcd_bench_parse_options(int argc, char **argv)
+{
+    static const struct option long_options[] = {
+        {"json", no_argument, NULL, 'j'},
+        {"cpu-mhz", required_argument, NULL, 'c'},
+        {"scale", required_argument, NULL, 's'},
+        {"reps", required_argument, NULL, 'r'},
+        {"help", no_argument, NULL, 'h'},
+        {NULL, 0, NULL, 0},
+    };
+    int opt;
+
+    while(-1 != (opt = getopt_long(argc, argv, "jc:s:r:h", long_options, NULL)))
+    {
+        switch(opt)
+        {
+            case 'j':
+                options.json = true;
+                break;
+            case 'c':
+                options.cpu_hz = (uint32_t)(strtod(optarg, NULL) * 1000000.0);
+                break;
+            case 's':
+                options.m33_per_ns = strtod(optarg, NULL);
+                break;
+            case 'r':
+                options.reps = (uint32_t)strtoul(optarg, NULL, 0);
+                options.reps = (0U == options.reps) ? 1U : options.reps;
+                break;
+            default:
+                lcd_bench_usage(argv[0]);
+                return ('h' == opt) ? 0 : 1;
+        }
+    }
+
+    return -1;
+}
+
+int main(int argc, char **argv)
+{
+    int exit_code = lcd_bench_parse_options(argc, argv);
+
+    if(exit_code >= 0)
+    {
+        return exit_code;
+    }
+
+    if(0 == options.m33_per_ns)
+    {
+        options.m33_per_ns = bench_clock_m33_per_ns();
+    }
+    clock_overhead = bench_clock_overhead_ns();
+    // Frames sent by the panel init have no sink and are dropped; the bring-up runs on the virtual clock.
+    host_irq_init_virtual();
+    lcd_spi_init(&spi_port);
+    lcd_init(&lcd, &spi_port, NULL);
+    while(!lcd_is_ready(&lcd))
+    {
+        sl_sleeptimer_delay_millisecond(1);
+    }
+
+    lcd_bench_sweep_put_line();
+    lcd_bench_sweep_update_line();
+    lcd_bench_sweep_stuff_char();
+    lcd_bench_sweep_blit();
+    lcd_bench_sweep_distance();
+    lcd_bench_sweep_qr();
+#if LCD_GRAY_ENABLE == true
+    lcd_bench_sweep_gray();
+#endif /* LCD_GRAY_ENABLE */
+
+    lcd_bench_report();
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,50 @@
+/** @file em_cmu.h
+ *
+ * @brief Host stand-in for the Gecko SDK emlib CMU API (subset used by beeper.c).
+ *
+ * @author Rene Delgado
+ *
+ * @copyright 2023 The Chamberlain Group, LLC. All rights reserved. All
+ * information within this file and associated files, including all
+ * information and files transmitted with this file are CONFIDENTIAL
+ * and the proprietary property of The Chamberlain Group, LLC.
+ *
+ * In using the Licensed Software, Company shall not use with, combine, or
+ * incorporate any viral open source software with or into any of the Licensed
+ * Software in a manner that would require any portion of the Licensed software to
+ * be (i) disclosed or distributed in source code form; (ii) licensed for the
+ * purpose of making derivative works; or (iii) distributable or redistributable
+ * at no charge.
+ */
+
+#ifndef HOST_FAKES_INC_EM_CMU_H_
+#define HOST_FAKES_INC_EM_CMU_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "em_device.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define HOST_CMU_HFXO_FREQUENCY (38400000UL) ///< EM01GRPA clock feeding the TIMERs on the board.
+
+/**
+ * @brief  Clock branches.
+ */
+typedef enum
+{
+    cmuClock_TIMER2 = 0,
+} CMU_Clock_TypeDef;
+
+uint32_t CMU_ClockFreqGet(CMU_Clock_TypeDef clock);
+void     CMU_ClockEnable(CMU_Clock_TypeDef clock, bool enable);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HOST_FAKES_INC_EM_CMU_H_ */
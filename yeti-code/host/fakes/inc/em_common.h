@@ -0,0 +1,48 @@
+/** @file em_common.h
+ *
+ * @brief Host stand-in for the Gecko SDK em_common.h / em_assert.h.
+ *
+ * @author Rene Delgado
+ *
+ * @copyright 2023 The Chamberlain Group, LLC. All rights reserved. All
+ * information within this file and associated files, including all
+ * information and files transmitted with this file are CONFIDENTIAL
+ * and the proprietary property of The Chamberlain Group, LLC.
+ *
+ * In using the Licensed Software, Company shall not use with, combine, or
+ * incorporate any viral open source software with or into any of the Licensed
+ * Software in a manner that would require any portion of the Licensed software to
+ * be (i) disclosed or distributed in source code form; (ii) licensed for the
+ * purpose of making derivative works; or (iii) distributable or redistributable
+ * at no charge.
+ */
+
+#ifndef HOST_FAKES_INC_EM_COMMON_H_
+#define HOST_FAKES_INC_EM_COMMON_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define SL_WEAK __attribute__((weak))
+
+/**
+ * @brief  Called when an EFM_ASSERT() fails. Prints the location and aborts the host process.
+ *
+ * @param [in] file - Source file name.
+ * @param [in] line - Source line.
+ */
+void assertEFM(const char *file, int line);
+
+// Like the target build (DEBUG_EFM), the expression is always evaluated: lcd.c relies on it for the SPI writes.
+#define EFM_ASSERT(expr) ((expr) ? ((void)0) : assertEFM(__FILE__, __LINE__))
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HOST_FAKES_INC_EM_COMMON_H_ */
@@ -0,0 +1,43 @@
+/** @file em_core.h
+ *
+ * @brief Host stand-in for the Gecko SDK em_core.h atomic sections.
+ *
+ * @author Rene Delgado
+ *
+ * @copyright 2023 The Chamberlain Group, LLC. All rights reserved. All
+ * information within this file and associated files, including all
+ * information and files transmitted with this file are CONFIDENTIAL
+ * and the proprietary property of The Chamberlain Group, LLC.
+ *
+ * In using the Licensed Software, Company shall not use with, combine, or
+ * incorporate any viral open source software with or into any of the Licensed
+ * Software in a manner that would require any portion of the Licensed software to
+ * be (i) disclosed or distributed in source code form; (ii) licensed for the
+ * purpose of making derivative works; or (iii) distributable or redistributable
+ * at no charge.
+ */
+
+#ifndef HOST_FAKES_INC_EM_CORE_H_
+#define HOST_FAKES_INC_EM_CORE_H_
+
+#include <stdint.h>
+
+#include "host_irq.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+typedef uint32_t CORE_irqState_t;
+
+// The interrupt mask is the host_irq lock: it is nestable, the saved state is not needed to restore it.
+#define CORE_DECLARE_IRQ_STATE CORE_irqState_t irqState __attribute__((unused))
+#define CORE_ENTER_ATOMIC()    host_irq_disable()
+#define CORE_EXIT_ATOMIC()     host_irq_enable()
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HOST_FAKES_INC_EM_CORE_H_ */
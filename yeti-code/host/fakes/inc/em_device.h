@@ -0,0 +1,74 @@
+/** @file em_device.h
+ *
+ * @brief Host stand-in for the EFM32PG22 device header (TIMER registers and NVIC).
+ *
+ * @author Rene Delgado
+ *
+ * @copyright 2023 The Chamberlain Group, LLC. All rights reserved. All
+ * information within this file and associated files, including all
+ * information and files transmitted with this file are CONFIDENTIAL
+ * and the proprietary property of The Chamberlain Group, LLC.
+ *
+ * In using the Licensed Software, Company shall not use with, combine, or
+ * incorporate any viral open source software with or into any of the Licensed
+ * Software in a manner that would require any portion of the Licensed software to
+ * be (i) disclosed or distributed in source code form; (ii) licensed for the
+ * purpose of making derivative works; or (iii) distributable or redistributable
+ * at no charge.
+ */
+
+#ifndef HOST_FAKES_INC_EM_DEVICE_H_
+#define HOST_FAKES_INC_EM_DEVICE_H_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define TIMER_IEN_OF (0x1UL << 0) ///< Overflow Interrupt Enable.
+#define TIMER_IF_OF (0x1UL << 0)  ///< Overflow Interrupt Flag.
+
+/**
+ * @brief  Interrupt numbers used by the application.
+ */
+typedef enum
+{
+    TIMER2_IRQn = 11,
+} IRQn_Type;
+
+/**
+ * @brief  RAM backed TIMER register block. Only the registers touched by the HAL exist.
+ */
+typedef struct
+{
+    volatile uint32_t EN;      ///< Module enable.
+    volatile uint32_t CMD;     ///< Start/stop command, bit 0 = running.
+    volatile uint32_t TOP;     ///< Counter top value.
+    volatile uint32_t CC0;     ///< Compare value of channel 0.
+    volatile uint32_t IF;      ///< Interrupt flags.
+    volatile uint32_t IEN;     ///< Interrupt enable.
+    volatile uint32_t IEN_SET; ///< Writes are OR'ed into IEN by the fake TIMER (see em_timer.c).
+    uint32_t          prescale;
+} TIMER_TypeDef;
+
+extern TIMER_TypeDef host_timer2;
+
+#define TIMER2 (&host_timer2)
+
+/**
+ * @brief  TIMER2 ISR, implemented by beeper.c.
+ */
+void TIMER2_IRQHandler(void);
+
+/**
+ * @brief  Enable an interrupt line. Interrupts are always routed on the host, kept for API compatibility.
+ */
+void NVIC_EnableIRQ(IRQn_Type irq);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HOST_FAKES_INC_EM_DEVICE_H_ */
@@ -0,0 +1,102 @@
+/** @file em_timer.h
+ *
+ * @brief Host stand-in for the Gecko SDK emlib TIMER API (subset used by beeper.c).
+ *
+ * @author Rene Delgado
+ *
+ * @copyright 2023 The Chamberlain Group, LLC. All rights reserved. All
+ * information within this file and associated files, including all
+ * information and files transmitted with this file are CONFIDENTIAL
+ * and the proprietary property of The Chamberlain Group, LLC.
+ *
+ * In using the Licensed Software, Company shall not use with, combine, or
+ * incorporate any viral open source software with or into any of the Licensed
+ * Software in a manner that would require any portion of the Licensed software to
+ * be (i) disclosed or distributed in source code form; (ii) licensed for the
+ * purpose of making derivative works; or (iii) distributable or redistributable
+ * at no charge.
+ */
+
+#ifndef HOST_FAKES_INC_EM_TIMER_H_
+#define HOST_FAKES_INC_EM_TIMER_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "em_device.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @brief  Clock prescaler.
+ */
+typedef enum
+{
+    timerPrescale1 = 0,
+    timerPrescale2,
+    timerPrescale4,
+    timerPrescale8,
+    timerPrescale16,
+    timerPrescale32,
+    timerPrescale64,
+    timerPrescale128,
+    timerPrescale256,
+    timerPrescale512,
+    timerPrescale1024,
+} TIMER_Prescale_TypeDef;
+
+/**
+ * @brief  Compare/capture mode.
+ */
+typedef enum
+{
+    timerCCModeOff = 0,
+    timerCCModeCapture,
+    timerCCModeCompare,
+    timerCCModePWM,
+} TIMER_CCMode_TypeDef;
+
+/**
+ * @brief  TIMER initialization structure (subset).
+ */
+typedef struct
+{
+    bool                   enable;   ///< Start counting when initialization completes.
+    bool                   debugRun; ///< Counter runs during debug halt.
+    TIMER_Prescale_TypeDef prescale; ///< Prescaling factor.
+    bool                   oneShot;  ///< One shot mode.
+} TIMER_Init_TypeDef;
+
+/**
+ * @brief  TIMER compare/capture initialization structure (subset).
+ */
+typedef struct
+{
+    TIMER_CCMode_TypeDef mode; ///< Compare/capture channel mode.
+} TIMER_InitCC_TypeDef;
+
+#define TIMER_INIT_DEFAULT                                                                                             \
+    {                                                                                                                  \
+        .enable = true, .debugRun = false, .prescale = timerPrescale1, .oneShot = false                                \
+    }
+
+#define TIMER_INITCC_DEFAULT                                                                                           \
+    {                                                                                                                  \
+        .mode = timerCCModeOff                                                                                         \
+    }
+
+void TIMER_Init(TIMER_TypeDef *timer, const TIMER_Init_TypeDef *init);
+void TIMER_InitCC(TIMER_TypeDef *timer, unsigned int ch, const TIMER_InitCC_TypeDef *init);
+void TIMER_TopSet(TIMER_TypeDef *timer, uint32_t val);
+void TIMER_CompareSet(TIMER_TypeDef *timer, unsigned int ch, uint32_t val);
+void TIMER_IntClear(TIMER_TypeDef *timer, uint32_t flags);
+void TIMER_Enable(TIMER_TypeDef *timer, bool enable);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HOST_FAKES_INC_EM_TIMER_H_ */
@@ -0,0 +1,77 @@
+/** @file host_board.h
+ *
+ * @brief Host view of the board pins: LEDs, LCD control lines, buzzer, watchdog and the push buttons.
+ *
+ * @author Rene Delgado
+ *
+ * @copyright 2023 The Chamberlain Group, LLC. All rights reserved. All
+ * information within this file and associated files, including all
+ * information and files transmitted with this file are CONFIDENTIAL
+ * and the proprietary property of The Chamberlain Group, LLC.
+ *
+ * In using the Licensed Software, Company shall not use with, combine, or
+ * incorporate any viral open source software with or into any of the Licensed
+ * Software in a manner that would require any portion of the Licensed software to
+ * be (i) disclosed or distributed in source code form; (ii) licensed for the
+ * purpose of making derivative works; or (iii) distributable or redistributable
+ * at no charge.
+ */
+
+#ifndef HOST_FAKES_INC_HOST_BOARD_H_
+#define HOST_FAKES_INC_HOST_BOARD_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @brief  Push buttons and the loopback pin.
+ */
+typedef enum
+{
+    HOST_BUTTON_OPEN = 0,
+    HOST_BUTTON_CLOSE,
+    HOST_BUTTON_STOP,
+    HOST_BUTTON_LOOPBACK,
+    HOST_BUTTON_NUM,
+} host_button_e;
+
+/**
+ * @brief  Output pins and peripherals state, as last driven by the firmware.
+ */
+typedef struct
+{
+    bool     led_d10;          ///< D10 LED on.
+    bool     lcd_backlight;    ///< LCD backlight on.
+    bool     lcd_reset;        ///< LCD reset line asserted.
+    bool     buzzer_on;        ///< Buzzer PWM running.
+    uint32_t buzzer_freq;      ///< Buzzer PWM frequency in Hz.
+    uint8_t  buzzer_duty;      ///< Buzzer PWM duty cycle in percent.
+    uint32_t buzzer_starts;    ///< Number of times the buzzer PWM was started.
+    bool     watchdog_enabled; ///< Watchdog running.
+    uint32_t watchdog_feeds;   ///< Number of watchdog feeds.
+} host_board_t;
+
+/**
+ * @brief  Board state, updated by the driver wrapper fakes. Read it with interrupts masked for a coherent copy.
+ */
+extern host_board_t host_board;
+
+/**
+ * @brief  Press or release a button. The change is seen by the firmware from the interrupt context, like a GPIO
+ * interrupt.
+ *
+ * @param [in] button - Button to change.
+ * @param [in] pressed - New state.
+ */
+void host_button_set(host_button_e button, bool pressed);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HOST_FAKES_INC_HOST_BOARD_H_ */
@@ -0,0 +1,118 @@
+/** @file host_irq.h
+ *
+ * @brief Host emulation of the interrupt context (ISRs, DMA/UART completions, timers).
+ *
+ * @author Rene Delgado
+ *
+ * @copyright 2023 The Chamberlain Group, LLC. All rights reserved. All
+ * information within this file and associated files, including all
+ * information and files transmitted with this file are CONFIDENTIAL
+ * and the proprietary property of The Chamberlain Group, LLC.
+ *
+ * In using the Licensed Software, Company shall not use with, combine, or
+ * incorporate any viral open source software with or into any of the Licensed
+ * Software in a manner that would require any portion of the Licensed software to
+ * be (i) disclosed or distributed in source code form; (ii) licensed for the
+ * purpose of making derivative works; or (iii) distributable or redistributable
+ * at no charge.
+ */
+
+#ifndef HOST_FAKES_INC_HOST_IRQ_H_
+#define HOST_FAKES_INC_HOST_IRQ_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @brief  Handler executed in the emulated interrupt context.
+ *
+ * @param [in] arg - User argument given when the event was scheduled.
+ */
+typedef void (*host_irq_handler_t)(void *arg);
+
+/**
+ * @brief  Pending interrupt event. Owned by the caller (usually embedded in the fake peripheral), never copied.
+ */
+typedef struct host_irq_event
+{
+    uint64_t               due_us;  ///< Absolute time the event fires at.
+    host_irq_handler_t     handler; ///< Handler to run in interrupt context.
+    void                  *arg;     ///< Handler argument.
+    bool                   queued;  ///< True while the event is waiting to fire.
+    struct host_irq_event *next;    ///< Next event in due time order.
+} host_irq_event_t;
+
+/**
+ * @brief  Start the interrupt context thread. Must be called once before any fake peripheral is used.
+ */
+void host_irq_init(void);
+
+/**
+ * @brief  Run on a virtual clock instead of the interrupt thread. Must be called before host_irq_init().
+ *
+ * Time only moves through host_irq_advance(), and events fire on the thread that advances it: the simulation is
+ * single threaded and deterministic, and runs as fast as the host allows.
+ */
+void host_irq_init_virtual(void);
+
+/**
+ * @brief  True when host_irq_init_virtual() selected the virtual clock.
+ */
+bool host_irq_is_virtual(void);
+
+/**
+ * @brief  Time elapsed since host_irq_init(), in microseconds.
+ */
+uint64_t host_irq_now_us(void);
+
+/**
+ * @brief  Let delay_us pass.
+ *
+ * On the virtual clock every event due in the meantime fires on the calling thread, with the clock set to its due
+ * time. On the wall clock the calling thread sleeps while the interrupt thread does the work.
+ *
+ * @param [in] delay_us - Time to let pass.
+ */
+void host_irq_advance(uint64_t delay_us);
+
+/**
+ * @brief  Queue (or re-queue) an event to fire after delay_us.
+ *
+ * Events fire one at a time on the interrupt thread, like ISRs of equal priority on the target: a handler is never
+ * preempted by another handler, but it does run concurrently with the main loop. On the virtual clock they fire from
+ * host_irq_advance() instead.
+ *
+ * @param [in] event - Event storage, owned by the caller.
+ * @param [in] delay_us - Delay from now.
+ * @param [in] handler - Handler to run.
+ * @param [in] arg - Handler argument.
+ */
+void host_irq_schedule(host_irq_event_t *event, uint64_t delay_us, host_irq_handler_t handler, void *arg);
+
+/**
+ * @brief  Remove an event from the queue if it has not fired yet.
+ *
+ * @param [in] event - Event to cancel.
+ */
+void host_irq_cancel(host_irq_event_t *event);
+
+/**
+ * @brief  Block interrupt dispatch (CORE_ENTER_ATOMIC equivalent). Nestable from the same thread.
+ */
+void host_irq_disable(void);
+
+/**
+ * @brief  Re-enable interrupt dispatch (CORE_EXIT_ATOMIC equivalent).
+ */
+void host_irq_enable(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HOST_FAKES_INC_HOST_IRQ_H_ */
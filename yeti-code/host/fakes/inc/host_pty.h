@@ -0,0 +1,47 @@
+/** @file host_pty.h
+ *
+ * @brief Pseudo-terminals bridging the host UARTs to serial port tooling (pyserial, main board test rigs).
+ *
+ * @author Rene Delgado
+ *
+ * @copyright 2023 The Chamberlain Group, LLC. All rights reserved. All
+ * information within this file and associated files, including all
+ * information and files transmitted with this file are CONFIDENTIAL
+ * and the proprietary property of The Chamberlain Group, LLC.
+ *
+ * In using the Licensed Software, Company shall not use with, combine, or
+ * incorporate any viral open source software with or into any of the Licensed
+ * Software in a manner that would require any portion of the Licensed software to
+ * be (i) disclosed or distributed in source code form; (ii) licensed for the
+ * purpose of making derivative works; or (iii) distributable or redistributable
+ * at no charge.
+ */
+
+#ifndef HOST_FAKES_INC_HOST_PTY_H_
+#define HOST_FAKES_INC_HOST_PTY_H_
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @brief  Open a raw pseudo-terminal.
+ *
+ * The master side is non blocking: give it to host_uart_configure() as both descriptors. Input waits while no client
+ * has the terminal open, and output is dropped once the terminal buffer is full, like a UART with nothing connected.
+ *
+ * @param [in] link - Symbolic link to create to the terminal (replaced if it exists, removed on exit), NULL for none.
+ * @param [out] name - Path of the terminal side the tools open, /dev/pts/N.
+ * @param [in] size - Size of name.
+ * @return Master side descriptor, -1 on error (errno is set).
+ */
+int host_pty_open(const char *link, char *name, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HOST_FAKES_INC_HOST_PTY_H_ */
@@ -0,0 +1,82 @@
+/** @file host_spi.h
+ *
+ * @brief Host model of the LCD SPI bus: 9-bit frames are handed to a sink and timed at the configured bitrate.
+ *
+ * @author Rene Delgado
+ *
+ * @copyright 2023 The Chamberlain Group, LLC. All rights reserved. All
+ * information within this file and associated files, including all
+ * information and files transmitted with this file are CONFIDENTIAL
+ * and the proprietary property of The Chamberlain Group, LLC.
+ *
+ * In using the Licensed Software, Company shall not use with, combine, or
+ * incorporate any viral open source software with or into any of the Licensed
+ * Software in a manner that would require any portion of the Licensed software to
+ * be (i) disclosed or distributed in source code form; (ii) licensed for the
+ * purpose of making derivative works; or (iii) distributable or redistributable
+ * at no charge.
+ */
+
+#ifndef HOST_FAKES_INC_HOST_SPI_H_
+#define HOST_FAKES_INC_HOST_SPI_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define HOST_SPI_BITRATE (1000000ULL) ///< SL_SPIDRV_LCD_SPI_BITRATE.
+#define HOST_SPI_FRAME_BITS (9U)      ///< SL_SPIDRV_LCD_SPI_FRAME_LENGTH, bit 8 is the UC1601s CD line.
+
+/**
+ * @brief  Receives every frame written to the bus, in order.
+ *
+ * @param [in] arg - Argument given to host_spi_set_sink().
+ * @param [in] frames - Frames of the transfer (bit 8 set for display data, clear for commands).
+ * @param [in] count - Number of frames.
+ */
+typedef void (*host_spi_sink_t)(void *arg, const uint16_t *frames, size_t count);
+
+/**
+ * @brief  Bus counters.
+ */
+typedef struct
+{
+    uint32_t transfers;    ///< Transfers clocked out.
+    uint32_t frames;       ///< Frames clocked out.
+    uint32_t busy_refused; ///< Transfers refused while the previous one was on the wire, as SPIDRV does.
+    uint64_t wire_us;      ///< Time the bus spent clocking frames.
+} host_spi_stats_t;
+
+/**
+ * @brief  Install the frame sink, NULL to discard frames.
+ *
+ * @param [in] sink - Frame sink.
+ * @param [in] arg - Sink argument.
+ */
+void host_spi_set_sink(host_spi_sink_t sink, void *arg);
+
+/**
+ * @brief  Copy of the bus counters.
+ */
+host_spi_stats_t host_spi_get_stats(void);
+
+/**
+ * @brief  Clear the bus counters.
+ */
+void host_spi_reset_stats(void);
+
+/**
+ * @brief  Time the last queued frame leaves the wire, on the host_irq_now_us() clock. Inside the sink, the end of
+ * the transfer being delivered.
+ */
+uint64_t host_spi_wire_free_us(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HOST_FAKES_INC_HOST_SPI_H_ */
@@ -0,0 +1,132 @@
+/** @file host_uart.h
+ *
+ * @brief Host UART model backing the powered and debug UART fakes: file descriptors paced at the configured baud rate.
+ *
+ * @author Rene Delgado
+ *
+ * @copyright 2023 The Chamberlain Group, LLC. All rights reserved. All
+ * information within this file and associated files, including all
+ * information and files transmitted with this file are CONFIDENTIAL
+ * and the proprietary property of The Chamberlain Group, LLC.
+ *
+ * In using the Licensed Software, Company shall not use with, combine, or
+ * incorporate any viral open source software with or into any of the Licensed
+ * Software in a manner that would require any portion of the Licensed software to
+ * be (i) disclosed or distributed in source code form; (ii) licensed for the
+ * purpose of making derivative works; or (iii) distributable or redistributable
+ * at no charge.
+ */
+
+#ifndef HOST_FAKES_INC_HOST_UART_H_
+#define HOST_FAKES_INC_HOST_UART_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "base_sercomm_driver.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define HOST_UART_BAUD_DEFAULT (9600UL) ///< Powered UART baud rate on the board.
+
+/**
+ * @brief  UART instances of the board.
+ */
+typedef enum
+{
+    HOST_UART_POWERED = 0, ///< Command broker link.
+    HOST_UART_DEBUG,       ///< Debug log.
+    HOST_UART_NUM,
+} host_uart_id_e;
+
+/**
+ * @brief  Transfer counters of one instance.
+ */
+typedef struct
+{
+    uint32_t rx_bytes;      ///< Bytes handed to the firmware.
+    uint32_t rx_overruns;   ///< Bytes dropped because the firmware did not read in time.
+    uint32_t tx_bytes;      ///< Bytes written out.
+    uint32_t tx_queue_full; ///< Transmit requests refused because the queue was full.
+} host_uart_stats_t;
+
+/**
+ * @brief  Observes the bytes crossing the wire, called from the interrupt context.
+ *
+ * @param [in] arg - Argument given to host_uart_set_monitor().
+ * @param [in] is_rx - True for a byte handed to the firmware, false for a byte the firmware transmitted.
+ * @param [in] byte - Byte value.
+ */
+typedef void (*host_uart_monitor_t)(void *arg, bool is_rx, uint8_t byte);
+
+/**
+ * @brief  Bind an instance to file descriptors. Must be called before the firmware opens the UART.
+ *
+ * @param [in] id - UART instance.
+ * @param [in] in_fd - Descriptor bytes are received from, -1 for none.
+ * @param [in] out_fd - Descriptor transmitted bytes are written to, -1 to discard them.
+ * @param [in] baud - Baud rate used to pace both directions (8N1), 0 for no pacing.
+ */
+void host_uart_configure(host_uart_id_e id, int in_fd, int out_fd, uint32_t baud);
+
+/**
+ * @brief  Handle to give to the base_sercomm_driver, see powered_uart.c and debug_uart.c.
+ *
+ * @param [in] id - UART instance.
+ */
+void *host_uart_handle(host_uart_id_e id);
+
+/**
+ * @brief  Queue a non blocking transmission. The buffer must stay valid until the callback, like with UARTDRV.
+ *
+ * @param [in] handle - Instance handle.
+ * @param [in] buff - Data to send.
+ * @param [in] size - Number of bytes.
+ * @param [in] callback - Called from the interrupt context once the bytes are on the wire, may be NULL.
+ * @return Zero for no error, otherwise error number.
+ */
+uint8_t host_uart_transmit(void *handle, const uint8_t *buff, size_t size, callback_transmit_t callback);
+
+/**
+ * @brief  Start a non blocking reception. Only one reception may be pending, like with UARTDRV queue size 1.
+ *
+ * @param [in] handle - Instance handle.
+ * @param [in] buff - Buffer to fill.
+ * @param [in] size - Number of bytes.
+ * @param [in] callback - Called from the interrupt context once the buffer is full.
+ * @return Zero for no error, otherwise error number.
+ */
+uint8_t host_uart_receive(void *handle, uint8_t *buff, size_t size, callback_receive_t callback);
+
+/**
+ * @brief  Install a monitor, NULL to remove it.
+ *
+ * @param [in] id - UART instance.
+ * @param [in] monitor - Called for every received and transmitted byte.
+ * @param [in] arg - Monitor argument.
+ */
+void host_uart_set_monitor(host_uart_id_e id, host_uart_monitor_t monitor, void *arg);
+
+/**
+ * @brief  True once the input reached end of file and every received and queued byte has been processed.
+ *
+ * @param [in] id - UART instance.
+ */
+bool host_uart_is_drained(host_uart_id_e id);
+
+/**
+ * @brief  Copy of the transfer counters.
+ *
+ * @param [in] id - UART instance.
+ */
+host_uart_stats_t host_uart_get_stats(host_uart_id_e id);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HOST_FAKES_INC_HOST_UART_H_ */
@@ -0,0 +1,183 @@
+/** @file sl_sleeptimer.h
+ *
+ * @brief Host stand-in for the Gecko SDK sleeptimer service (subset used by the application).
+ *
+ * @author Rene Delgado
+ *
+ * @copyright 2023 The Chamberlain Group, LLC. All rights reserved. All
+ * information within this file and associated files, including all
+ * information and files transmitted with this file are CONFIDENTIAL
+ * and the proprietary property of The Chamberlain Group, LLC.
+ *
+ * In using the Licensed Software, Company shall not use with, combine, or
+ * incorporate any viral open source software with or into any of the Licensed
+ * Software in a manner that would require any portion of the Licensed software to
+ * be (i) disclosed or distributed in source code form; (ii) licensed for the
+ * purpose of making derivative works; or (iii) distributable or redistributable
+ * at no charge.
+ */
+
+#ifndef HOST_FAKES_INC_SL_SLEEPTIMER_H_
+#define HOST_FAKES_INC_SL_SLEEPTIMER_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "host_irq.h"
+#include "sl_status.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define HOST_SLEEPTIMER_FREQUENCY (32768UL) ///< LFXO backed sleeptimer frequency on the board.
+
+typedef struct sl_sleeptimer_timer_handle sl_sleeptimer_timer_handle_t;
+
+/**
+ * @brief  Typedef for the user supplied callback function which is called when a timer expires.
+ *
+ * @param [in] handle - The timer handle.
+ * @param [in] data - An extra parameter for the user application.
+ */
+typedef void (*sl_sleeptimer_timer_callback_t)(sl_sleeptimer_timer_handle_t *handle, void *data);
+
+/**
+ * @brief  Timer structure. The SDK fields are kept as is, the expiry itself is an event of the emulated interrupt
+ * context.
+ */
+struct sl_sleeptimer_timer_handle
+{
+    void                          *callback_data;       ///< User data to pass to callback function.
+    uint8_t                        priority;            ///< Priority of timer.
+    uint16_t                       option_flags;        ///< Option flags.
+    sl_sleeptimer_timer_handle_t  *next;                ///< Pointer to next element in list.
+    sl_sleeptimer_timer_callback_t callback;            ///< Function to call when timer expires.
+    uint32_t                       timeout_periodic;    ///< Periodic timeout.
+    uint32_t                       delta;               ///< Delay relative to previous element in list.
+    uint32_t                       timeout_expected_tc; ///< Expected tick count of the next timeout.
+    host_irq_event_t               event;               ///< Host only: pending expiry.
+};
+
+sl_status_t sl_sleeptimer_init(void);
+
+sl_status_t sl_sleeptimer_start_timer(sl_sleeptimer_timer_handle_t  *handle,
+                                      uint32_t                       timeout,
+                                      sl_sleeptimer_timer_callback_t callback,
+                                      void                          *callback_data,
+                                      uint8_t                        priority,
+                                      uint16_t                       option_flags);
+
+sl_status_t sl_sleeptimer_restart_timer(sl_sleeptimer_timer_handle_t  *handle,
+                                        uint32_t                       timeout,
+                                        sl_sleeptimer_timer_callback_t callback,
+                                        void                          *callback_data,
+                                        uint8_t                        priority,
+                                        uint16_t                       option_flags);
+
+sl_status_t sl_sleeptimer_start_periodic_timer(sl_sleeptimer_timer_handle_t  *handle,
+                                               uint32_t                       timeout,
+                                               sl_sleeptimer_timer_callback_t callback,
+                                               void                          *callback_data,
+                                               uint8_t                        priority,
+                                               uint16_t                       option_flags);
+
+sl_status_t sl_sleeptimer_restart_periodic_timer(sl_sleeptimer_timer_handle_t  *handle,
+                                                 uint32_t                       timeout,
+                                                 sl_sleeptimer_timer_callback_t callback,
+                                                 void                          *callback_data,
+                                                 uint8_t                        priority,
+                                                 uint16_t                       option_flags);
+
+sl_status_t sl_sleeptimer_stop_timer(sl_sleeptimer_timer_handle_t *handle);
+
+sl_status_t sl_sleeptimer_is_timer_running(sl_sleeptimer_timer_handle_t *handle, bool *running);
+
+uint32_t sl_sleeptimer_get_tick_count(void);
+
+uint64_t sl_sleeptimer_get_tick_count64(void);
+
+uint32_t sl_sleeptimer_get_timer_frequency(void);
+
+void sl_sleeptimer_delay_millisecond(uint16_t time_ms);
+
+uint32_t sl_sleeptimer_ms_to_tick(uint16_t time_ms);
+
+sl_status_t sl_sleeptimer_ms32_to_tick(uint32_t time_ms, uint32_t *tick);
+
+uint32_t sl_sleeptimer_tick_to_ms(uint32_t tick);
+
+static inline sl_status_t sl_sleeptimer_start_timer_ms(sl_sleeptimer_timer_handle_t  *handle,
+                                                       uint32_t                       timeout_ms,
+                                                       sl_sleeptimer_timer_callback_t callback,
+                                                       void                          *callback_data,
+                                                       uint8_t                        priority,
+                                                       uint16_t                       option_flags)
+{
+    uint32_t    timeout_tick;
+    sl_status_t status = sl_sleeptimer_ms32_to_tick(timeout_ms, &timeout_tick);
+
+    if(SL_STATUS_OK != status)
+    {
+        return status;
+    }
+    return sl_sleeptimer_start_timer(handle, timeout_tick, callback, callback_data, priority, option_flags);
+}
+
+static inline sl_status_t sl_sleeptimer_restart_timer_ms(sl_sleeptimer_timer_handle_t  *handle,
+                                                         uint32_t                       timeout_ms,
+                                                         sl_sleeptimer_timer_callback_t callback,
+                                                         void                          *callback_data,
+                                                         uint8_t                        priority,
+                                                         uint16_t                       option_flags)
+{
+    uint32_t    timeout_tick;
+    sl_status_t status = sl_sleeptimer_ms32_to_tick(timeout_ms, &timeout_tick);
+
+    if(SL_STATUS_OK != status)
+    {
+        return status;
+    }
+    return sl_sleeptimer_restart_timer(handle, timeout_tick, callback, callback_data, priority, option_flags);
+}
+
+static inline sl_status_t sl_sleeptimer_start_periodic_timer_ms(sl_sleeptimer_timer_handle_t  *handle,
+                                                                uint32_t                       timeout_ms,
+                                                                sl_sleeptimer_timer_callback_t callback,
+                                                                void                          *callback_data,
+                                                                uint8_t                        priority,
+                                                                uint16_t                       option_flags)
+{
+    uint32_t    timeout_tick;
+    sl_status_t status = sl_sleeptimer_ms32_to_tick(timeout_ms, &timeout_tick);
+
+    if(SL_STATUS_OK != status)
+    {
+        return status;
+    }
+    return sl_sleeptimer_start_periodic_timer(handle, timeout_tick, callback, callback_data, priority, option_flags);
+}
+
+static inline sl_status_t sl_sleeptimer_restart_periodic_timer_ms(sl_sleeptimer_timer_handle_t  *handle,
+                                                                  uint32_t                       timeout_ms,
+                                                                  sl_sleeptimer_timer_callback_t callback,
+                                                                  void                          *callback_data,
+                                                                  uint8_t                        priority,
+                                                                  uint16_t                       option_flags)
+{
+    uint32_t    timeout_tick;
+    sl_status_t status = sl_sleeptimer_ms32_to_tick(timeout_ms, &timeout_tick);
+
+    if(SL_STATUS_OK != status)
+    {
+        return status;
+    }
+    return sl_sleeptimer_restart_periodic_timer(handle, timeout_tick, callback, callback_data, priority, option_flags);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HOST_FAKES_INC_SL_SLEEPTIMER_H_ */
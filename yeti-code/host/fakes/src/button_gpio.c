@@ -0,0 +1,185 @@
+/** @file button_gpio.c
+ *
+ * @brief Host push buttons driver wrapper: host_button_set() plays the role of the GPIO interrupt.
+ *
+ * @author Rene Delgado
+ *
+ * @copyright 2023 The Chamberlain Group, LLC. All rights reserved. All
+ * information within this file and associated files, including all
+ * information and files transmitted with this file are CONFIDENTIAL
+ * and the proprietary property of The Chamberlain Group, LLC.
+ *
+ * In using the Licensed Software, Company shall not use with, combine, or
+ * incorporate any viral open source software with or into any of the Licensed
+ * Software in a manner that would require any portion of the Licensed software to
+ * be (i) disclosed or distributed in source code form; (ii) licensed for the
+ * purpose of making derivative works; or (iii) distributable or redistributable
+ * at no charge.
+ */
+
+#include "base_gpio_driver.h"
+#include "button_gpio.h"
+#include "host_board.h"
+#include "host_irq.h"
+#include "sl_sleeptimer.h"
+
+/**
+ * @brief  Emulated simple button instance.
+ */
+typedef struct
+{
+    volatile uint8_t state;   ///< 1 pressed, 0 released.
+    bool             enabled; ///< sl_simple_button_enable() was called.
+    host_irq_event_t change;  ///< Pending pin change interrupt.
+} host_button_t;
+
+/* Common gpio driver */
+base_gpio_drv button_drv;
+
+static host_button_t buttons[HOST_BUTTON_NUM];
+
+static callback_button_t _open_button_callback;
+static callback_button_t _close_button_callback;
+static callback_button_t _stop_button_callback;
+static callback_button_t _loopback_pin_callback;
+
+static sl_sleeptimer_timer_handle_t open_button_timer_handle;
+static sl_sleeptimer_timer_handle_t close_button_timer_handle;
+static sl_sleeptimer_timer_handle_t stop_button_timer_handle;
+
+// Local timeout param
+static uint32_t timeout = 0;
+
+// State handed to the callbacks, one per button since the debounce timer outlives the interrupt.
+static uint8_t button_state[HOST_BUTTON_NUM];
+
+static void button_timer_callback(sl_sleeptimer_timer_handle_t *handle, void *data)
+{
+    if(&open_button_timer_handle == handle)
+    {
+        _open_button_callback((uint8_t *)data);
+    }
+    else if(&close_button_timer_handle == handle)
+    {
+        _close_button_callback((uint8_t *)data);
+    }
+    else if(&stop_button_timer_handle == handle)
+    {
+        _stop_button_callback((uint8_t *)data);
+    }
+}
+
+static void process_button_task(sl_sleeptimer_timer_handle_t *handle, uint8_t *state)
+{
+    if(0U == *state)
+    {
+        sl_sleeptimer_start_timer_ms(handle, timeout, button_timer_callback, state, 0, 0);
+    }
+    else
+    {
+        button_timer_callback(handle, state);
+    }
+}
+
+static void button_on_change(void *arg)
+{
+    host_button_t *button = (host_button_t *)arg;
+    host_button_e  index  = (host_button_e)(button - buttons);
+
+    if(!button->enabled)
+    {
+        return;
+    }
+
+    button_state[index] = button->state;
+
+    if((HOST_BUTTON_OPEN == index) && (0 != _open_button_callback))
+    {
+        process_button_task(&open_button_timer_handle, &button_state[index]);
+    }
+    else if((HOST_BUTTON_CLOSE == index) && (0 != _close_button_callback))
+    {
+        process_button_task(&close_button_timer_handle, &button_state[index]);
+    }
+    else if((HOST_BUTTON_STOP == index) && (0 != _stop_button_callback))
+    {
+        process_button_task(&stop_button_timer_handle, &button_state[index]);
+    }
+    else if((HOST_BUTTON_LOOPBACK == index) && (0 != _loopback_pin_callback))
+    {
+        _loopback_pin_callback(&button_state[index]);
+    }
+}
+
+static uint8_t button_get(void *self, uint8_t *ptrState)
+{
+    host_button_t *button = (host_button_t *)self;
+
+    if(!button->enabled)
+    {
+        /* Error, probably Button disabled */
+        return 1;
+    }
+
+    *ptrState = button->state;
+    return 0;
+}
+
+static int button_enable(void *self)
+{
+    ((host_button_t *)self)->enabled = true;
+    return 0;
+}
+
+static void button_init_common(struct base_gpio_driver *hdlr, host_button_e index)
+{
+    hdlr->get    = (void *)button_get;
+    hdlr->handle = (void *)&buttons[index];
+    hdlr->enable = (void *)button_enable;
+
+    // The SDK enables the buttons in sl_simple_button_init_instances().
+    buttons[index].enabled = true;
+}
+
+void button_open_init(struct base_gpio_driver *hdlr, callback_button_t button_callback)
+{
+    button_init_common(hdlr, HOST_BUTTON_OPEN);
+    _open_button_callback = button_callback;
+}
+
+void button_close_init(struct base_gpio_driver *hdlr, callback_button_t button_callback)
+{
+    button_init_common(hdlr, HOST_BUTTON_CLOSE);
+    _close_button_callback = button_callback;
+}
+
+void button_stop_init(struct base_gpio_driver *hdlr, callback_button_t button_callback)
+{
+    button_init_common(hdlr, HOST_BUTTON_STOP);
+    _stop_button_callback = button_callback;
+}
+
+void button_loopback_init(struct base_gpio_driver *hdlr, callback_button_t button_callback)
+{
+    button_init_common(hdlr, HOST_BUTTON_LOOPBACK);
+    _loopback_pin_callback = button_callback;
+}
+
+void button_poll(void *self)
+{
+    // Buttons are interrupt driven, like in the SDK configuration.
+    (void)self;
+}
+
+void button_debounce_set(uint32_t time)
+{
+    timeout = time;
+}
+
+void host_button_set(host_button_e button, bool pressed)
+{
+    host_irq_disable();
+    buttons[button].state = pressed ? 1U : 0U;
+    host_irq_schedule(&buttons[button].change, 0, button_on_change, &buttons[button]);
+    host_irq_enable();
+}
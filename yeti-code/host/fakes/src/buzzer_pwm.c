@@ -0,0 +1,62 @@
+/** @file buzzer_pwm.c
+ *
+ * @brief Host buzzer PWM driver wrapper.
+ *
+ * @author Rene Delgado
+ *
+ * @copyright 2023 The Chamberlain Group, LLC. All rights reserved. All
+ * information within this file and associated files, including all
+ * information and files transmitted with this file are CONFIDENTIAL
+ * and the proprietary property of The Chamberlain Group, LLC.
+ *
+ * In using the Licensed Software, Company shall not use with, combine, or
+ * incorporate any viral open source software with or into any of the Licensed
+ * Software in a manner that would require any portion of the Licensed software to
+ * be (i) disclosed or distributed in source code form; (ii) licensed for the
+ * purpose of making derivative works; or (iii) distributable or redistributable
+ * at no charge.
+ */
+
+#include "base_pwm_driver.h"
+#include "buzzer_pwm.h"
+#include "host_board.h"
+
+static uint8_t buzzer_pwm_init(void *self, uint32_t *freq)
+{
+    (void)self;
+
+    host_board.buzzer_freq = *freq;
+    return 0;
+}
+
+static void buzzer_pwm_start(void *self)
+{
+    (void)self;
+
+    host_board.buzzer_on = true;
+    host_board.buzzer_starts++;
+}
+
+static void buzzer_pwm_stop(void *self)
+{
+    (void)self;
+
+    host_board.buzzer_on = false;
+}
+
+static uint8_t buzzer_pwm_set_dutycycle(void *self, uint8_t duty)
+{
+    (void)self;
+
+    host_board.buzzer_duty = duty;
+    return 0;
+}
+
+void buzzer_init(base_pwm_driver_t *dev)
+{
+    dev->init     = (void *)&buzzer_pwm_init;
+    dev->start    = (void *)&buzzer_pwm_start;
+    dev->stop     = (void *)&buzzer_pwm_stop;
+    dev->set_duty = (void *)&buzzer_pwm_set_dutycycle;
+    dev->handler  = (void *)&host_board;
+}
@@ -0,0 +1,38 @@
+/** @file cycle_counter.c
+ *
+ * @brief Host stand-in of the cycle counter wrapper: monotonic nanoseconds.
+ *
+ * @author Rene Delgado
+ *
+ * @copyright 2023 The Chamberlain Group, LLC. All rights reserved. All
+ * information within this file and associated files, including all
+ * information and files transmitted with this file are CONFIDENTIAL
+ * and the proprietary property of The Chamberlain Group, LLC.
+ *
+ * In using the Licensed Software, Company shall not use with, combine, or
+ * incorporate any viral open source software with or into any of the Licensed
+ * Software in a manner that would require any portion of the Licensed software to
+ * be (i) disclosed or distributed in source code form; (ii) licensed for the
+ * purpose of making derivative works; or (iii) distributable or redistributable
+ * at no charge.
+ */
+
+#include <time.h>
+
+#include "cycle_counter.h"
+
+#define HOST_CYCLE_COUNTER_NS_IN_S (1000000000ULL)
+
+void cycle_counter_init(void)
+{
+}
+
+uint32_t cycle_counter_read(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    // Truncated like CYCCNT: callers only use differences.
+    return (uint32_t)(((uint64_t)now.tv_sec * HOST_CYCLE_COUNTER_NS_IN_S) + (uint64_t)now.tv_nsec);
+}
@@ -0,0 +1,59 @@
+/** @file debug_uart.c
+ *
+ * @brief Host debug UART driver wrapper on top of the host_uart model.
+ *
+ * @author Rene Delgado
+ *
+ * @copyright 2023 The Chamberlain Group, LLC. All rights reserved. All
+ * information within this file and associated files, including all
+ * information and files transmitted with this file are CONFIDENTIAL
+ * and the proprietary property of The Chamberlain Group, LLC.
+ *
+ * In using the Licensed Software, Company shall not use with, combine, or
+ * incorporate any viral open source software with or into any of the Licensed
+ * Software in a manner that would require any portion of the Licensed software to
+ * be (i) disclosed or distributed in source code form; (ii) licensed for the
+ * purpose of making derivative works; or (iii) distributable or redistributable
+ * at no charge.
+ */
+
+#include "debug_uart.h"
+#include "host_uart.h"
+
+static uint8_t debug_uart_blocking_rx(void *self, const uint8_t *buff, size_t size)
+{
+    (void)self;
+    (void)buff;
+    (void)size;
+
+    // Not used by the firmware.
+    return 1;
+}
+
+static uint8_t debug_uart_blocking_tx(void *self, const uint8_t *buff, size_t size)
+{
+    (void)self;
+    (void)buff;
+    (void)size;
+
+    // Not used by the firmware.
+    return 1;
+}
+
+static int debug_uart_open(void *self, char *fspec)
+{
+    (void)self;
+    (void)fspec;
+
+    return 0;
+}
+
+void debug_uart_init(struct base_sercomm_driver *dev)
+{
+    dev->open               = (void *)debug_uart_open;
+    dev->write_non_blocking = (void *)host_uart_transmit;
+    dev->read_non_blocking  = (void *)host_uart_receive;
+    dev->write_blocking     = (void *)debug_uart_blocking_tx;
+    dev->read_blocking      = (void *)debug_uart_blocking_rx;
+    dev->handle             = host_uart_handle(HOST_UART_DEBUG);
+}
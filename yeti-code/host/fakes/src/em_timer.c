@@ -0,0 +1,129 @@
+/** @file em_timer.c
+ *
+ * @brief Host stand-in for the TIMER/CMU/NVIC emlib calls: TIMER2 overflows run on the emulated interrupt context.
+ *
+ * @author Rene Delgado
+ *
+ * @copyright 2023 The Chamberlain Group, LLC. All rights reserved. All
+ * information within this file and associated files, including all
+ * information and files transmitted with this file are CONFIDENTIAL
+ * and the proprietary property of The Chamberlain Group, LLC.
+ *
+ * In using the Licensed Software, Company shall not use with, combine, or
+ * incorporate any viral open source software with or into any of the Licensed
+ * Software in a manner that would require any portion of the Licensed software to
+ * be (i) disclosed or distributed in source code form; (ii) licensed for the
+ * purpose of making derivative works; or (iii) distributable or redistributable
+ * at no charge.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "em_cmu.h"
+#include "em_common.h"
+#include "em_timer.h"
+#include "host_irq.h"
+
+#define HOST_TIMER_CMD_RUNNING (0x1UL) ///< CMD bit 0 mirrors the counter running state.
+#define HOST_TIMER_US_IN_S (1000000ULL)
+
+TIMER_TypeDef host_timer2;
+
+static host_irq_event_t timer2_overflow_event;
+
+static uint64_t host_timer_period_us(const TIMER_TypeDef *timer)
+{
+    uint64_t ticks = ((uint64_t)timer->TOP + 1U) << timer->prescale;
+    uint64_t us    = (ticks * HOST_TIMER_US_IN_S) / HOST_CMU_HFXO_FREQUENCY;
+
+    return (0U != us) ? us : 1U;
+}
+
+static void host_timer_overflow(void *arg)
+{
+    TIMER_TypeDef *timer = (TIMER_TypeDef *)arg;
+
+    timer->IF |= TIMER_IF_OF;
+    if(0U != ((timer->IEN | timer->IEN_SET) & TIMER_IEN_OF))
+    {
+        TIMER2_IRQHandler();
+    }
+
+    // The ISR may have stopped the counter.
+    if(0U != (timer->CMD & HOST_TIMER_CMD_RUNNING))
+    {
+        host_irq_schedule(&timer2_overflow_event, host_timer_period_us(timer), host_timer_overflow, timer);
+    }
+}
+
+void assertEFM(const char *file, int line)
+{
+    fprintf(stderr, "EFM_ASSERT failed at %s:%d\n", file, line);
+    abort();
+}
+
+void NVIC_EnableIRQ(IRQn_Type irq)
+{
+    (void)irq;
+}
+
+uint32_t CMU_ClockFreqGet(CMU_Clock_TypeDef clock)
+{
+    (void)clock;
+    return HOST_CMU_HFXO_FREQUENCY;
+}
+
+void CMU_ClockEnable(CMU_Clock_TypeDef clock, bool enable)
+{
+    (void)clock;
+    host_timer2.EN = enable ? 1U : 0U;
+}
+
+void TIMER_Init(TIMER_TypeDef *timer, const TIMER_Init_TypeDef *init)
+{
+    timer->prescale = (uint32_t)init->prescale;
+    TIMER_Enable(timer, init->enable);
+}
+
+void TIMER_InitCC(TIMER_TypeDef *timer, unsigned int ch, const TIMER_InitCC_TypeDef *init)
+{
+    (void)timer;
+    (void)ch;
+    (void)init;
+}
+
+void TIMER_TopSet(TIMER_TypeDef *timer, uint32_t val)
+{
+    timer->TOP = val;
+}
+
+void TIMER_CompareSet(TIMER_TypeDef *timer, unsigned int ch, uint32_t val)
+{
+    (void)ch;
+    timer->CC0 = val;
+}
+
+void TIMER_IntClear(TIMER_TypeDef *timer, uint32_t flags)
+{
+    timer->IF &= ~flags;
+}
+
+void TIMER_Enable(TIMER_TypeDef *timer, bool enable)
+{
+    EFM_ASSERT(TIMER2 == timer);
+
+    if(enable)
+    {
+        if(0U == (timer->CMD & HOST_TIMER_CMD_RUNNING))
+        {
+            timer->CMD |= HOST_TIMER_CMD_RUNNING;
+            host_irq_schedule(&timer2_overflow_event, host_timer_period_us(timer), host_timer_overflow, timer);
+        }
+    }
+    else
+    {
+        timer->CMD &= ~HOST_TIMER_CMD_RUNNING;
+        host_irq_cancel(&timer2_overflow_event);
+    }
+}
@@ -0,0 +1,33 @@
+/** @file gpio_led.c
+ *
+ * @brief Host D10 LED driver wrapper.
+ *
+ * @author Rene Delgado
+ *
+ * @copyright 2023 The Chamberlain Group, LLC. All rights reserved. All
+ * information within this file and associated files, including all
+ * information and files transmitted with this file are CONFIDENTIAL
+ * and the proprietary property of The Chamberlain Group, LLC.
+ *
+ * In using the Licensed Software, Company shall not use with, combine, or
+ * incorporate any viral open source software with or into any of the Licensed
+ * Software in a manner that would require any portion of the Licensed software to
+ * be (i) disclosed or distributed in source code form; (ii) licensed for the
+ * purpose of making derivative works; or (iii) distributable or redistributable
+ * at no charge.
+ */
+
+#include "gpio_led.h"
+#include "host_board.h"
+
+host_board_t host_board;
+
+void led_d10_on(void)
+{
+    host_board.led_d10 = true;
+}
+
+void led_d10_off(void)
+{
+    host_board.led_d10 = false;
+}
@@ -0,0 +1,264 @@
+/** @file host_irq.c
+ *
+ * @brief Host emulation of the interrupt context (ISRs, DMA/UART completions, timers).
+ *
+ * @author Rene Delgado
+ *
+ * @copyright 2023 The Chamberlain Group, LLC. All rights reserved. All
+ * information within this file and associated files, including all
+ * information and files transmitted with this file are CONFIDENTIAL
+ * and the proprietary property of The Chamberlain Group, LLC.
+ *
+ * In using the Licensed Software, Company shall not use with, combine, or
+ * incorporate any viral open source software with or into any of the Licensed
+ * Software in a manner that would require any portion of the Licensed software to
+ * be (i) disclosed or distributed in source code form; (ii) licensed for the
+ * purpose of making derivative works; or (iii) distributable or redistributable
+ * at no charge.
+ */
+
+#include <pthread.h>
+#include <stddef.h>
+#include <time.h>
+
+#include "host_irq.h"
+
+#define HOST_IRQ_NS_IN_US (1000ULL)
+#define HOST_IRQ_US_IN_S (1000000ULL)
+
+static pthread_mutex_t   queue_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t    queue_cond;
+static pthread_mutex_t   cpu_lock; ///< Held while a handler runs or while the main loop masks interrupts.
+static host_irq_event_t *queue_head = NULL;
+static struct timespec   start_time;
+static bool              is_initialized = false;
+static bool              is_virtual     = false;
+static uint64_t          virtual_now_us = 0; ///< Virtual clock, only moved by host_irq_advance().
+
+static uint64_t host_irq_timespec_to_us(const struct timespec *ts)
+{
+    return ((uint64_t)ts->tv_sec * HOST_IRQ_US_IN_S) + ((uint64_t)ts->tv_nsec / HOST_IRQ_NS_IN_US);
+}
+
+static struct timespec host_irq_us_to_abs_timespec(uint64_t time_us)
+{
+    uint64_t        abs_us = host_irq_timespec_to_us(&start_time) + time_us;
+    struct timespec ts     = {.tv_sec  = (time_t)(abs_us / HOST_IRQ_US_IN_S),
+                              .tv_nsec = (long)((abs_us % HOST_IRQ_US_IN_S) * HOST_IRQ_NS_IN_US)};
+    return ts;
+}
+
+// Unlinks the event, queue_lock must be held.
+static void host_irq_unlink(host_irq_event_t *event)
+{
+    host_irq_event_t **link = &queue_head;
+
+    while(NULL != *link)
+    {
+        if(event == *link)
+        {
+            *link         = event->next;
+            event->next   = NULL;
+            event->queued = false;
+            break;
+        }
+        link = &(*link)->next;
+    }
+}
+
+static void *host_irq_thread(void *arg)
+{
+    (void)arg;
+
+    pthread_mutex_lock(&queue_lock);
+    while(true)
+    {
+        if(NULL == queue_head)
+        {
+            pthread_cond_wait(&queue_cond, &queue_lock);
+        }
+        else if(queue_head->due_us > host_irq_now_us())
+        {
+            struct timespec deadline = host_irq_us_to_abs_timespec(queue_head->due_us);
+            pthread_cond_timedwait(&queue_cond, &queue_lock, &deadline);
+        }
+        else
+        {
+            host_irq_event_t  *event   = queue_head;
+            host_irq_handler_t handler = event->handler;
+            void              *data    = event->arg;
+
+            host_irq_unlink(event);
+            pthread_mutex_unlock(&queue_lock);
+
+            pthread_mutex_lock(&cpu_lock);
+            handler(data);
+            pthread_mutex_unlock(&cpu_lock);
+
+            pthread_mutex_lock(&queue_lock);
+        }
+    }
+
+    return NULL;
+}
+
+void host_irq_init(void)
+{
+    pthread_condattr_t  cond_attr;
+    pthread_mutexattr_t mutex_attr;
+    pthread_t           thread;
+
+    if(is_initialized)
+    {
+        return;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &start_time);
+
+    pthread_condattr_init(&cond_attr);
+    pthread_condattr_setclock(&cond_attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&queue_cond, &cond_attr);
+    pthread_condattr_destroy(&cond_attr);
+
+    // Handlers and masked sections of the main loop may nest, like CORE_ENTER_ATOMIC on the target.
+    pthread_mutexattr_init(&mutex_attr);
+    pthread_mutexattr_settype(&mutex_attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&cpu_lock, &mutex_attr);
+    pthread_mutexattr_destroy(&mutex_attr);
+
+    is_initialized = true;
+    if(!is_virtual)
+    {
+        pthread_create(&thread, NULL, host_irq_thread, NULL);
+        pthread_detach(thread);
+    }
+}
+
+void host_irq_init_virtual(void)
+{
+    if(!is_initialized)
+    {
+        is_virtual = true;
+        host_irq_init();
+    }
+}
+
+bool host_irq_is_virtual(void)
+{
+    return is_virtual;
+}
+
+uint64_t host_irq_now_us(void)
+{
+    struct timespec now;
+
+    if(is_virtual)
+    {
+        return virtual_now_us;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return host_irq_timespec_to_us(&now) - host_irq_timespec_to_us(&start_time);
+}
+
+void host_irq_advance(uint64_t delay_us)
+{
+    uint64_t until_us;
+
+    if(!is_virtual)
+    {
+        struct timespec delay = {.tv_sec  = (time_t)(delay_us / HOST_IRQ_US_IN_S),
+                                 .tv_nsec = (long)((delay_us % HOST_IRQ_US_IN_S) * HOST_IRQ_NS_IN_US)};
+
+        while(0 != nanosleep(&delay, &delay))
+        {
+        }
+        return;
+    }
+
+    // Nothing else runs on the virtual clock: an idle main loop spin does not need the locks.
+    until_us = virtual_now_us + delay_us;
+    if(NULL == queue_head || queue_head->due_us > until_us)
+    {
+        virtual_now_us = until_us;
+        return;
+    }
+
+    // Same dispatch as host_irq_thread(), except that the clock jumps to the next due event instead of waiting.
+    pthread_mutex_lock(&cpu_lock);
+    pthread_mutex_lock(&queue_lock);
+    until_us = virtual_now_us + delay_us;
+    while(NULL != queue_head && queue_head->due_us <= until_us)
+    {
+        host_irq_event_t  *event   = queue_head;
+        host_irq_handler_t handler = event->handler;
+        void              *data    = event->arg;
+
+        host_irq_unlink(event);
+        if(event->due_us > virtual_now_us)
+        {
+            virtual_now_us = event->due_us;
+        }
+        pthread_mutex_unlock(&queue_lock);
+
+        handler(data);
+
+        pthread_mutex_lock(&queue_lock);
+    }
+    // A handler may have advanced the clock itself (a blocking delay in an interrupt).
+    if(until_us > virtual_now_us)
+    {
+        virtual_now_us = until_us;
+    }
+    pthread_mutex_unlock(&queue_lock);
+    pthread_mutex_unlock(&cpu_lock);
+}
+
+void host_irq_schedule(host_irq_event_t *event, uint64_t delay_us, host_irq_handler_t handler, void *arg)
+{
+    host_irq_event_t **link;
+
+    pthread_mutex_lock(&queue_lock);
+
+    if(event->queued)
+    {
+        host_irq_unlink(event);
+    }
+
+    event->due_us  = host_irq_now_us() + delay_us;
+    event->handler = handler;
+    event->arg     = arg;
+    event->queued  = true;
+
+    // Keep the queue sorted by due time, FIFO for equal due times.
+    link = &queue_head;
+    while(NULL != *link && (*link)->due_us <= event->due_us)
+    {
+        link = &(*link)->next;
+    }
+    event->next = *link;
+    *link       = event;
+
+    pthread_cond_signal(&queue_cond);
+    pthread_mutex_unlock(&queue_lock);
+}
+
+void host_irq_cancel(host_irq_event_t *event)
+{
+    pthread_mutex_lock(&queue_lock);
+    if(event->queued)
+    {
+        host_irq_unlink(event);
+    }
+    pthread_mutex_unlock(&queue_lock);
+}
+
+void host_irq_disable(void)
+{
+    pthread_mutex_lock(&cpu_lock);
+}
+
+void host_irq_enable(void)
+{
+    pthread_mutex_unlock(&cpu_lock);
+}
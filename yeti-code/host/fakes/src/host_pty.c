@@ -0,0 +1,105 @@
+/** @file host_pty.c
+ *
+ * @brief Pseudo-terminals bridging the host UARTs to serial port tooling (pyserial, main board test rigs).
+ *
+ * @author Rene Delgado
+ *
+ * @copyright 2023 The Chamberlain Group, LLC. All rights reserved. All
+ * information within this file and associated files, including all
+ * information and files transmitted with this file are CONFIDENTIAL
+ * and the proprietary property of The Chamberlain Group, LLC.
+ *
+ * In using the Licensed Software, Company shall not use with, combine, or
+ * incorporate any viral open source software with or into any of the Licensed
+ * Software in a manner that would require any portion of the Licensed software to
+ * be (i) disclosed or distributed in source code form; (ii) licensed for the
+ * purpose of making derivative works; or (iii) distributable or redistributable
+ * at no charge.
+ */
+
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include "host_pty.h"
+
+#define HOST_PTY_LINK_NUM (2U) ///< One per UART of the board.
+
+static const char *links[HOST_PTY_LINK_NUM];
+static bool        is_cleanup_registered = false;
+
+static void host_pty_remove_links(void)
+{
+    for(size_t i = 0; i < HOST_PTY_LINK_NUM; i++)
+    {
+        if(NULL != links[i])
+        {
+            unlink(links[i]);
+        }
+    }
+}
+
+static int host_pty_add_link(const char *link, const char *name)
+{
+    size_t slot = 0;
+
+    while(slot < HOST_PTY_LINK_NUM && NULL != links[slot])
+    {
+        slot++;
+    }
+    if(HOST_PTY_LINK_NUM == slot)
+    {
+        return -1;
+    }
+
+    unlink(link);
+    if(0 != symlink(name, link))
+    {
+        return -1;
+    }
+
+    links[slot] = link;
+    if(!is_cleanup_registered)
+    {
+        is_cleanup_registered = true;
+        atexit(host_pty_remove_links);
+    }
+
+    return 0;
+}
+
+int host_pty_open(const char *link, char *name, size_t size)
+{
+    struct termios tio;
+    int            fd = posix_openpt(O_RDWR | O_NOCTTY | O_NONBLOCK);
+
+    if(0 > fd)
+    {
+        return -1;
+    }
+
+    // Raw: the command broker frames are binary and must not be echoed back to the main board.
+    if(0 != grantpt(fd) || 0 != unlockpt(fd) || 0 != ptsname_r(fd, name, size) || 0 != tcgetattr(fd, &tio))
+    {
+        close(fd);
+        return -1;
+    }
+    cfmakeraw(&tio);
+    if(0 != tcsetattr(fd, TCSANOW, &tio))
+    {
+        close(fd);
+        return -1;
+    }
+
+    if(NULL != link && 0 != host_pty_add_link(link, name))
+    {
+        close(fd);
+        return -1;
+    }
+
+    return fd;
+}
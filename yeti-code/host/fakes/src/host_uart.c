@@ -0,0 +1,407 @@
+/** @file host_uart.c
+ *
+ * @brief Host UART model backing the powered and debug UART fakes: file descriptors paced at the configured baud rate.
+ *
+ * @author Rene Delgado
+ *
+ * @copyright 2023 The Chamberlain Group, LLC. All rights reserved. All
+ * information within this file and associated files, including all
+ * information and files transmitted with this file are CONFIDENTIAL
+ * and the proprietary property of The Chamberlain Group, LLC.
+ *
+ * In using the Licensed Software, Company shall not use with, combine, or
+ * incorporate any viral open source software with or into any of the Licensed
+ * Software in a manner that would require any portion of the Licensed software to
+ * be (i) disclosed or distributed in source code form; (ii) licensed for the
+ * purpose of making derivative works; or (iii) distributable or redistributable
+ * at no charge.
+ */
+
+#include <errno.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stddef.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "host_irq.h"
+#include "host_uart.h"
+
+#define HOST_UART_RX_FIFO_SIZE (16U) ///< EUSART receive FIFO depth.
+#define HOST_UART_TX_QUEUE_SIZE (6U) ///< SL_UARTDRV_EUSART_POWERED_UART_TX_BUFFER_SIZE.
+#define HOST_UART_BITS_PER_BYTE (10U) ///< 8N1: start + 8 data + stop.
+#define HOST_UART_US_IN_S (1000000ULL)
+#define HOST_UART_NS_IN_US (1000ULL)
+#define HOST_UART_HANGUP_POLL_NS (10000000L) ///< Retry period while a terminal has no peer.
+
+/**
+ * @brief  Queued transmission.
+ */
+typedef struct
+{
+    const uint8_t      *buff;
+    size_t              size;
+    callback_transmit_t callback;
+} host_uart_tx_t;
+
+/**
+ * @brief  One UART instance.
+ */
+typedef struct
+{
+    int      in_fd;
+    int      out_fd;
+    uint32_t baud;
+
+    // Receive side, the FIFO is shared with the reader thread under fifo_lock.
+    pthread_mutex_t    fifo_lock;
+    uint8_t            fifo[HOST_UART_RX_FIFO_SIZE];
+    uint8_t            fifo_head;
+    uint8_t            fifo_count;
+    bool               rx_eof;
+    host_irq_event_t   rx_event;
+    host_irq_event_t   pull_event; ///< Next input byte on the wire, replaces the reader thread on the virtual clock.
+    uint8_t           *rx_buff;
+    size_t             rx_size;
+    size_t             rx_count;
+    callback_receive_t rx_callback;
+
+    // Transmit side, only touched with interrupts masked or from the interrupt context.
+    host_uart_tx_t   tx_queue[HOST_UART_TX_QUEUE_SIZE];
+    uint8_t          tx_head;
+    uint8_t          tx_count;
+    host_irq_event_t tx_event;
+
+    host_uart_monitor_t monitor;
+    void               *monitor_arg;
+
+    host_uart_stats_t stats;
+    bool              is_open;
+} host_uart_t;
+
+static host_uart_t uarts[HOST_UART_NUM] = {
+    [HOST_UART_POWERED] = {.in_fd = -1, .out_fd = -1, .fifo_lock = PTHREAD_MUTEX_INITIALIZER},
+    [HOST_UART_DEBUG]   = {.in_fd = -1, .out_fd = -1, .fifo_lock = PTHREAD_MUTEX_INITIALIZER},
+};
+
+static uint64_t host_uart_bytes_to_us(const host_uart_t *uart, size_t size)
+{
+    if(0U == uart->baud)
+    {
+        return 0U;
+    }
+    return ((uint64_t)size * HOST_UART_BITS_PER_BYTE * HOST_UART_US_IN_S) / uart->baud;
+}
+
+static void host_uart_rx_deliver(void *arg)
+{
+    host_uart_t *uart = (host_uart_t *)arg;
+
+    while(NULL != uart->rx_buff)
+    {
+        uint8_t           *buff;
+        size_t             size;
+        callback_receive_t callback;
+
+        pthread_mutex_lock(&uart->fifo_lock);
+        if(0U == uart->fifo_count)
+        {
+            pthread_mutex_unlock(&uart->fifo_lock);
+            break;
+        }
+        uart->rx_buff[uart->rx_count++] = uart->fifo[uart->fifo_head];
+        uart->fifo_head                 = (uint8_t)((uart->fifo_head + 1U) % HOST_UART_RX_FIFO_SIZE);
+        uart->fifo_count--;
+        pthread_mutex_unlock(&uart->fifo_lock);
+
+        uart->stats.rx_bytes++;
+        if(NULL != uart->monitor)
+        {
+            uart->monitor(uart->monitor_arg, true, uart->rx_buff[uart->rx_count - 1U]);
+        }
+        if(uart->rx_count < uart->rx_size)
+        {
+            continue;
+        }
+
+        // The callback usually re-arms the reception, so the request is released first.
+        buff              = uart->rx_buff;
+        size              = uart->rx_size;
+        callback          = uart->rx_callback;
+        uart->rx_buff     = NULL;
+        uart->rx_callback = NULL;
+        if(NULL != callback)
+        {
+            callback(0, buff, size);
+        }
+    }
+}
+
+// Queues a byte completed on the wire and wakes the receive side.
+static void host_uart_rx_push(host_uart_t *uart, uint8_t byte)
+{
+    pthread_mutex_lock(&uart->fifo_lock);
+    if(HOST_UART_RX_FIFO_SIZE > uart->fifo_count)
+    {
+        uart->fifo[(uart->fifo_head + uart->fifo_count) % HOST_UART_RX_FIFO_SIZE] = byte;
+        uart->fifo_count++;
+    }
+    else
+    {
+        uart->stats.rx_overruns++;
+    }
+    pthread_mutex_unlock(&uart->fifo_lock);
+
+    host_irq_schedule(&uart->rx_event, 0, host_uart_rx_deliver, uart);
+}
+
+// Blocks until the next input byte, false at end of file. A terminal without peer (a pseudo-terminal nobody opened
+// yet, or whose client went away) is waited on instead: the link is down, it is not the end of the input.
+static bool host_uart_read_byte(const host_uart_t *uart, uint8_t *byte)
+{
+    while(true)
+    {
+        ssize_t len = read(uart->in_fd, byte, 1);
+
+        if(1 == len)
+        {
+            return true;
+        }
+        if(0 > len && EINTR == errno)
+        {
+            continue;
+        }
+        if(0 > len && (EAGAIN == errno || EWOULDBLOCK == errno))
+        {
+            struct pollfd pfd = {.fd = uart->in_fd, .events = POLLIN};
+            poll(&pfd, 1, -1);
+            continue;
+        }
+        if(0 > len && EIO == errno && isatty(uart->in_fd))
+        {
+            struct timespec delay = {.tv_sec = 0, .tv_nsec = HOST_UART_HANGUP_POLL_NS};
+            nanosleep(&delay, NULL);
+            continue;
+        }
+        return false;
+    }
+}
+
+// Virtual clock reader: one byte per character time, read from the interrupt context. The read blocks, so the
+// simulation waits for a slow producer instead of seeing a gap that depends on the host load.
+static void host_uart_pull(void *arg)
+{
+    host_uart_t *uart = (host_uart_t *)arg;
+    uint8_t      byte;
+
+    if(!host_uart_read_byte(uart, &byte))
+    {
+        pthread_mutex_lock(&uart->fifo_lock);
+        uart->rx_eof = true;
+        pthread_mutex_unlock(&uart->fifo_lock);
+        return;
+    }
+
+    host_uart_rx_push(uart, byte);
+    host_irq_schedule(&uart->pull_event, host_uart_bytes_to_us(uart, 1), host_uart_pull, uart);
+}
+
+static void *host_uart_reader(void *arg)
+{
+    host_uart_t    *uart = (host_uart_t *)arg;
+    struct timespec next;
+    uint8_t         byte;
+
+    clock_gettime(CLOCK_MONOTONIC, &next);
+    while(host_uart_read_byte(uart, &byte))
+    {
+        // The byte is complete on the wire one character time after the previous one at the earliest.
+        if(0U != uart->baud)
+        {
+            struct timespec now;
+            uint64_t        next_ns;
+
+            clock_gettime(CLOCK_MONOTONIC, &now);
+            if((now.tv_sec > next.tv_sec) || ((now.tv_sec == next.tv_sec) && (now.tv_nsec > next.tv_nsec)))
+            {
+                next = now;
+            }
+            next_ns      = (uint64_t)next.tv_nsec + (host_uart_bytes_to_us(uart, 1) * HOST_UART_NS_IN_US);
+            next.tv_sec += (time_t)(next_ns / (HOST_UART_US_IN_S * HOST_UART_NS_IN_US));
+            next.tv_nsec = (long)(next_ns % (HOST_UART_US_IN_S * HOST_UART_NS_IN_US));
+            while(0 != clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, NULL))
+            {
+            }
+        }
+
+        host_uart_rx_push(uart, byte);
+    }
+
+    pthread_mutex_lock(&uart->fifo_lock);
+    uart->rx_eof = true;
+    pthread_mutex_unlock(&uart->fifo_lock);
+
+    return NULL;
+}
+
+static void host_uart_tx_complete(void *arg)
+{
+    host_uart_t         *uart  = (host_uart_t *)arg;
+    const host_uart_tx_t done  = uart->tx_queue[uart->tx_head];
+    size_t               wrote = 0;
+
+    while((0 <= uart->out_fd) && (wrote < done.size))
+    {
+        ssize_t len = write(uart->out_fd, done.buff + wrote, done.size - wrote);
+
+        if(0 > len)
+        {
+            if(EINTR == errno)
+            {
+                continue;
+            }
+            // Including a non blocking terminal nobody reads: the bytes are lost, like with nothing on the wire.
+            break;
+        }
+        wrote += (size_t)len;
+    }
+
+    for(size_t i = 0; (NULL != uart->monitor) && (i < done.size); i++)
+    {
+        uart->monitor(uart->monitor_arg, false, done.buff[i]);
+    }
+
+    uart->stats.tx_bytes += (uint32_t)done.size;
+    uart->tx_head         = (uint8_t)((uart->tx_head + 1U) % HOST_UART_TX_QUEUE_SIZE);
+    uart->tx_count--;
+
+    if(0U != uart->tx_count)
+    {
+        const host_uart_tx_t *next = &uart->tx_queue[uart->tx_head];
+        host_irq_schedule(&uart->tx_event, host_uart_bytes_to_us(uart, next->size), host_uart_tx_complete, uart);
+    }
+
+    if(NULL != done.callback)
+    {
+        done.callback(0, (uint8_t *)done.buff, done.size);
+    }
+}
+
+void host_uart_configure(host_uart_id_e id, int in_fd, int out_fd, uint32_t baud)
+{
+    host_uart_t *uart = &uarts[id];
+
+    uart->in_fd  = in_fd;
+    uart->out_fd = out_fd;
+    uart->baud   = baud;
+}
+
+void *host_uart_handle(host_uart_id_e id)
+{
+    host_uart_t *uart = &uarts[id];
+
+    if(!uart->is_open)
+    {
+        uart->is_open = true;
+        host_irq_init();
+        if(0 <= uart->in_fd && host_irq_is_virtual())
+        {
+            host_irq_schedule(&uart->pull_event, host_uart_bytes_to_us(uart, 1), host_uart_pull, uart);
+        }
+        else if(0 <= uart->in_fd)
+        {
+            pthread_t thread;
+            pthread_create(&thread, NULL, host_uart_reader, uart);
+            pthread_detach(thread);
+        }
+        else
+        {
+            uart->rx_eof = true;
+        }
+    }
+
+    return uart;
+}
+
+uint8_t host_uart_transmit(void *handle, const uint8_t *buff, size_t size, callback_transmit_t callback)
+{
+    host_uart_t *uart   = (host_uart_t *)handle;
+    uint8_t      retval = 0;
+
+    host_irq_disable();
+    if(HOST_UART_TX_QUEUE_SIZE <= uart->tx_count)
+    {
+        uart->stats.tx_queue_full++;
+        retval = 1;
+    }
+    else
+    {
+        uint8_t slot         = (uint8_t)((uart->tx_head + uart->tx_count) % HOST_UART_TX_QUEUE_SIZE);
+        uart->tx_queue[slot] = (host_uart_tx_t){.buff = buff, .size = size, .callback = callback};
+        uart->tx_count++;
+        if(1U == uart->tx_count)
+        {
+            host_irq_schedule(&uart->tx_event, host_uart_bytes_to_us(uart, size), host_uart_tx_complete, uart);
+        }
+    }
+    host_irq_enable();
+
+    return retval;
+}
+
+uint8_t host_uart_receive(void *handle, uint8_t *buff, size_t size, callback_receive_t callback)
+{
+    host_uart_t *uart   = (host_uart_t *)handle;
+    uint8_t      retval = 0;
+
+    host_irq_disable();
+    if(NULL != uart->rx_buff || 0U == size)
+    {
+        retval = 1;
+    }
+    else
+    {
+        uart->rx_buff     = buff;
+        uart->rx_size     = size;
+        uart->rx_count    = 0;
+        uart->rx_callback = callback;
+        // Bytes may already wait in the FIFO.
+        host_irq_schedule(&uart->rx_event, 0, host_uart_rx_deliver, uart);
+    }
+    host_irq_enable();
+
+    return retval;
+}
+
+void host_uart_set_monitor(host_uart_id_e id, host_uart_monitor_t monitor, void *arg)
+{
+    host_irq_disable();
+    uarts[id].monitor     = monitor;
+    uarts[id].monitor_arg = arg;
+    host_irq_enable();
+}
+
+bool host_uart_is_drained(host_uart_id_e id)
+{
+    host_uart_t *uart = &uarts[id];
+    bool         drained;
+
+    host_irq_disable();
+    pthread_mutex_lock(&uart->fifo_lock);
+    drained = uart->rx_eof && (0U == uart->fifo_count) && !uart->rx_event.queued && (0U == uart->tx_count);
+    pthread_mutex_unlock(&uart->fifo_lock);
+    host_irq_enable();
+
+    return drained;
+}
+
+host_uart_stats_t host_uart_get_stats(host_uart_id_e id)
+{
+    host_uart_stats_t stats;
+
+    host_irq_disable();
+    stats = uarts[id].stats;
+    host_irq_enable();
+
+    return stats;
+}
@@ -0,0 +1,41 @@
+/** @file lcd_gpio.c
+ *
+ * @brief Host LCD backlight and reset lines driver wrapper.
+ *
+ * @author Rene Delgado
+ *
+ * @copyright 2023 The Chamberlain Group, LLC. All rights reserved. All
+ * information within this file and associated files, including all
+ * information and files transmitted with this file are CONFIDENTIAL
+ * and the proprietary property of The Chamberlain Group, LLC.
+ *
+ * In using the Licensed Software, Company shall not use with, combine, or
+ * incorporate any viral open source software with or into any of the Licensed
+ * Software in a manner that would require any portion of the Licensed software to
+ * be (i) disclosed or distributed in source code form; (ii) licensed for the
+ * purpose of making derivative works; or (iii) distributable or redistributable
+ * at no charge.
+ */
+
+#include "host_board.h"
+#include "lcd_gpio.h"
+
+void lcd_gpio_backlight_on(void)
+{
+    host_board.lcd_backlight = true;
+}
+
+void lcd_gpio_backlight_off(void)
+{
+    host_board.lcd_backlight = false;
+}
+
+void lcd_gpio_reset_on(void)
+{
+    host_board.lcd_reset = true;
+}
+
+void lcd_gpio_reset_off(void)
+{
+    host_board.lcd_reset = false;
+}
@@ -0,0 +1,186 @@
+/** @file lcd_spi.c
+ *
+ * @brief Host LCD SPI driver wrapper: frames go to the host_spi sink instead of SPIDRV.
+ *
+ * @author Rene Delgado
+ *
+ * @copyright 2023 The Chamberlain Group, LLC. All rights reserved. All
+ * information within this file and associated files, including all
+ * information and files transmitted with this file are CONFIDENTIAL
+ * and the proprietary property of The Chamberlain Group, LLC.
+ *
+ * In using the Licensed Software, Company shall not use with, combine, or
+ * incorporate any viral open source software with or into any of the Licensed
+ * Software in a manner that would require any portion of the Licensed software to
+ * be (i) disclosed or distributed in source code form; (ii) licensed for the
+ * purpose of making derivative works; or (iii) distributable or redistributable
+ * at no charge.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "host_irq.h"
+#include "host_spi.h"
+#include "lcd_spi.h"
+
+#define HOST_SPI_US_IN_S (1000000ULL)
+
+/**
+ * @brief  State of the emulated bus.
+ */
+typedef struct
+{
+    host_spi_sink_t     sink;
+    void               *sink_arg;
+    uint64_t            wire_free_us; ///< Time the last queued frame leaves the wire.
+    callback_transmit_t callback;
+    uint8_t            *callback_buff;
+    size_t              callback_size;
+    host_irq_event_t    done_event;
+    host_spi_stats_t    stats;
+} host_spi_t;
+
+static host_spi_t lcd_spi_bus;
+
+static void lcd_spi_non_blocking_tx_callback(void *arg)
+{
+    host_spi_t         *bus      = (host_spi_t *)arg;
+    callback_transmit_t callback = bus->callback;
+
+    bus->callback = NULL;
+    if(NULL != callback)
+    {
+        callback(0, bus->callback_buff, bus->callback_size);
+    }
+}
+
+// SPIDRV refuses a transfer while the previous one is on the wire, with or without a completion callback. A blocking
+// transfer returns once its frames left the wire: the bus is free again for the next call
+static uint8_t lcd_spi_tx(host_spi_t *bus, const uint8_t *buff, size_t size, callback_transmit_t callback, bool blocking)
+{
+    uint8_t  retval = 0;
+    uint64_t now_us;
+
+    host_irq_disable();
+    now_us = host_irq_now_us();
+    if((NULL != bus->callback) || (bus->wire_free_us > now_us))
+    {
+        // ECODE_EMDRV_SPIDRV_BUSY
+        bus->stats.busy_refused++;
+        retval = 1;
+    }
+    else
+    {
+        uint64_t wire_us = (size * HOST_SPI_FRAME_BITS * HOST_SPI_US_IN_S) / HOST_SPI_BITRATE;
+
+        bus->wire_free_us = blocking ? now_us : (now_us + wire_us);
+        bus->stats.wire_us += wire_us;
+        bus->stats.transfers++;
+        bus->stats.frames += (uint32_t)size;
+
+        // Frames are consumed right away, the caller's buffer may be gone by the time the wire is free.
+        if(NULL != bus->sink)
+        {
+            bus->sink(bus->sink_arg, (const uint16_t *)(const void *)buff, size);
+        }
+
+        if(NULL != callback)
+        {
+            bus->callback      = callback;
+            bus->callback_buff = (uint8_t *)buff;
+            bus->callback_size = size;
+            host_irq_schedule(&bus->done_event, bus->wire_free_us - now_us, lcd_spi_non_blocking_tx_callback, bus);
+        }
+    }
+    host_irq_enable();
+
+    return retval;
+}
+
+static uint8_t lcd_spi_non_blocking_tx(void *self, const uint8_t *buff, size_t size, callback_transmit_t callback)
+{
+    return lcd_spi_tx((host_spi_t *)self, buff, size, callback, false);
+}
+
+static uint8_t lcd_spi_non_blocking_rx(void *self, uint8_t *buff, size_t size)
+{
+    (void)self;
+    (void)buff;
+    (void)size;
+
+    // The UC1601s read back path is not wired on the board.
+    return 1;
+}
+
+static uint8_t lcd_spi_blocking_rx(void *self, const uint8_t *buff, size_t size)
+{
+    (void)self;
+    (void)buff;
+    (void)size;
+
+    return 1;
+}
+
+static uint8_t lcd_spi_blocking_tx(void *self, const uint16_t *buff, size_t size)
+{
+    return lcd_spi_tx((host_spi_t *)self, (const uint8_t *)(const void *)buff, size, NULL, true);
+}
+
+static int lcd_spi_open(void *self, char *fspec)
+{
+    (void)self;
+    (void)fspec;
+
+    host_irq_init();
+    return 0;
+}
+
+void lcd_spi_init(struct base_sercomm_driver *dev)
+{
+    host_irq_init();
+
+    dev->open               = (void *)lcd_spi_open;
+    dev->write_non_blocking = (void *)lcd_spi_non_blocking_tx;
+    dev->read_non_blocking  = (void *)lcd_spi_non_blocking_rx;
+    dev->write_blocking     = (void *)lcd_spi_blocking_tx;
+    dev->read_blocking      = (void *)lcd_spi_blocking_rx;
+    dev->handle             = &lcd_spi_bus;
+}
+
+void host_spi_set_sink(host_spi_sink_t sink, void *arg)
+{
+    host_irq_disable();
+    lcd_spi_bus.sink     = sink;
+    lcd_spi_bus.sink_arg = arg;
+    host_irq_enable();
+}
+
+host_spi_stats_t host_spi_get_stats(void)
+{
+    host_spi_stats_t stats;
+
+    host_irq_disable();
+    stats = lcd_spi_bus.stats;
+    host_irq_enable();
+
+    return stats;
+}
+
+void host_spi_reset_stats(void)
+{
+    host_irq_disable();
+    lcd_spi_bus.stats = (host_spi_stats_t){0};
+    host_irq_enable();
+}
+
+uint64_t host_spi_wire_free_us(void)
+{
+    uint64_t wire_free_us;
+
+    host_irq_disable();
+    wire_free_us = lcd_spi_bus.wire_free_us;
+    host_irq_enable();
+
+    return wire_free_us;
+}
@@ -0,0 +1,213 @@
+/** @file sl_sleeptimer.c
+ *
+ * @brief Host stand-in for the Gecko SDK sleeptimer service, timeouts run on the emulated interrupt context.
+ *
+ * @author Rene Delgado
+ *
+ * @copyright 2023 The Chamberlain Group, LLC. All rights reserved. All
+ * information within this file and associated files, including all
+ * information and files transmitted with this file are CONFIDENTIAL
+ * and the proprietary property of The Chamberlain Group, LLC.
+ *
+ * In using the Licensed Software, Company shall not use with, combine, or
+ * incorporate any viral open source software with or into any of the Licensed
+ * Software in a manner that would require any portion of the Licensed software to
+ * be (i) disclosed or distributed in source code form; (ii) licensed for the
+ * purpose of making derivative works; or (iii) distributable or redistributable
+ * at no charge.
+ */
+
+#include <stddef.h>
+
+#include "sl_sleeptimer.h"
+
+#define HOST_SLEEPTIMER_US_IN_S (1000000ULL)
+#define HOST_SLEEPTIMER_MS_IN_S (1000ULL)
+#define HOST_SLEEPTIMER_US_IN_MS (1000ULL)
+
+static uint64_t host_sleeptimer_tick_to_us(uint32_t tick)
+{
+    return ((uint64_t)tick * HOST_SLEEPTIMER_US_IN_S) / HOST_SLEEPTIMER_FREQUENCY;
+}
+
+static void host_sleeptimer_expired(void *arg)
+{
+    sl_sleeptimer_timer_handle_t *handle = (sl_sleeptimer_timer_handle_t *)arg;
+
+    // Restarted by the main loop after this expiry was dequeued: the new timeout wins.
+    if(handle->event.queued)
+    {
+        return;
+    }
+
+    if(0U != handle->timeout_periodic)
+    {
+        host_irq_schedule(&handle->event, host_sleeptimer_tick_to_us(handle->timeout_periodic),
+                          host_sleeptimer_expired, handle);
+    }
+
+    if(NULL != handle->callback)
+    {
+        handle->callback(handle, handle->callback_data);
+    }
+}
+
+static sl_status_t host_sleeptimer_create(sl_sleeptimer_timer_handle_t  *handle,
+                                          uint32_t                       timeout,
+                                          uint32_t                       timeout_periodic,
+                                          sl_sleeptimer_timer_callback_t callback,
+                                          void                          *callback_data,
+                                          uint8_t                        priority,
+                                          uint16_t                       option_flags,
+                                          bool                           restart)
+{
+    sl_status_t status = SL_STATUS_OK;
+
+    if(NULL == handle)
+    {
+        return SL_STATUS_NULL_POINTER;
+    }
+
+    host_irq_disable();
+    if(handle->event.queued && !restart)
+    {
+        status = SL_STATUS_INVALID_STATE;
+    }
+    else
+    {
+        handle->callback_data    = callback_data;
+        handle->priority         = priority;
+        handle->option_flags     = option_flags;
+        handle->callback         = callback;
+        handle->timeout_periodic = timeout_periodic;
+        host_irq_schedule(&handle->event, host_sleeptimer_tick_to_us(timeout), host_sleeptimer_expired, handle);
+    }
+    host_irq_enable();
+
+    return status;
+}
+
+sl_status_t sl_sleeptimer_init(void)
+{
+    host_irq_init();
+    return SL_STATUS_OK;
+}
+
+sl_status_t sl_sleeptimer_start_timer(sl_sleeptimer_timer_handle_t  *handle,
+                                      uint32_t                       timeout,
+                                      sl_sleeptimer_timer_callback_t callback,
+                                      void                          *callback_data,
+                                      uint8_t                        priority,
+                                      uint16_t                       option_flags)
+{
+    return host_sleeptimer_create(handle, timeout, 0U, callback, callback_data, priority, option_flags, false);
+}
+
+sl_status_t sl_sleeptimer_restart_timer(sl_sleeptimer_timer_handle_t  *handle,
+                                        uint32_t                       timeout,
+                                        sl_sleeptimer_timer_callback_t callback,
+                                        void                          *callback_data,
+                                        uint8_t                        priority,
+                                        uint16_t                       option_flags)
+{
+    return host_sleeptimer_create(handle, timeout, 0U, callback, callback_data, priority, option_flags, true);
+}
+
+sl_status_t sl_sleeptimer_start_periodic_timer(sl_sleeptimer_timer_handle_t  *handle,
+                                               uint32_t                       timeout,
+                                               sl_sleeptimer_timer_callback_t callback,
+                                               void                          *callback_data,
+                                               uint8_t                        priority,
+                                               uint16_t                       option_flags)
+{
+    return host_sleeptimer_create(handle, timeout, timeout, callback, callback_data, priority, option_flags, false);
+}
+
+sl_status_t sl_sleeptimer_restart_periodic_timer(sl_sleeptimer_timer_handle_t  *handle,
+                                                 uint32_t                       timeout,
+                                                 sl_sleeptimer_timer_callback_t callback,
+                                                 void                          *callback_data,
+                                                 uint8_t                        priority,
+                                                 uint16_t                       option_flags)
+{
+    return host_sleeptimer_create(handle, timeout, timeout, callback, callback_data, priority, option_flags, true);
+}
+
+sl_status_t sl_sleeptimer_stop_timer(sl_sleeptimer_timer_handle_t *handle)
+{
+    sl_status_t status = SL_STATUS_OK;
+
+    if(NULL == handle)
+    {
+        return SL_STATUS_NULL_POINTER;
+    }
+
+    host_irq_disable();
+    if(!handle->event.queued)
+    {
+        status = SL_STATUS_INVALID_STATE;
+    }
+    else
+    {
+        handle->timeout_periodic = 0U;
+        host_irq_cancel(&handle->event);
+    }
+    host_irq_enable();
+
+    return status;
+}
+
+sl_status_t sl_sleeptimer_is_timer_running(sl_sleeptimer_timer_handle_t *handle, bool *running)
+{
+    if((NULL == handle) || (NULL == running))
+    {
+        return SL_STATUS_NULL_POINTER;
+    }
+
+    *running = handle->event.queued;
+    return SL_STATUS_OK;
+}
+
+uint32_t sl_sleeptimer_get_tick_count(void)
+{
+    return (uint32_t)sl_sleeptimer_get_tick_count64();
+}
+
+uint64_t sl_sleeptimer_get_tick_count64(void)
+{
+    return (host_irq_now_us() * HOST_SLEEPTIMER_FREQUENCY) / HOST_SLEEPTIMER_US_IN_S;
+}
+
+uint32_t sl_sleeptimer_get_timer_frequency(void)
+{
+    return HOST_SLEEPTIMER_FREQUENCY;
+}
+
+void sl_sleeptimer_delay_millisecond(uint16_t time_ms)
+{
+    // Like the SDK busy wait, the timers keep firing during the delay (on the calling thread with the virtual clock).
+    host_irq_advance((uint64_t)time_ms * HOST_SLEEPTIMER_US_IN_MS);
+}
+
+uint32_t sl_sleeptimer_ms_to_tick(uint16_t time_ms)
+{
+    return (uint32_t)(((uint64_t)time_ms * HOST_SLEEPTIMER_FREQUENCY) / HOST_SLEEPTIMER_MS_IN_S);
+}
+
+sl_status_t sl_sleeptimer_ms32_to_tick(uint32_t time_ms, uint32_t *tick)
+{
+    uint64_t ticks = ((uint64_t)time_ms * HOST_SLEEPTIMER_FREQUENCY) / HOST_SLEEPTIMER_MS_IN_S;
+
+    if(UINT32_MAX < ticks)
+    {
+        return SL_STATUS_INVALID_PARAMETER;
+    }
+
+    *tick = (uint32_t)ticks;
+    return SL_STATUS_OK;
+}
+
+uint32_t sl_sleeptimer_tick_to_ms(uint32_t tick)
+{
+    return (uint32_t)(((uint64_t)tick * HOST_SLEEPTIMER_MS_IN_S) / HOST_SLEEPTIMER_FREQUENCY);
+}
@@ -0,0 +1,44 @@
+/** @file watchdog.c
+ *
+ * @brief Host watchdog driver wrapper.
+ *
+ * @author Rene Delgado
+ *
+ * @copyright 2023 The Chamberlain Group, LLC. All rights reserved. All
+ * information within this file and associated files, including all
+ * information and files transmitted with this file are CONFIDENTIAL
+ * and the proprietary property of The Chamberlain Group, LLC.
+ *
+ * In using the Licensed Software, Company shall not use with, combine, or
+ * incorporate any viral open source software with or into any of the Licensed
+ * Software in a manner that would require any portion of the Licensed software to
+ * be (i) disclosed or distributed in source code form; (ii) licensed for the
+ * purpose of making derivative works; or (iii) distributable or redistributable
+ * at no charge.
+ */
+
+#include <stdlib.h>
+
+#include "host_board.h"
+#include "watchdog.h"
+
+void watchdog_off(void)
+{
+    host_board.watchdog_enabled = false;
+}
+
+void watchdog_init(void)
+{
+    host_board.watchdog_enabled = true;
+}
+
+void watchdog_reset_processor(void)
+{
+    // CHIP_Reset() equivalent: the host process stops.
+    exit(EXIT_FAILURE);
+}
+
+void watchdog_feed(void)
+{
+    host_board.watchdog_feeds++;
+}
@@ -0,0 +1,832 @@
+/** @file golden.c
+ *
+ * @brief Golden-frame regression suite: renders LCD scenarios on the host and checks pixels, cycle and SPI budgets.
+ *
+ * @author Rene Delgado
+ *
+ * @copyright 2023 The Chamberlain Group, LLC. All rights reserved. All
+ * information within this file and associated files, including all
+ * information and files transmitted with this file are CONFIDENTIAL
+ * and the proprietary property of The Chamberlain Group, LLC.
+ *
+ * In using the Licensed Software, Company shall not use with, combine, or
+ * incorporate any viral open source software with or into any of the Licensed
+ * Software in a manner that would require any portion of the Licensed software to
+ * be (i) disclosed or distributed in source code form; (ii) licensed for the
+ * purpose of making derivative works; or (iii) distributable or redistributable
+ * at no charge.
+ */
+
+#include <errno.h>
+#include <getopt.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "bench_clock.h"
+#include "host_irq.h"
+#include "host_spi.h"
+#include "lcd_spi.h"
+#include "uc1601s.h"
+
+// The blink and flush helpers are static: lcd.c is built into this translation unit as is.
+#include "source/hal/src/lcd.c"
+
+#define GOLDEN_SCENARIOS_MAX (128U)
+#define GOLDEN_STEPS_MAX (8U)
+#define GOLDEN_NAME_MAX (32U)
+#define GOLDEN_TEXT_CHARS (RIGHT_ALIGNMENT_BYTE - PRINT_LINE_CHARS) ///< Text characters between the icons.
+#define GOLDEN_REPS_DEFAULT (256U)         ///< Timed repetitions of every scenario, the fastest one is kept.
+#define GOLDEN_CYCLE_HEADROOM_PCT (100U)   ///< Cycle budget written by --update, above the measured cost.
+#define GOLDEN_CYCLE_ROUNDING (100U)
+#define GOLDEN_FLUSH_SPIN_US (10U)         ///< Virtual time of one flush wait spin, as in yeti-display-host.
+#define GOLDEN_FLUSH_SPINS_MAX ((LCD_BURST_FRAMES + 2U) * NUM_PIX_ROW_PER_COL_BYTES * 2U)
+#define GOLDEN_FNV_OFFSET (0xCBF29CE484222325ULL)
+#define GOLDEN_FNV_PRIME (0x00000100000001B3ULL)
+#define GOLDEN_LINE_MAX (256U)
+#define GOLDEN_GLYPHS (255U)               ///< Character codes.
+
+/**
+ * @brief Scenario step.
+ */
+typedef enum
+{
+    GOLDEN_STEP_END = 0,
+    GOLDEN_STEP_LINE,   ///< lcd_put_line() of a full WRITE_LINE payload.
+    GOLDEN_STEP_CLEAR,  ///< lcd_clear().
+    GOLDEN_STEP_QR,     ///< lcd_put_qr_code() at the origin, as app_process_action() does.
+    GOLDEN_STEP_FLUSH,  ///< lcd_flush_async() until every changed page is on the panel.
+    GOLDEN_STEP_INVERT, ///< lcd_invert() of the first pages, full width.
+#if LCD_GRAY_ENABLE == true
+    GOLDEN_STEP_GRAY,   ///< lcd_put_gray_data() of the four levels over the first pages, full width.
+#endif /* LCD_GRAY_ENABLE */
+} golden_step_e;
+
+typedef struct
+{
+    golden_step_e step;
+    uint8_t       arg;                ///< Line, QR version, or pages to invert or gray.
+    uint8_t       text[LCD_CHAR_NUM]; ///< Line payload: icon, format byte, text, icon.
+} golden_step_t;
+
+typedef struct
+{
+    char              name[GOLDEN_NAME_MAX];
+    const lcd_line_t *layout;
+    golden_step_t     steps[GOLDEN_STEPS_MAX];
+} golden_scenario_t;
+
+/**
+ * @brief What a scenario produced, and the golden values it is checked against.
+ */
+typedef struct
+{
+    bool     done;          ///< The scenario ran to the end.
+    uint64_t line_buf_hash; ///< FNV-1a of the line buffer pages, then of the gray plane when it holds gray pixels.
+    uint64_t panel_hash;    ///< FNV-1a of the emulated panel image.
+    uint32_t cycles;        ///< Estimated M33 cycles of the render steps, flushes excluded.
+    uint32_t spi_frames;    ///< 9-bit frames sent by the flushes.
+    uint32_t spi_refused;   ///< Transfers SPIDRV would refuse as busy, the bring-up included.
+} golden_result_t;
+
+typedef struct
+{
+    bool            found;
+    golden_result_t budget; ///< Hashes to match, cycles and frames not to exceed.
+} golden_entry_t;
+
+typedef struct
+{
+    const char *golden;     ///< Golden table path.
+    const char *scenario;   ///< Run only this scenario.
+    bool        update;     ///< Print a new golden table instead of checking.
+    bool        list;       ///< Print the scenario names.
+    bool        no_cycles;  ///< Report the cycles without checking them against the budgets.
+    uint32_t    jobs;       ///< Scenarios running at the same time.
+    uint32_t    reps;       ///< Timed repetitions.
+    double      m33_per_ns; ///< Host ns to M33 cycles scale, 0 to calibrate.
+} golden_options_t;
+
+// app.c layouts, the arrays there are static.
+static const lcd_line_t layout_full_height[LCD_LINE_NUM] = {
+    {0, LCD_LINE_PIXEL_HEIGHT}, {0, LCD_LINE_PIXEL_HEIGHT}, {0, LCD_LINE_PIXEL_HEIGHT}, {0, LCD_LINE_PIXEL_HEIGHT}};
+static const lcd_line_t layout_split[LCD_LINE_NUM] = {
+    {0, LCD_LINE_PIXEL_HEIGHT}, {4, LCD_LINE_PIXEL_HEIGHT}, {1, LCD_LINE_PIXEL_HEIGHT}, {3, LCD_LINE_PIXEL_HEIGHT}};
+
+static const struct
+{
+    const char *name;
+    uint8_t     state;
+} formats[] = {
+    {"default", 0},
+    {"left", LINE_ALIGNMENT_LEFT},
+    {"right", LINE_ALIGNMENT_RIGHT},
+    {"center", LINE_ALIGNMENT_CENTER},
+    {"default_inv", LINE_INVERTED},
+    {"left_inv", LINE_ALIGNMENT_LEFT | LINE_INVERTED},
+    {"right_inv", LINE_ALIGNMENT_RIGHT | LINE_INVERTED},
+    {"center_inv", LINE_ALIGNMENT_CENTER | LINE_INVERTED},
+};
+
+static golden_options_t options = {.golden     = NULL,
+                                   .scenario   = NULL,
+                                   .update     = false,
+                                   .list       = false,
+                                   .jobs       = 0,
+                                   .reps       = GOLDEN_REPS_DEFAULT,
+                                   .m33_per_ns = 0};
+
+static golden_scenario_t scenarios[GOLDEN_SCENARIOS_MAX];
+static uint32_t          scenario_count = 0;
+static golden_entry_t    golden[GOLDEN_SCENARIOS_MAX];
+static uc1601s_t         panel;
+static base_driver       spi_port;
+static lcd_t             lcd;
+
+/************************************************** SCENARIO TABLE ***************************************************/
+
+static golden_step_t golden_line(uint8_t line, uint8_t format, uint8_t left, const char *text, uint8_t right)
+{
+    golden_step_t step = {.step = GOLDEN_STEP_LINE, .arg = line};
+
+    memset(step.text, ' ', sizeof(step.text));
+    memcpy(&step.text[PRINT_LINE_CHARS], text, strnlen(text, GOLDEN_TEXT_CHARS));
+    step.text[LEFT_ALIGNMENT_BYTE]  = left;
+    step.text[FORMAT_BYTE_CHAR]     = format;
+    step.text[RIGHT_ALIGNMENT_BYTE] = right;
+
+    return step;
+}
+
+static golden_scenario_t *golden_add(const lcd_line_t *layout, const char *name)
+{
+    golden_scenario_t *scenario = &scenarios[scenario_count++];
+
+    snprintf(scenario->name, sizeof(scenario->name), "%s", name);
+    scenario->layout = layout;
+
+    return scenario;
+}
+
+/**
+ * @brief Every scenario starts from lcd_init(). The QR scenarios are the first app_process_action() pass, the others
+ * flush the boot screen first so the SPI budget also covers partial updates.
+ */
+static void golden_build_scenarios(void)
+{
+    static const golden_step_t flush = {.step = GOLDEN_STEP_FLUSH};
+    golden_scenario_t         *scenario;
+    char                       name[GOLDEN_NAME_MAX];
+
+    scenario           = golden_add(layout_full_height, "boot");
+    scenario->steps[0] = flush;
+
+    for(uint8_t version = 3; version <= 7; version++)
+    {
+        snprintf(name, sizeof(name), "qr_v%u", version);
+        scenario           = golden_add(layout_full_height, name);
+        scenario->steps[0] = (golden_step_t){.step = GOLDEN_STEP_CLEAR};
+        scenario->steps[1] = (golden_step_t){.step = GOLDEN_STEP_QR, .arg = version};
+        scenario->steps[2] = flush;
+    }
+
+    scenario           = golden_add(layout_full_height, "qr_then_line");
+    scenario->steps[0] = (golden_step_t){.step = GOLDEN_STEP_QR, .arg = 4};
+    scenario->steps[1] = flush;
+    scenario->steps[2] = golden_line(3, LINE_ALIGNMENT_RIGHT, ' ', "SCAN ME", ' ');
+    scenario->steps[3] = flush;
+
+    scenario           = golden_add(layout_full_height, "full_screen");
+    scenario->steps[0] = flush;
+    scenario->steps[1] = golden_line(0, LINE_ALIGNMENT_CENTER | LINE_INVERTED, ' ', "MAIN MENU", ' ');
+    scenario->steps[2] = golden_line(1, LINE_ALIGNMENT_LEFT, ' ', "DOOR CLOSING", ' ');
+    scenario->steps[3] = golden_line(2, LINE_ALIGNMENT_LEFT, ' ', "LIGHT ON", ' ');
+    scenario->steps[4] = golden_line(3, LINE_ALIGNMENT_RIGHT, ' ', "BACK", ' ');
+    scenario->steps[5] = flush;
+
+    scenario           = golden_add(layout_full_height, "clear_after_text");
+    scenario->steps[0] = flush;
+    scenario->steps[1] = golden_line(1, LINE_ALIGNMENT_CENTER, ' ', "DOOR OPEN", ' ');
+    scenario->steps[2] = flush;
+    scenario->steps[3] = (golden_step_t){.step = GOLDEN_STEP_CLEAR};
+    scenario->steps[4] = flush;
+
+    scenario           = golden_add(layout_full_height, "same_text_twice");
+    scenario->steps[0] = flush;
+    scenario->steps[1] = golden_line(1, LINE_ALIGNMENT_CENTER, ' ', "DOOR OPEN", ' ');
+    scenario->steps[2] = flush;
+    scenario->steps[3] = scenario->steps[1];
+    scenario->steps[4] = flush;
+
+    scenario           = golden_add(layout_full_height, "shorter_text");
+    scenario->steps[0] = flush;
+    scenario->steps[1] = golden_line(2, 0, ' ', "LIGHT ON  TIMER", ' ');
+    scenario->steps[2] = flush;
+    scenario->steps[3] = golden_line(2, 0, ' ', "OK", ' ');
+    scenario->steps[4] = flush;
+
+    // A countdown only changes one glyph: only its columns go on the wire.
+    scenario           = golden_add(layout_full_height, "one_glyph_changed");
+    scenario->steps[0] = flush;
+    scenario->steps[1] = golden_line(1, 0, ' ', "CLOSING IN 10", ' ');
+    scenario->steps[2] = flush;
+    scenario->steps[3] = golden_line(1, 0, ' ', "CLOSING IN 19", ' ');
+    scenario->steps[4] = flush;
+
+    // The same countdown on the other formats: the changed glyph is drawn in place, the width change moves the text.
+    static const struct
+    {
+        const char *name;
+        uint8_t     state;
+        uint8_t     icon;
+        const char *to;
+    } updates[] = {
+        {"update_center", LINE_ALIGNMENT_CENTER, ' ', "CLOSING IN 19"},
+        {"update_center_width", LINE_ALIGNMENT_CENTER, ' ', "CLOSING IN 9"},
+        {"update_right", LINE_ALIGNMENT_RIGHT, ' ', "CLOSING IN 19"},
+        {"update_right_width", LINE_ALIGNMENT_RIGHT, ' ', "CLOSING IN 9"},
+        {"update_inverted", LINE_ALIGNMENT_CENTER | LINE_INVERTED, ' ', "CLOSING IN 19"},
+        {"update_blinking", LINE_BLINKED, 0x91, "CLOSING IN 19"},
+    };
+    for(uint8_t update = 0; update < sizeof(updates) / sizeof(updates[0]); update++)
+    {
+        scenario           = golden_add(layout_full_height, updates[update].name);
+        scenario->steps[0] = flush;
+        scenario->steps[1] = golden_line(1, updates[update].state, updates[update].icon, "CLOSING IN 10", ' ');
+        scenario->steps[2] = flush;
+        scenario->steps[3] = golden_line(1, updates[update].state, updates[update].icon, updates[update].to, ' ');
+        scenario->steps[4] = flush;
+    }
+
+    // A full screen alert is inverted by the controller, a local one goes through the frame buffer.
+    scenario           = golden_add(layout_full_height, "alert_invert");
+    scenario->steps[0] = flush;
+    scenario->steps[1] = golden_line(1, LINE_ALIGNMENT_CENTER, ' ', "SYSTEM FAULT", ' ');
+    scenario->steps[2] = flush;
+    scenario->steps[3] = (golden_step_t){.step = GOLDEN_STEP_INVERT, .arg = NUM_PIX_ROW_PER_COL_BYTES};
+    scenario->steps[4] = flush;
+
+    scenario           = golden_add(layout_full_height, "alert_invert_local");
+    scenario->steps[0] = flush;
+    scenario->steps[1] = golden_line(1, LINE_ALIGNMENT_CENTER, ' ', "SYSTEM FAULT", ' ');
+    scenario->steps[2] = flush;
+    scenario->steps[3] = (golden_step_t){.step = GOLDEN_STEP_INVERT, .arg = 2};
+    scenario->steps[4] = flush;
+
+#if LCD_GRAY_ENABLE == true
+    // Text is black and white: the line clears the gray levels of its rows, the pages below keep them.
+    scenario           = golden_add(layout_full_height, "gray_then_line");
+    scenario->steps[0] = (golden_step_t){.step = GOLDEN_STEP_GRAY, .arg = NUM_PIX_ROW_PER_COL_BYTES};
+    scenario->steps[1] = flush;
+    scenario->steps[2] = golden_line(1, LINE_ALIGNMENT_CENTER, ' ', "DOOR OPEN", ' ');
+    scenario->steps[3] = flush;
+#endif /* LCD_GRAY_ENABLE */
+
+    for(uint8_t line = 0; line < LCD_LINE_NUM; line++)
+    {
+        for(uint8_t format = 0; format < sizeof(formats) / sizeof(formats[0]); format++)
+        {
+            snprintf(name, sizeof(name), "line%u_%s", line, formats[format].name);
+            scenario           = golden_add(layout_full_height, name);
+            scenario->steps[0] = flush;
+            scenario->steps[1] = golden_line(line, formats[format].state, ' ', "DOOR CLOSING", ' ');
+            scenario->steps[2] = flush;
+        }
+    }
+
+    // Line 3 of the split layout ends below the panel: its rows past the last page are clipped.
+    for(uint8_t line = 0; line < (LCD_LINE_NUM - 1U); line++)
+    {
+        for(uint8_t format = 0; format < sizeof(formats) / sizeof(formats[0]); format += 7U)
+        {
+            snprintf(name, sizeof(name), "split_line%u_%s", line, formats[format].name);
+            scenario           = golden_add(layout_split, name);
+            scenario->steps[0] = flush;
+            scenario->steps[1] = golden_line(line, formats[format].state, ' ', "DOOR CLOSING", ' ');
+            scenario->steps[2] = flush;
+        }
+    }
+
+    // Every glyph of the font, in runs of a line. Text glyphs and icons run apart: icons also take the alignment bytes.
+    for(uint16_t glyph = ' '; glyph < GOLDEN_GLYPHS;)
+    {
+        char    text[GOLDEN_TEXT_CHARS + 1U] = {0};
+        uint8_t chars                        = 0;
+        uint8_t first                        = (uint8_t)glyph;
+        bool    icons                        = (glyph > LAST_ASCII_CHAR_DEF);
+
+        for(; (glyph < GOLDEN_GLYPHS) && (chars < GOLDEN_TEXT_CHARS) && (icons == (glyph > LAST_ASCII_CHAR_DEF));
+            glyph++)
+        {
+            if(NULL != font_glyph((uint8_t)glyph))
+            {
+                text[chars++] = (char)glyph;
+            }
+        }
+        if(0U == chars)
+        {
+            continue;
+        }
+
+        uint8_t border = icons ? (uint8_t)text[0] : ' ';
+
+        snprintf(name, sizeof(name), "%s_%02x", icons ? "icons" : "glyphs", first);
+        scenario           = golden_add(layout_full_height, name);
+        scenario->steps[0] = flush;
+        scenario->steps[1] = golden_line(1, 0, border, text, border);
+        scenario->steps[2] = flush;
+    }
+}
+
+/************************************************** RUN A SCENARIO ***************************************************/
+
+static uint64_t golden_fnv(uint64_t hash, const uint8_t *data, size_t size)
+{
+    for(size_t i = 0; i < size; i++)
+    {
+        hash = (hash ^ data[i]) * GOLDEN_FNV_PRIME;
+    }
+    return hash;
+}
+
+#if LCD_GRAY_ENABLE == true
+// The panel image is the frame of one sub-frame: the gray levels are checked through the gray plane.
+static bool golden_gray(const lcd_t *self)
+{
+    for(size_t i = 0; i < sizeof(self->gray_buf); i++)
+    {
+        if(0U != (&self->gray_buf[0][0])[i])
+        {
+            return true;
+        }
+    }
+    return false;
+}
+#endif /* LCD_GRAY_ENABLE */
+
+static void golden_flush_done(lcd_t *self, void *arg)
+{
+    (void)self;
+    *(volatile bool *)arg = true;
+}
+
+// lcd_flush_async() sends every changed page, as app_process_action() starts it. The virtual clock moves until the
+// SPI completion of the last page came in.
+static void golden_flush(void)
+{
+    volatile bool done  = false;
+    uint32_t      spins = 0;
+
+    if(lcd_flush_async(&lcd, golden_flush_done, (void *)&done))
+    {
+        while(!done && (++spins < GOLDEN_FLUSH_SPINS_MAX))
+        {
+            host_irq_advance(GOLDEN_FLUSH_SPIN_US);
+        }
+    }
+}
+
+// Blinking glyphs would flip pixels between the hashes and the timed runs: the timer is stopped before it can fire.
+static void golden_stop_blinking(void)
+{
+    task_worker(&lcd, false);
+    for(uint8_t line = 0; line < LCD_LINE_NUM; line++)
+    {
+        blink_task_remove(&lcd, line);
+    }
+}
+
+static void golden_render(const golden_step_t *step)
+{
+    switch(step->step)
+    {
+        case GOLDEN_STEP_LINE:
+            lcd_put_line(&lcd, step->text, LCD_CHAR_NUM, step->arg, ENGLISH);
+            break;
+        case GOLDEN_STEP_CLEAR:
+            lcd_clear(&lcd);
+            break;
+        case GOLDEN_STEP_QR:
+            lcd_put_qr_code(&lcd, step->arg, 0, 0, 0, 0);
+            break;
+        case GOLDEN_STEP_INVERT:
+            lcd_invert(&lcd, &(lcd_area_t){.page = 0, .pages = step->arg, .col = 0, .cols = NUM_PIX_COL_PER_ROW_BYTES});
+            break;
+#if LCD_GRAY_ENABLE == true
+        case GOLDEN_STEP_GRAY:
+            for(uint8_t page = 0; page < step->arg; page++)
+            {
+                for(uint8_t col = 0; col < NUM_PIX_COL_PER_ROW_BYTES; col++)
+                {
+                    lcd_put_gray_data(&lcd, 0xF0, 0xCC, page, col);
+                }
+            }
+            break;
+#endif /* LCD_GRAY_ENABLE */
+        default:
+            break;
+    }
+}
+
+/**
+ * @brief Runs a scenario once for the pixels and the SPI traffic, then times its render steps from the same starting
+ * state. Only called in a child process: lcd.c state is never reset.
+ */
+static void golden_run(const golden_scenario_t *scenario, golden_result_t *result)
+{
+    static uint8_t  line_buf_start[NUM_PIX_ROW_PER_COL_BYTES][NUM_PIX_COL_PER_ROW_BYTES];
+    static uint8_t  cached_str_start[LCD_LINE_NUM][LCD_CHAR_NUM];
+    uint8_t         image[UC1601S_PANEL_PAGES][UC1601S_PANEL_COLUMNS];
+    uint64_t        best_ns = 0;
+
+    host_irq_init_virtual();
+    uc1601s_init(&panel, HOST_SPI_BITRATE, NULL, NULL);
+    host_spi_set_sink(uc1601s_write, &panel);
+    lcd_spi_init(&spi_port);
+    lcd_init(&lcd, &spi_port, scenario->layout);
+    while(!lcd_is_ready(&lcd))
+    {
+        sl_sleeptimer_delay_millisecond(1);
+    }
+    result->spi_refused = host_spi_get_stats().busy_refused;
+    host_spi_reset_stats();
+
+    memcpy(line_buf_start, lcd.line_buf, sizeof(lcd.line_buf));
+    memcpy(cached_str_start, lcd.cached_str, sizeof(lcd.cached_str));
+
+    for(const golden_step_t *step = scenario->steps; GOLDEN_STEP_END != step->step; step++)
+    {
+        if(GOLDEN_STEP_FLUSH == step->step)
+        {
+            golden_flush();
+        }
+        golden_render(step);
+        golden_stop_blinking();
+    }
+
+    result->line_buf_hash = golden_fnv(GOLDEN_FNV_OFFSET, &lcd.line_buf[0][0], sizeof(lcd.line_buf));
+#if LCD_GRAY_ENABLE == true
+    if(golden_gray(&lcd))
+    {
+        result->line_buf_hash = golden_fnv(result->line_buf_hash, &lcd.gray_buf[0][0], sizeof(lcd.gray_buf));
+    }
+#endif /* LCD_GRAY_ENABLE */
+    uc1601s_get_image(&panel, image);
+    result->panel_hash = golden_fnv(GOLDEN_FNV_OFFSET, &image[0][0], sizeof(image));
+    result->spi_frames = host_spi_get_stats().frames;
+    result->spi_refused += host_spi_get_stats().busy_refused;
+
+    // Flushes do not change what the render steps do, they are left out of the timed repetitions.
+    for(uint32_t rep = 0; rep < options.reps; rep++)
+    {
+        uint64_t elapsed_ns = 0;
+
+        memcpy(lcd.line_buf, line_buf_start, sizeof(lcd.line_buf));
+        memcpy(lcd.cached_str, cached_str_start, sizeof(lcd.cached_str));
+        for(const golden_step_t *step = scenario->steps; GOLDEN_STEP_END != step->step; step++)
+        {
+            uint64_t start = bench_clock_now_ns();
+
+            golden_render(step);
+            elapsed_ns += bench_clock_now_ns() - start;
+            golden_stop_blinking();
+        }
+        best_ns = ((0U == rep) || (elapsed_ns < best_ns)) ? elapsed_ns : best_ns;
+    }
+    result->cycles = (uint32_t)((double)best_ns * options.m33_per_ns);
+    result->done   = true;
+}
+
+/**
+ * @brief Every scenario runs in its own child process, so lcd.c starts from its reset state, up to options.jobs at a
+ * time. Results come back through shared memory.
+ */
+static bool golden_run_all(golden_result_t *results, const bool *selected)
+{
+    uint32_t running = 0;
+    bool     ok      = true;
+
+    for(uint32_t i = 0; (i < scenario_count) || (0U != running);)
+    {
+        if((i < scenario_count) && (running < options.jobs))
+        {
+            if(!selected[i])
+            {
+                i++;
+                continue;
+            }
+
+            pid_t pid = fork();
+
+            if(0 == pid)
+            {
+                golden_run(&scenarios[i], &results[i]);
+                _exit(EXIT_SUCCESS);
+            }
+            if(pid < 0)
+            {
+                fprintf(stderr, "lcd-golden: fork failed: %s\n", strerror(errno));
+                return false;
+            }
+            running++;
+            i++;
+            continue;
+        }
+
+        int status;
+
+        if(wait(&status) > 0)
+        {
+            running--;
+            ok = ok && WIFEXITED(status) && (EXIT_SUCCESS == WEXITSTATUS(status));
+        }
+    }
+
+    return ok;
+}
+
+/*************************************************** GOLDEN TABLE ****************************************************/
+
+static int32_t golden_find(const char *name)
+{
+    for(uint32_t i = 0; i < scenario_count; i++)
+    {
+        if(0 == strcmp(scenarios[i].name, name))
+        {
+            return (int32_t)i;
+        }
+    }
+    return -1;
+}
+
+static bool golden_load(const char *path)
+{
+    FILE *file = fopen(path, "r");
+    char  line[GOLDEN_LINE_MAX];
+    bool  ok   = true;
+
+    if(NULL == file)
+    {
+        fprintf(stderr, "lcd-golden: cannot open %s: %s\n", path, strerror(errno));
+        return false;
+    }
+
+    while(NULL != fgets(line, sizeof(line), file))
+    {
+        char            name[GOLDEN_NAME_MAX];
+        golden_result_t budget = {0};
+
+        if(('#' == line[0]) || ('\n' == line[0]))
+        {
+            continue;
+        }
+        if(5 != sscanf(line, "%31s %" SCNx64 " %" SCNx64 " %" SCNu32 " %" SCNu32, name, &budget.line_buf_hash,
+                       &budget.panel_hash, &budget.cycles, &budget.spi_frames))
+        {
+            fprintf(stderr, "lcd-golden: %s: cannot parse \"%s\"\n", path, strtok(line, "\n"));
+            ok = false;
+            continue;
+        }
+
+        int32_t index = golden_find(name);
+
+        // The gray scenarios are only built with the grayscale mode, the table keeps them for those builds
+        if((index < 0) && (LCD_GRAY_ENABLE != true) && (0 == strncmp(name, "gray_", strlen("gray_"))))
+        {
+            continue;
+        }
+        if(index < 0)
+        {
+            fprintf(stderr, "lcd-golden: %s: scenario %s does not exist\n", path, name);
+            ok = false;
+            continue;
+        }
+        golden[index].found  = true;
+        golden[index].budget = budget;
+    }
+    fclose(file);
+
+    return ok;
+}
+
+static void golden_print_table(const golden_result_t *results)
+{
+    printf("# Golden frames of lcd-golden. Regenerate with: lcd-golden --update > golden.txt\n");
+    printf("# from a -DLCD_GRAY=ON build, so the gray scenarios stay in the table.\n");
+    printf("# Hashes are FNV-1a 64 of the lcd.c line buffer pages, then of the gray plane once it holds gray\n");
+    printf("# pixels, and of the emulated panel image. Cycles are the estimated M33 cost of the render steps\n");
+    printf("# plus %u%% headroom, frames the 9-bit SPI frames of the flushes.\n", GOLDEN_CYCLE_HEADROOM_PCT);
+    printf("# %-22s %-16s %-16s %8s %8s\n", "scenario", "line_buf", "panel", "cycles", "frames");
+    for(uint32_t i = 0; i < scenario_count; i++)
+    {
+        uint32_t budget = (results[i].cycles * (100U + GOLDEN_CYCLE_HEADROOM_PCT)) / 100U;
+
+        budget = ((budget / GOLDEN_CYCLE_ROUNDING) + 1U) * GOLDEN_CYCLE_ROUNDING;
+        printf("%-24s %016" PRIx64 " %016" PRIx64 " %8" PRIu32 " %8" PRIu32 "\n", scenarios[i].name,
+               results[i].line_buf_hash, results[i].panel_hash, budget, results[i].spi_frames);
+    }
+}
+
+static bool golden_check(uint32_t index, const golden_result_t *result)
+{
+    const golden_result_t *budget = &golden[index].budget;
+    const char            *name   = scenarios[index].name;
+    bool                   ok     = true;
+
+    if(!result->done)
+    {
+        printf("FAIL %-24s did not complete\n", name);
+        return false;
+    }
+    if(!golden[index].found)
+    {
+        printf("FAIL %-24s has no golden entry\n", name);
+        return false;
+    }
+    if(result->line_buf_hash != budget->line_buf_hash)
+    {
+        printf("FAIL %-24s line_buf hash %016" PRIx64 ", golden %016" PRIx64 "\n", name, result->line_buf_hash,
+               budget->line_buf_hash);
+        ok = false;
+    }
+    if(result->panel_hash != budget->panel_hash)
+    {
+        printf("FAIL %-24s panel hash %016" PRIx64 ", golden %016" PRIx64 "\n", name, result->panel_hash,
+               budget->panel_hash);
+        ok = false;
+    }
+    if(!options.no_cycles && (result->cycles > budget->cycles))
+    {
+        printf("FAIL %-24s %" PRIu32 " cycles, budget %" PRIu32 "\n", name, result->cycles, budget->cycles);
+        ok = false;
+    }
+    if(result->spi_frames > budget->spi_frames)
+    {
+        printf("FAIL %-24s %" PRIu32 " SPI frames, budget %" PRIu32 "\n", name, result->spi_frames,
+               budget->spi_frames);
+        ok = false;
+    }
+    if(0U != result->spi_refused)
+    {
+        printf("FAIL %-24s %" PRIu32 " SPI transfers refused busy\n", name, result->spi_refused);
+        ok = false;
+    }
+    if(ok)
+    {
+        printf("ok   %-24s %8" PRIu32 " / %8" PRIu32 " cycles %6" PRIu32 " / %6" PRIu32 " frames\n", name,
+               result->cycles, budget->cycles, result->spi_frames, budget->spi_frames);
+    }
+
+    return ok;
+}
+
+/******************************************************* MAIN ********************************************************/
+
+static void golden_usage(const char *name)
+{
+    fprintf(stderr,
+            "usage: %s [--golden FILE] [--scenario NAME] [--update] [--list] [--jobs N] [--reps N] [--scale X]\n"
+            "       [--no-cycles]\n"
+            "  Renders every LCD scenario on the host and checks the line buffer and panel hashes, the estimated\n"
+            "  M33 cycles and the SPI frames against the golden table. --update prints a new table from this run,\n"
+            "  --jobs sets the scenarios run at the same time (default: every core), --reps the timed repetitions\n"
+            "  (default %u), --scale M33 cycles per host ns instead of calibrating it. --no-cycles reports the\n"
+            "  cycles without checking them: they are host time, and depend on the machine and its load.\n",
+            name, GOLDEN_REPS_DEFAULT);
+}
+
+static int golden_parse_options(int argc, char **argv)
+{
+    static const struct option long_options[] = {
+        {"golden", required_argument, NULL, 'g'},
+        {"scenario", required_argument, NULL, 'n'},
+        {"update", no_argument, NULL, 'u'},
+        {"list", no_argument, NULL, 'l'},
+        {"jobs", required_argument, NULL, 'j'},
+        {"reps", required_argument, NULL, 'r'},
+        {"scale", required_argument, NULL, 's'},
+        {"no-cycles", no_argument, NULL, 'c'},
+        {"help", no_argument, NULL, 'h'},
+        {NULL, 0, NULL, 0},
+    };
+    int opt;
+
+    while(-1 != (opt = getopt_long(argc, argv, "g:n:ulj:r:s:ch", long_options, NULL)))
+    {
+        switch(opt)
+        {
+            case 'g':
+                options.golden = optarg;
+                break;
+            case 'n':
+                options.scenario = optarg;
+                break;
+            case 'u':
+                options.update = true;
+                break;
+            case 'l':
+                options.list = true;
+                break;
+            case 'j':
+                options.jobs = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            case 'r':
+                options.reps = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            case 's':
+                options.m33_per_ns = strtod(optarg, NULL);
+                break;
+            case 'c':
+                options.no_cycles = true;
+                break;
+            default:
+                golden_usage(argv[0]);
+                return ('h' == opt) ? 0 : 1;
+        }
+    }
+    if(!options.update && !options.list && (NULL == options.golden))
+    {
+        golden_usage(argv[0]);
+        return 1;
+    }
+
+    return -1;
+}
+
+int main(int argc, char **argv)
+{
+    int              exit_code = golden_parse_options(argc, argv);
+    golden_result_t *results;
+    bool             selected[GOLDEN_SCENARIOS_MAX] = {0};
+    bool             ok;
+
+    if(exit_code >= 0)
+    {
+        return exit_code;
+    }
+
+    golden_build_scenarios();
+    if(options.list)
+    {
+        for(uint32_t i = 0; i < scenario_count; i++)
+        {
+            printf("%s\n", scenarios[i].name);
+        }
+        return EXIT_SUCCESS;
+    }
+    if(!options.update && !golden_load(options.golden))
+    {
+        return EXIT_FAILURE;
+    }
+    for(uint32_t i = 0; i < scenario_count; i++)
+    {
+        selected[i] = (NULL == options.scenario) || (0 == strcmp(options.scenario, scenarios[i].name));
+    }
+    if((NULL != options.scenario) && (golden_find(options.scenario) < 0))
+    {
+        fprintf(stderr, "lcd-golden: scenario %s does not exist\n", options.scenario);
+        return EXIT_FAILURE;
+    }
+
+    // Calibrated once here, before any host fake starts a thread: the children inherit it.
+    if(0 == options.m33_per_ns)
+    {
+        options.m33_per_ns = bench_clock_m33_per_ns();
+    }
+    if(0U == options.jobs)
+    {
+        long cores   = sysconf(_SC_NPROCESSORS_ONLN);
+        options.jobs = (cores > 0) ? (uint32_t)cores : 1U;
+    }
+    options.reps = (0U == options.reps) ? 1U : options.reps;
+
+    results = mmap(NULL, sizeof(golden_result_t) * GOLDEN_SCENARIOS_MAX, PROT_READ | PROT_WRITE,
+                   MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if(MAP_FAILED == results)
+    {
+        fprintf(stderr, "lcd-golden: mmap failed: %s\n", strerror(errno));
+        return EXIT_FAILURE;
+    }
+    memset(results, 0, sizeof(golden_result_t) * GOLDEN_SCENARIOS_MAX);
+
+    ok = golden_run_all(results, selected);
+
+    if(options.update)
+    {
+        golden_print_table(results);
+        return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    for(uint32_t i = 0; i < scenario_count; i++)
+    {
+        if(selected[i])
+        {
+            ok = golden_check(i, &results[i]) && ok;
+        }
+    }
+
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
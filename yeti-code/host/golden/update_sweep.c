@@ -0,0 +1,305 @@
+/** @file update_sweep.c
+ *
+ * @brief Random update sweep: lcd_put_line() updates drawn in place must give the pixels of a whole line render.
+ *
+ * @author Rene Delgado
+ *
+ * @copyright 2023 The Chamberlain Group, LLC. All rights reserved. All
+ * information within this file and associated files, including all
+ * information and files transmitted with this file are CONFIDENTIAL
+ * and the proprietary property of The Chamberlain Group, LLC.
+ *
+ * In using the Licensed Software, Company shall not use with, combine, or
+ * incorporate any viral open source software with or into any of the Licensed
+ * Software in a manner that would require any portion of the Licensed software to
+ * be (i) disclosed or distributed in source code form; (ii) licensed for the
+ * purpose of making derivative works; or (iii) distributable or redistributable
+ * at no charge.
+ */
+
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "host_irq.h"
+#include "lcd_spi.h"
+
+// stuff_changed() and the line state are static: lcd.c is built into this translation unit as is.
+#include "source/hal/src/lcd.c"
+
+#define SWEEP_STEPS_DEFAULT (400000U)  ///< lcd_put_line() calls.
+#define SWEEP_SEED_DEFAULT (3U)        ///< xorshift32 seed, not 0.
+#define SWEEP_LAYOUT_STEPS (50000U)    ///< Steps between two layout changes.
+#define SWEEP_CLEAR_STEPS (20000U)     ///< Steps between two lcd_clear().
+#define SWEEP_FAILS_SHOWN (5U)         ///< Mismatches printed, the others are only counted.
+#define SWEEP_TEXT_CHARS (RIGHT_ALIGNMENT_BYTE - PRINT_LINE_CHARS)
+#define SWEEP_BLINKING_ICON (0x91U)    ///< The blinking glyph of the font.
+
+/**
+ * @brief Command line options.
+ */
+typedef struct
+{
+    uint32_t steps; ///< lcd_put_line() calls.
+    uint32_t seed;  ///< Random generator seed.
+} sweep_options_t;
+
+/**
+ * @brief Sweep counters.
+ */
+typedef struct
+{
+    uint32_t updates;     ///< Calls that changed the text of a line.
+    uint32_t in_place;    ///< Updates drawn by stuff_changed().
+    uint32_t mismatches;  ///< Updates whose pixels differ from the whole render.
+} sweep_result_t;
+
+// Digits and words, as a countdown or a status update changes them, then icons the alignment bytes also take.
+static const uint8_t text_pool[]  = " 0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcxyz-./!";
+static const uint8_t icon_pool[]  = "\x80\x81\x82\x83\x88\x89\x8A\x8B\x90\xA3\xA4\xA5\xA6";
+static const uint8_t formats[]    = {0,
+                                     LINE_ALIGNMENT_LEFT,
+                                     LINE_ALIGNMENT_RIGHT,
+                                     LINE_ALIGNMENT_CENTER,
+                                     LINE_INVERTED,
+                                     LINE_ALIGNMENT_LEFT | LINE_INVERTED,
+                                     LINE_ALIGNMENT_RIGHT | LINE_INVERTED,
+                                     LINE_ALIGNMENT_CENTER | LINE_INVERTED};
+
+static sweep_options_t options = {.steps = SWEEP_STEPS_DEFAULT, .seed = SWEEP_SEED_DEFAULT};
+static uint32_t        rng     = SWEEP_SEED_DEFAULT;
+static base_driver     spi_port;
+static lcd_t           updated;   ///< Takes the updates as app.c sends them.
+static lcd_t           reference; ///< Renders every line whole.
+static lcd_t           probe;     ///< Copy of updated, tells whether an update is drawn in place.
+
+/*************************************************** TRAFFIC ********************************************************/
+
+// xorshift32: a seed always replays the same updates.
+static uint32_t sweep_random(uint32_t range)
+{
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng % range;
+}
+
+static uint8_t sweep_text_char(void)
+{
+    return (0U == sweep_random(6)) ? icon_pool[sweep_random(sizeof(icon_pool) - 1U)]
+                                   : text_pool[sweep_random(sizeof(text_pool) - 1U)];
+}
+
+static uint8_t sweep_icon(void)
+{
+    if(0U == sweep_random(200))
+    {
+        return SWEEP_BLINKING_ICON;
+    }
+    return (0U != sweep_random(3)) ? ' ' : icon_pool[sweep_random(sizeof(icon_pool) - 1U)];
+}
+
+// One time in ten a new line, one time in ten another format, otherwise a few characters change.
+static void sweep_next_text(uint8_t *text)
+{
+    uint32_t mode = sweep_random(10);
+
+    if(0U == mode)
+    {
+        for(uint8_t i = PRINT_LINE_CHARS; i < RIGHT_ALIGNMENT_BYTE; i++)
+        {
+            text[i] = sweep_text_char();
+        }
+        text[LEFT_ALIGNMENT_BYTE]  = sweep_icon();
+        text[RIGHT_ALIGNMENT_BYTE] = sweep_icon();
+        text[FORMAT_BYTE_CHAR]     = formats[sweep_random(sizeof(formats))];
+        text[FORMAT_BYTE_CHAR] |= (0U == sweep_random(30)) ? LINE_BLINKED : 0U;
+    }
+    else if(1U == mode)
+    {
+        text[FORMAT_BYTE_CHAR] = formats[sweep_random(sizeof(formats))];
+    }
+    else
+    {
+        uint32_t changes = 1U + sweep_random(3);
+
+        for(uint32_t k = 0; k < changes; k++)
+        {
+            text[PRINT_LINE_CHARS + sweep_random(SWEEP_TEXT_CHARS)] =
+                (0U != sweep_random(3)) ? text_pool[1U + sweep_random(10)] : sweep_text_char();
+        }
+        if(0U == sweep_random(8))
+        {
+            text[PRINT_LINE_CHARS + sweep_random(SWEEP_TEXT_CHARS)] = ' ';
+        }
+    }
+}
+
+// Line heights and indents of app.c and the ones around them, rows past the panel included.
+static void sweep_next_layout(uint32_t step)
+{
+    lcd_line_t layout[LCD_LINE_NUM];
+
+    for(uint8_t line = 0; line < LCD_LINE_NUM; line++)
+    {
+        layout[line].upper_indent = (uint8_t)sweep_random(3);
+        layout[line].height       = (0U != (step / SWEEP_LAYOUT_STEPS) % 3U) ? LCD_LINE_PIXEL_HEIGHT
+                                                                              : (uint8_t)(8U + sweep_random(3));
+    }
+    // The lines are drawn again after a layout change, even with the same text
+    lcd_init(&updated, &spi_port, layout);
+    lcd_init(&reference, &spi_port, layout);
+    lcd_clear(&updated);
+    lcd_clear(&reference);
+}
+
+/*************************************************** THE SWEEP ******************************************************/
+
+// The reference forgets the line it shows: the text of the update is rendered whole over the same pixels.
+static void sweep_render_whole(uint8_t line)
+{
+    memcpy(reference.cached_str[line], updated.cached_str[line], LCD_CHAR_NUM);
+    reference.cached_str[line][FORMAT_BYTE_CHAR] ^= 0xFF;
+    reference.line_rendered = 0;
+    lcd_put_line(&reference, updated.cached_str[line], LCD_CHAR_NUM, line, ENGLISH);
+}
+
+static void sweep_run(sweep_result_t *result)
+{
+    uint8_t text[LCD_LINE_NUM][LCD_CHAR_NUM];
+
+    memset(text, ' ', sizeof(text));
+    for(uint32_t step = 0; step < options.steps; step++)
+    {
+        uint8_t  previous[LCD_CHAR_NUM];
+        uint8_t  line = (uint8_t)sweep_random(LCD_LINE_NUM);
+        // A short payload only replaces the first characters of the line, as a short WRITE_LINE would
+        size_t   size = (0U == sweep_random(20)) ? (size_t)(PRINT_LINE_CHARS + sweep_random(SWEEP_TEXT_CHARS + 1U))
+                                                 : LCD_CHAR_NUM;
+
+        if(0U == step % SWEEP_LAYOUT_STEPS)
+        {
+            sweep_next_layout(step);
+        }
+        if(SWEEP_CLEAR_STEPS / 2U == step % SWEEP_CLEAR_STEPS)
+        {
+            lcd_clear(&updated);
+            lcd_clear(&reference);
+        }
+        sweep_next_text(text[line]);
+
+        memcpy(previous, updated.cached_str[line], sizeof(previous));
+        if(strncmp((const char *)previous, (const char *)text[line], size))
+        {
+            result->updates++;
+            if(updated.line_rendered & (1U << line))
+            {
+                uint8_t next[LCD_CHAR_NUM];
+
+                memcpy(next, previous, sizeof(next));
+                memcpy(next, text[line], size);
+                memcpy(&probe, &updated, sizeof(probe));
+                result->in_place += stuff_changed(&probe, line, previous, next) ? 1U : 0U;
+            }
+        }
+        lcd_put_line(&updated, text[line], size, line, ENGLISH);
+        task_worker(&updated, false);
+
+        sweep_render_whole(line);
+        task_worker(&reference, false);
+        if(memcmp(updated.line_buf, reference.line_buf, sizeof(updated.line_buf)) ||
+           memcmp(updated.front_buf, reference.front_buf, sizeof(updated.front_buf)))
+        {
+            if(result->mismatches++ < SWEEP_FAILS_SHOWN)
+            {
+                printf("FAIL step %u line %u: [%.*s] format 0x%02X drawn in place differs from its whole render\n",
+                       step, line, (int)SWEEP_TEXT_CHARS, (const char *)&updated.cached_str[line][PRINT_LINE_CHARS],
+                       updated.cached_str[line][FORMAT_BYTE_CHAR]);
+            }
+            // The next updates are checked from the same pixels again
+            memcpy(updated.line_buf, reference.line_buf, sizeof(updated.line_buf));
+            memcpy(updated.front_buf, reference.front_buf, sizeof(updated.front_buf));
+        }
+    }
+}
+
+/*************************************************** OPTIONS ********************************************************/
+
+static void sweep_usage(const char *name)
+{
+    fprintf(stderr,
+            "usage: %s [--steps N] [--seed N]\n"
+            "  Sends random lcd_put_line() updates, as a countdown or a status line changes, over every format and\n"
+            "  changing layouts, and renders every updated line whole on a second display. Exits with 1 when the\n"
+            "  pixels of an update drawn in place differ from the whole render. Defaults: %u steps, seed %u.\n",
+            name, SWEEP_STEPS_DEFAULT, SWEEP_SEED_DEFAULT);
+}
+
+static int sweep_parse_options(int argc, char **argv)
+{
+    static const struct option long_options[] = {
+        {"steps", required_argument, NULL, 'n'},
+        {"seed", required_argument, NULL, 's'},
+        {"help", no_argument, NULL, 'h'},
+        {NULL, 0, NULL, 0},
+    };
+    int opt;
+
+    while(-1 != (opt = getopt_long(argc, argv, "n:s:h", long_options, NULL)))
+    {
+        switch(opt)
+        {
+            case 'n':
+                options.steps = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            case 's':
+                options.seed = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            default:
+                sweep_usage(argv[0]);
+                return ('h' == opt) ? 0 : 1;
+        }
+    }
+
+    if(0U == options.seed)
+    {
+        sweep_usage(argv[0]);
+        return 1;
+    }
+
+    return -1;
+}
+
+int main(int argc, char **argv)
+{
+    int            exit_code = sweep_parse_options(argc, argv);
+    sweep_result_t result    = {0};
+
+    if(exit_code >= 0)
+    {
+        return exit_code;
+    }
+    rng = options.seed;
+
+    host_irq_init_virtual();
+    lcd_spi_init(&spi_port);
+    // The displays share the SPI bus: the bring-up of one is on the wire before the other starts
+    lcd_init(&updated, &spi_port, NULL);
+    while(!lcd_is_ready(&updated))
+    {
+        sl_sleeptimer_delay_millisecond(1);
+    }
+    lcd_init(&reference, &spi_port, NULL);
+    while(!lcd_is_ready(&reference))
+    {
+        sl_sleeptimer_delay_millisecond(1);
+    }
+
+    sweep_run(&result);
+
+    printf("lcd-update-sweep: %u steps, seed %u\n", options.steps, options.seed);
+    printf("  %u updates, %u drawn in place\n", result.updates, result.in_place);
+    printf("%s: %u of %u updates differ from their whole render\n", (0U == result.mismatches) ? "PASS" : "FAIL",
+           result.mismatches, result.updates);
+    return (0U == result.mismatches) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
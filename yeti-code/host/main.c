@@ -0,0 +1,368 @@
+/** @file main.c
+ *
+ * @brief Entry point of yeti-display-host: runs the unmodified application on Linux on top of the host fakes.
+ *
+ * @author Rene Delgado
+ *
+ * @copyright 2023 The Chamberlain Group, LLC. All rights reserved. All
+ * information within this file and associated files, including all
+ * information and files transmitted with this file are CONFIDENTIAL
+ * and the proprietary property of The Chamberlain Group, LLC.
+ *
+ * In using the Licensed Software, Company shall not use with, combine, or
+ * incorporate any viral open source software with or into any of the Licensed
+ * Software in a manner that would require any portion of the Licensed software to
+ * be (i) disclosed or distributed in source code form; (ii) licensed for the
+ * purpose of making derivative works; or (iii) distributable or redistributable
+ * at no charge.
+ */
+
+#include <getopt.h>
+#include <limits.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "app.h"
+#include "host_board.h"
+#include "host_irq.h"
+#include "host_pty.h"
+#include "host_spi.h"
+#include "host_uart.h"
+#include "uc1601s.h"
+
+#define HOST_MAIN_POLL_US (10000U)         ///< Exit conditions check period.
+#define HOST_MAIN_DRAIN_GRACE_US (100000U) ///< Quiet time after the input is drained before exiting.
+#define HOST_MAIN_LOOP_US (10U)            ///< Default virtual time of one main loop pass.
+#define HOST_MAIN_US_IN_MS (1000ULL)
+#define HOST_MAIN_US_IN_S (1000000ULL)
+#define HOST_MAIN_NS_IN_US (1000ULL)
+
+/**
+ * @brief  Command line options.
+ */
+typedef struct
+{
+    uint32_t    baud;         ///< Powered UART baud rate.
+    uint64_t    run_us;       ///< Run time limit, 0 to run until the input is drained.
+    bool        frame_log;    ///< Print the bus cost of every LCD frame.
+    bool        show;         ///< Print the panel image on exit.
+    bool        virtual_time; ///< Run on the virtual clock.
+    uint32_t    loop_us;      ///< Virtual time of one main loop pass.
+    bool        pty;          ///< Bridge the UARTs to pseudo-terminals instead of stdin/stdout/stderr.
+    const char *pty_link;     ///< Symbolic link to the powered UART terminal, NULL for none.
+} host_main_options_t;
+
+static host_main_options_t   options = {.baud         = HOST_UART_BAUD_DEFAULT,
+                                        .run_us       = 0,
+                                        .frame_log    = false,
+                                        .show         = false,
+                                        .virtual_time = false,
+                                        .loop_us      = HOST_MAIN_LOOP_US,
+                                        .pty          = false,
+                                        .pty_link     = NULL};
+static uc1601s_t             panel;
+static host_irq_event_t      exit_check_event;
+static uint64_t              drained_since_us = 0;
+static struct timespec       wall_start;
+static volatile sig_atomic_t stop_requested = 0;
+static uint64_t              first_frame_us = 0; ///< Time from reset to the first panel frame, 0 until it ends.
+static uint64_t              first_tx_us    = 0; ///< Time from reset to the first response byte, 0 until it is sent.
+
+// The statistics are printed from the exit check, not from the signal handler.
+static void host_main_on_signal(int signum)
+{
+    (void)signum;
+    stop_requested = 1;
+}
+
+static uint64_t host_main_wall_us(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((uint64_t)now.tv_sec * HOST_MAIN_US_IN_S + (uint64_t)now.tv_nsec / HOST_MAIN_NS_IN_US) -
+           ((uint64_t)wall_start.tv_sec * HOST_MAIN_US_IN_S + (uint64_t)wall_start.tv_nsec / HOST_MAIN_NS_IN_US);
+}
+
+// The firmware main loop polls without touching any peripheral: each pass is given a fixed slice of virtual time,
+// which keeps the run deterministic.
+void app_idle(void)
+{
+    if(options.virtual_time)
+    {
+        host_irq_advance(options.loop_us);
+    }
+}
+
+static void host_main_print_bus_stats(const char *name, const uc1601s_bus_stats_t *stats)
+{
+    fprintf(stderr, "  %-11s %6u address + %6u command + %6u data frames, %8llu us, %3u%% data\n", name,
+            stats->address_frames, stats->command_frames, stats->data_frames,
+            (unsigned long long)(stats->bus_ns / HOST_MAIN_NS_IN_US), uc1601s_efficiency(stats));
+}
+
+static void host_main_on_frame(void *arg, const uc1601s_t *self, const uc1601s_bus_stats_t *frame)
+{
+    (void)arg;
+
+    if(0 == first_frame_us)
+    {
+        first_frame_us = host_irq_now_us();
+    }
+    if(options.frame_log)
+    {
+        char name[16];
+
+        snprintf(name, sizeof(name), "frame %u", self->frames);
+        host_main_print_bus_stats(name, frame);
+    }
+}
+
+// Only the first transmitted byte is of interest: the time the host waits for its first answer after reset.
+static void host_main_on_uart(void *arg, bool is_rx, uint8_t byte)
+{
+    (void)arg;
+    (void)byte;
+
+    if(!is_rx && (0 == first_tx_us))
+    {
+        first_tx_us = host_irq_now_us();
+    }
+}
+
+static void host_main_print_panel(void)
+{
+    for(uint8_t y = 0; y < (UC1601S_PANEL_PAGES * 8U); y++)
+    {
+        char row[UC1601S_PANEL_COLUMNS + 2U];
+
+        for(uint8_t x = 0; x < UC1601S_PANEL_COLUMNS; x++)
+        {
+            row[x] = uc1601s_get_pixel(&panel, x, y) ? '#' : '.';
+        }
+        row[UC1601S_PANEL_COLUMNS]      = '\n';
+        row[UC1601S_PANEL_COLUMNS + 1U] = '\0';
+        fputs(row, stderr);
+    }
+}
+
+static void host_main_print_stats(void)
+{
+    host_spi_stats_t  spi     = host_spi_get_stats();
+    host_uart_stats_t powered = host_uart_get_stats(HOST_UART_POWERED);
+    uint64_t          now_us  = host_irq_now_us();
+
+    // A partial refresh still in progress counts as the last frame.
+    uc1601s_end_frame(&panel);
+
+    if(options.virtual_time)
+    {
+        fprintf(stderr, "yeti-display-host: ran %llu ms of virtual time in %llu ms\n",
+                (unsigned long long)(now_us / HOST_MAIN_US_IN_MS),
+                (unsigned long long)(host_main_wall_us() / HOST_MAIN_US_IN_MS));
+    }
+    else
+    {
+        fprintf(stderr, "yeti-display-host: ran %llu ms\n", (unsigned long long)(now_us / HOST_MAIN_US_IN_MS));
+    }
+    fprintf(stderr, "  lcd spi: %u transfers, %u frames, %llu us on the wire, %u refused busy\n", spi.transfers,
+            spi.frames, (unsigned long long)spi.wire_us, spi.busy_refused);
+    fprintf(stderr, "  powered uart: %u rx bytes, %u rx overruns, %u tx bytes, %u tx queue full\n", powered.rx_bytes,
+            powered.rx_overruns, powered.tx_bytes, powered.tx_queue_full);
+    fprintf(stderr, "  boot: first frame at %llu us, first response at %llu us\n",
+            (unsigned long long)first_frame_us, (unsigned long long)first_tx_us);
+    fprintf(stderr, "  board: backlight %s, led d10 %s, buzzer %s (%u Hz, %u%%, %u starts)\n",
+            host_board.lcd_backlight ? "on" : "off", host_board.led_d10 ? "on" : "off",
+            host_board.buzzer_on ? "on" : "off", host_board.buzzer_freq, host_board.buzzer_duty,
+            host_board.buzzer_starts);
+    fprintf(stderr, "  uc1601s: %u frames, %u resets, %u unknown commands\n", panel.frames, panel.resets,
+            panel.unknown);
+    host_main_print_bus_stats("last frame", &panel.last_frame);
+    host_main_print_bus_stats("worst frame", &panel.worst_frame);
+    host_main_print_bus_stats("total", &panel.total);
+
+    if(options.show)
+    {
+        host_main_print_panel();
+    }
+}
+
+// Runs on the interrupt context: the main loop may never return from app_process_action().
+static void host_main_exit_check(void *arg)
+{
+    uint64_t now_us = host_irq_now_us();
+    bool     done   = false;
+
+    (void)arg;
+
+    if(0 != stop_requested)
+    {
+        done = true;
+    }
+    else if(0U != options.run_us)
+    {
+        done = (now_us >= options.run_us);
+    }
+    else if(host_uart_is_drained(HOST_UART_POWERED))
+    {
+        if(0U == drained_since_us)
+        {
+            drained_since_us = now_us;
+        }
+        done = ((now_us - drained_since_us) >= HOST_MAIN_DRAIN_GRACE_US);
+    }
+    else
+    {
+        drained_since_us = 0;
+    }
+
+    if(done)
+    {
+        host_main_print_stats();
+        exit(EXIT_SUCCESS);
+    }
+
+    host_irq_schedule(&exit_check_event, HOST_MAIN_POLL_US, host_main_exit_check, NULL);
+}
+
+static void host_main_usage(const char *name)
+{
+    fprintf(stderr,
+            "usage: %s [--baud N] [--run-ms N] [--frame-log] [--show] [--virtual] [--loop-us N]\n"
+            "          [--pty] [--pty-link PATH]\n"
+            "  Runs the display firmware. Command broker frames are read from stdin and responses are\n"
+            "  written to stdout, paced at the powered UART baud rate (default %lu).\n"
+            "  Without --run-ms the program exits once stdin is closed and every frame was answered.\n"
+            "  --frame-log prints the SPI cost of every LCD frame, --show prints the panel on exit.\n"
+            "  --virtual runs on a virtual clock: timers, delays and the UART pacing no longer wait for the\n"
+            "  wall clock and runs are reproducible. Each main loop pass takes --loop-us of virtual time\n"
+            "  (default %u).\n"
+            "  --pty bridges the powered and debug UARTs to pseudo-terminals, which serial port tools open\n"
+            "  like a COM port. Their names are printed on start, --pty-link PATH also links PATH to the\n"
+            "  powered UART and PATH-debug to the debug UART. Runs until --run-ms or until interrupted.\n",
+            name, (unsigned long)HOST_UART_BAUD_DEFAULT, HOST_MAIN_LOOP_US);
+}
+
+static int host_main_parse_options(int argc, char **argv)
+{
+    static const struct option long_options[] = {
+        {"baud", required_argument, NULL, 'b'},
+        {"run-ms", required_argument, NULL, 'r'},
+        {"frame-log", no_argument, NULL, 'f'},
+        {"show", no_argument, NULL, 's'},
+        {"virtual", no_argument, NULL, 'v'},
+        {"loop-us", required_argument, NULL, 'l'},
+        {"pty", no_argument, NULL, 'p'},
+        {"pty-link", required_argument, NULL, 'L'},
+        {"help", no_argument, NULL, 'h'},
+        {NULL, 0, NULL, 0},
+    };
+    int opt;
+
+    while(-1 != (opt = getopt_long(argc, argv, "b:r:fsvl:pL:h", long_options, NULL)))
+    {
+        switch(opt)
+        {
+            case 'b':
+                options.baud = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            case 'r':
+                options.run_us = strtoull(optarg, NULL, 0) * HOST_MAIN_US_IN_MS;
+                break;
+            case 'f':
+                options.frame_log = true;
+                break;
+            case 's':
+                options.show = true;
+                break;
+            case 'v':
+                options.virtual_time = true;
+                break;
+            case 'l':
+                options.loop_us = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            case 'L':
+                options.pty_link = optarg;
+                options.pty      = true;
+                break;
+            case 'p':
+                options.pty = true;
+                break;
+            default:
+                host_main_usage(argv[0]);
+                return ('h' == opt) ? 0 : 1;
+        }
+    }
+
+    return -1;
+}
+
+static bool host_main_open_ptys(void)
+{
+    static char debug_link[PATH_MAX];
+    char        powered_name[PATH_MAX];
+    char        debug_name[PATH_MAX];
+    int         powered_fd;
+    int         debug_fd;
+
+    if(NULL != options.pty_link)
+    {
+        snprintf(debug_link, sizeof(debug_link), "%s-debug", options.pty_link);
+    }
+
+    powered_fd = host_pty_open(options.pty_link, powered_name, sizeof(powered_name));
+    debug_fd   = host_pty_open((NULL != options.pty_link) ? debug_link : NULL, debug_name, sizeof(debug_name));
+    if(0 > powered_fd || 0 > debug_fd)
+    {
+        perror("yeti-display-host: pseudo-terminal");
+        return false;
+    }
+
+    host_uart_configure(HOST_UART_POWERED, powered_fd, powered_fd, options.baud);
+    host_uart_configure(HOST_UART_DEBUG, -1, debug_fd, 0);
+    fprintf(stderr, "yeti-display-host: powered uart on %s, debug uart on %s\n", powered_name, debug_name);
+
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    int status = host_main_parse_options(argc, argv);
+
+    if(0 <= status)
+    {
+        return status;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &wall_start);
+    if(options.virtual_time)
+    {
+        host_irq_init_virtual();
+    }
+    host_irq_init();
+    if(!options.pty)
+    {
+        host_uart_configure(HOST_UART_POWERED, STDIN_FILENO, STDOUT_FILENO, options.baud);
+        host_uart_configure(HOST_UART_DEBUG, -1, STDERR_FILENO, 0);
+    }
+    else if(!host_main_open_ptys())
+    {
+        return EXIT_FAILURE;
+    }
+    host_uart_set_monitor(HOST_UART_POWERED, host_main_on_uart, NULL);
+    signal(SIGINT, host_main_on_signal);
+    signal(SIGTERM, host_main_on_signal);
+    uc1601s_init(&panel, HOST_SPI_BITRATE, host_main_on_frame, NULL);
+    host_spi_set_sink(uc1601s_write, &panel);
+    host_irq_schedule(&exit_check_event, HOST_MAIN_POLL_US, host_main_exit_check, NULL);
+
+    app_init();
+
+    while(1)
+    {
+        app_process_action();
+    }
+}
@@ -0,0 +1,632 @@
+/** @file replay.c
+ *
+ * @brief Replays captured main board traffic into the display firmware and reports the response and LCD latencies.
+ *
+ * @author Rene Delgado
+ *
+ * @copyright 2023 The Chamberlain Group, LLC. All rights reserved. All
+ * information within this file and associated files, including all
+ * information and files transmitted with this file are CONFIDENTIAL
+ * and the proprietary property of The Chamberlain Group, LLC.
+ *
+ * In using the Licensed Software, Company shall not use with, combine, or
+ * incorporate any viral open source software with or into any of the Licensed
+ * Software in a manner that would require any portion of the Licensed software to
+ * be (i) disclosed or distributed in source code form; (ii) licensed for the
+ * purpose of making derivative works; or (iii) distributable or redistributable
+ * at no charge.
+ */
+
+#include <ctype.h>
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "app.h"
+#include "command_broker.h"
+#include "host_irq.h"
+#include "host_spi.h"
+#include "host_uart.h"
+#include "uc1601s.h"
+
+#define REPLAY_FRAME_MAX (64U)              ///< Longest frame accepted from a capture.
+#define REPLAY_NAME_MAX (48U)               ///< Frame label, from the .ptp SEND block.
+#define REPLAY_LINE_MAX (1024U)             ///< Longest capture line.
+#define REPLAY_BOOT_US (200000U)            ///< Time left to app_init() before the first frame.
+#define REPLAY_SETTLE_US (200000U)          ///< Quiet time after the last frame, for its LCD refresh.
+#define REPLAY_GAP_MS_DEFAULT (5U)          ///< Main board think time between a response and its next request.
+#define REPLAY_TIMEOUT_MS_DEFAULT (250U)    ///< Wait for a response before moving on.
+#define REPLAY_US_IN_MS (1000ULL)
+#define REPLAY_FRAME_OVERHEAD (10U)         ///< STX, packet number, command id, CRC and ETX.
+#define REPLAY_PY_LIST "display_boot_display_rx" ///< Frame list of tools/inputdata.py.
+
+/**
+ * @brief  One request of the capture and what happened to it.
+ */
+typedef struct
+{
+    char     name[REPLAY_NAME_MAX];   ///< Label.
+    uint8_t  bytes[REPLAY_FRAME_MAX]; ///< Frame as sent, STX to ETX.
+    uint8_t  size;                    ///< Frame size.
+    uint8_t  packet_number;           ///< Decoded packet number.
+    uint8_t  cmd_id;                  ///< Decoded command id.
+    bool     padded;                  ///< WRITE_LINE payload padded to the full line by --pad-write-line.
+    bool     etx;                     ///< Last byte handed to the firmware.
+    bool     responded;               ///< Response NULL byte transmitted.
+    bool     nak;                     ///< Response carries the error status bit.
+    bool     lcd_changed;             ///< Display RAM changed before the next request ended.
+    uint64_t etx_us;                  ///< ETX handed to the firmware.
+    uint64_t response_us;             ///< Response NULL byte on the wire.
+    uint64_t lcd_us;                  ///< Last display RAM change caused by this request.
+} replay_frame_t;
+
+/**
+ * @brief  Command line options.
+ */
+typedef struct
+{
+    uint32_t    baud;           ///< Powered UART baud rate.
+    uint32_t    gap_ms;         ///< Delay between a response and the next request.
+    uint32_t    timeout_ms;     ///< Wait for a response before sending the next request.
+    bool        pad_write_line; ///< Pad short WRITE_LINE payloads so the firmware accepts them.
+    bool        frames;         ///< Print every frame.
+    const char *path;           ///< Capture file.
+} replay_options_t;
+
+static replay_options_t options = {.baud           = HOST_UART_BAUD_DEFAULT,
+                                   .gap_ms         = REPLAY_GAP_MS_DEFAULT,
+                                   .timeout_ms     = REPLAY_TIMEOUT_MS_DEFAULT,
+                                   .pad_write_line = false,
+                                   .frames         = false,
+                                   .path           = NULL};
+
+static replay_frame_t  *frames        = NULL;
+static uint32_t         frame_count   = 0;
+static uint32_t         current       = 0;  ///< Request in flight.
+static int32_t          last_etx      = -1; ///< Latest request fully received, owner of the LCD changes.
+static uint64_t         rx_bytes      = 0;
+static uint64_t         rx_frame_end  = 0;  ///< rx_bytes count at the ETX of the request in flight.
+static uint8_t          response[REPLAY_FRAME_MAX];
+static uint8_t          response_size = 0;
+static uint32_t         unmatched     = 0;  ///< Responses that do not belong to the request in flight.
+static int              feed_fd       = -1;
+static uc1601s_t        panel;
+static uint32_t         ram_changes   = 0;
+static host_irq_event_t send_event;
+static host_irq_event_t timeout_event;
+
+static const char *const cmd_names[DISP_CMD_ID_MAX] = {
+    [DISP_CMD_ID_UNUSED] = "UNUSED",
+    [DISP_READ_KEYS]     = "READ_KEYS",
+    [DISP_WRITE_LINE]    = "WRITE_LINE",
+    [DISP_SET_BGLIGHT]   = "SET_BGLIGHT",
+    [DISP_CLEAR]         = "CLEAR",
+    [DISP_SET_LANGUAGE]  = "SET_LANGUAGE",
+    [DISP_GET_VERSION]   = "GET_VERSION",
+    [DISP_BUZZER_PARAM]  = "BUZZER_PARAM",
+    [DISP_BUZZER_CTRL]   = "BUZZER_CTRL",
+};
+
+/************************************************* FRAME ENCODING ****************************************************/
+
+static uint16_t replay_crc16arc(const uint8_t *data, size_t len)
+{
+    uint16_t crc = 0;
+
+    for(size_t i = 0; i < len; i++)
+    {
+        crc ^= data[i];
+        for(uint8_t k = 0; k < 8U; k++)
+        {
+            crc = (crc & 1U) ? (uint16_t)((crc >> 1) ^ 0xA001U) : (uint16_t)(crc >> 1);
+        }
+    }
+    return crc;
+}
+
+static uint8_t replay_hex_byte(const uint8_t *text)
+{
+    char pair[3] = {(char)text[0], (char)text[1], '\0'};
+
+    return (uint8_t)strtoul(pair, NULL, 16);
+}
+
+/**
+ * @brief  The main board sends WRITE_LINE with the text only, shorter than the CB_BYTES_IN_WRITE_LINE_DATA the
+ * firmware waits for: the firmware takes the CRC for payload and answers with the error bit. Padding the text with
+ * spaces and re-computing the CRC shows the latency of the requests the firmware is meant to accept.
+ */
+static void replay_pad_write_line(replay_frame_t *frame)
+{
+    const size_t full = REPLAY_FRAME_OVERHEAD + (2U * CB_BYTES_IN_WRITE_LINE_DATA);
+    uint8_t      body[REPLAY_FRAME_MAX];
+    size_t       len  = frame->size - 6U; // Packet number, command id and payload.
+    uint16_t     crc  = 0;
+
+    if((DISP_WRITE_LINE != frame->cmd_id) || (frame->size >= full) ||
+       (0U != ((frame->size - REPLAY_FRAME_OVERHEAD) % 2U)))
+    {
+        return;
+    }
+
+    memcpy(body, &frame->bytes[1], len);
+    while(len < (full - 6U))
+    {
+        body[len++] = '2';
+        body[len++] = '0';
+    }
+    crc = replay_crc16arc(body, len);
+
+    frame->bytes[0] = 0x02;
+    memcpy(&frame->bytes[1], body, len);
+    snprintf((char *)&frame->bytes[1 + len], 5, "%04X", crc);
+    frame->bytes[len + 5] = 0x03;
+    frame->size           = (uint8_t)(len + 6U);
+    frame->padded         = true;
+}
+
+static void replay_add_frame(const char *name, const uint8_t *bytes, size_t size)
+{
+    replay_frame_t *frame;
+
+    if((size < REPLAY_FRAME_OVERHEAD) || (size > REPLAY_FRAME_MAX))
+    {
+        fprintf(stderr, "replay: skipping %s, %zu bytes is not a frame\n", name, size);
+        return;
+    }
+
+    frames = realloc(frames, (frame_count + 1U) * sizeof(*frames));
+    if(NULL == frames)
+    {
+        perror("replay");
+        exit(EXIT_FAILURE);
+    }
+    frame = &frames[frame_count++];
+    memset(frame, 0, sizeof(*frame));
+
+    snprintf(frame->name, sizeof(frame->name), "%s", name);
+    memcpy(frame->bytes, bytes, size);
+    frame->size          = (uint8_t)size;
+    frame->packet_number = replay_hex_byte(&bytes[1]);
+    frame->cmd_id        = (uint8_t)(replay_hex_byte(&bytes[3]) & CB_CMD_ID_BITS_MASK);
+
+    if(options.pad_write_line)
+    {
+        replay_pad_write_line(frame);
+    }
+}
+
+/************************************************* CAPTURE PARSING ***************************************************/
+
+static size_t replay_parse_hex_line(const char *line, uint8_t *bytes)
+{
+    size_t size = 0;
+    char  *end  = NULL;
+
+    while(size < REPLAY_FRAME_MAX)
+    {
+        unsigned long value = strtoul(line, &end, 16);
+
+        if(end == line)
+        {
+            break;
+        }
+        bytes[size++] = (uint8_t)value;
+        line          = end;
+    }
+    return size;
+}
+
+static void replay_trim(char *text)
+{
+    size_t len = strlen(text);
+
+    while((0U != len) && isspace((unsigned char)text[len - 1U]))
+    {
+        text[--len] = '\0';
+    }
+}
+
+/**
+ * @brief  .ptp capture: every request is a SEND block, a flags line, the label, the bytes in hex and two trailing
+ * fields.
+ */
+static void replay_parse_ptp(FILE *file)
+{
+    char    line[REPLAY_LINE_MAX];
+    char    name[REPLAY_LINE_MAX];
+    uint8_t bytes[REPLAY_FRAME_MAX];
+
+    while(NULL != fgets(line, sizeof(line), file))
+    {
+        replay_trim(line);
+        if(0 != strcmp(line, "SEND"))
+        {
+            continue;
+        }
+        if((NULL == fgets(line, sizeof(line), file)) || (NULL == fgets(name, sizeof(name), file)) ||
+           (NULL == fgets(line, sizeof(line), file)))
+        {
+            break;
+        }
+        replay_trim(name);
+        replay_add_frame(name, bytes, replay_parse_hex_line(line, bytes));
+    }
+}
+
+/**
+ * @brief  tools/inputdata.py: the REPLAY_PY_LIST list of lists of integers.
+ */
+static void replay_parse_py(FILE *file)
+{
+    char    line[REPLAY_LINE_MAX];
+    bool    in_list = false;
+    uint8_t bytes[REPLAY_FRAME_MAX];
+
+    while(NULL != fgets(line, sizeof(line), file))
+    {
+        const char *row = line;
+        size_t      size = 0;
+        char        name[REPLAY_NAME_MAX];
+
+        if(!in_list)
+        {
+            in_list = (NULL != strstr(line, REPLAY_PY_LIST));
+            continue;
+        }
+        row = strchr(line, '[');
+        if(NULL == row)
+        {
+            if(NULL != strchr(line, ']'))
+            {
+                break;
+            }
+            continue;
+        }
+
+        row++;
+        while(size < REPLAY_FRAME_MAX)
+        {
+            char         *end;
+            unsigned long value = strtoul(row, &end, 0);
+
+            if(end == row)
+            {
+                break;
+            }
+            bytes[size++] = (uint8_t)value;
+            row           = end + strspn(end, ", ");
+        }
+        snprintf(name, sizeof(name), "%s[%u]", REPLAY_PY_LIST, frame_count);
+        replay_add_frame(name, bytes, size);
+    }
+}
+
+static int replay_load(const char *path)
+{
+    FILE       *file = fopen(path, "r");
+    const char *ext  = strrchr(path, '.');
+
+    if(NULL == file)
+    {
+        perror(path);
+        return 1;
+    }
+    if((NULL != ext) && (0 == strcmp(ext, ".py")))
+    {
+        replay_parse_py(file);
+    }
+    else
+    {
+        replay_parse_ptp(file);
+    }
+    fclose(file);
+
+    if(0U == frame_count)
+    {
+        fprintf(stderr, "replay: no frames in %s\n", path);
+        return 1;
+    }
+    return 0;
+}
+
+/****************************************************** REPORT *******************************************************/
+
+static int replay_compare(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a;
+    uint64_t y = *(const uint64_t *)b;
+
+    return (x > y) - (x < y);
+}
+
+static void replay_print_distribution(const char *name, uint64_t *samples, uint32_t count)
+{
+    uint64_t sum = 0;
+
+    if(0U == count)
+    {
+        return;
+    }
+    qsort(samples, count, sizeof(samples[0]), replay_compare);
+    for(uint32_t i = 0; i < count; i++)
+    {
+        sum += samples[i];
+    }
+    printf("  %-13s %6u %8llu %8llu %8llu %8llu %8llu %8llu\n", name, count, (unsigned long long)samples[0],
+           (unsigned long long)samples[((count - 1U) * 50U) / 100U],
+           (unsigned long long)samples[((count - 1U) * 90U) / 100U],
+           (unsigned long long)samples[((count - 1U) * 99U) / 100U], (unsigned long long)samples[count - 1U],
+           (unsigned long long)(sum / count));
+}
+
+// One row per command id and one for all requests, over the requests the metric applies to.
+static void replay_print_latency(const char *title, bool lcd, uint64_t *samples)
+{
+    printf("%s, us\n  %-13s %6s %8s %8s %8s %8s %8s %8s\n", title, "command", "count", "min", "p50", "p90", "p99",
+           "max", "mean");
+    for(uint8_t cmd_id = 0; cmd_id <= DISP_CMD_ID_MAX; cmd_id++)
+    {
+        uint32_t count = 0;
+
+        for(uint32_t i = 0; i < frame_count; i++)
+        {
+            const replay_frame_t *frame = &frames[i];
+            bool                  valid = lcd ? frame->lcd_changed : frame->responded;
+
+            if(valid && ((DISP_CMD_ID_MAX == cmd_id) || (frame->cmd_id == cmd_id)))
+            {
+                samples[count++] = (lcd ? frame->lcd_us : frame->response_us) - frame->etx_us;
+            }
+        }
+        replay_print_distribution((DISP_CMD_ID_MAX == cmd_id) ? "all" : cmd_names[cmd_id], samples, count);
+    }
+}
+
+static void replay_report(void)
+{
+    uint64_t *samples  = calloc(frame_count, sizeof(uint64_t));
+    uint32_t  answered = 0;
+    uint32_t  naks     = 0;
+    uint32_t  changed  = 0;
+    uint32_t  padded   = 0;
+
+    for(uint32_t i = 0; i < frame_count; i++)
+    {
+        answered += frames[i].responded ? 1U : 0U;
+        naks += frames[i].nak ? 1U : 0U;
+        changed += frames[i].lcd_changed ? 1U : 0U;
+        padded += frames[i].padded ? 1U : 0U;
+
+        if(options.frames)
+        {
+            printf("%5u %-40s pn %02X %-12s%s%s", i, frames[i].name, frames[i].packet_number,
+                   (frames[i].cmd_id < DISP_CMD_ID_MAX) ? cmd_names[frames[i].cmd_id] : "?",
+                   frames[i].padded ? " padded" : "", frames[i].nak ? " NAK" : "");
+            if(frames[i].responded)
+            {
+                printf(" response %llu us", (unsigned long long)(frames[i].response_us - frames[i].etx_us));
+            }
+            if(frames[i].lcd_changed)
+            {
+                printf(" lcd %llu us", (unsigned long long)(frames[i].lcd_us - frames[i].etx_us));
+            }
+            printf("\n");
+        }
+    }
+
+    printf("replay: %u frames from %s at %u baud, %u ms gap, %u padded\n", frame_count, options.path, options.baud,
+           options.gap_ms, padded);
+    printf("  responses: %u answered (%u NAK), %u unanswered, %u unmatched\n", answered, naks, frame_count - answered,
+           unmatched);
+    printf("  lcd: %u requests changed the display RAM\n", changed);
+    replay_print_latency("etx -> response NULL", false, samples);
+    replay_print_latency("etx -> last display RAM change", true, samples);
+
+    free(samples);
+}
+
+/************************************************** REPLAY ENGINE ****************************************************/
+
+static void replay_finish(void *arg)
+{
+    (void)arg;
+    replay_report();
+    exit(EXIT_SUCCESS);
+}
+
+// The pipe is read by the UART reader thread, which paces the bytes at the baud rate.
+static void replay_send(void *arg)
+{
+    replay_frame_t *frame = &frames[current];
+    size_t          wrote = 0;
+
+    (void)arg;
+    rx_frame_end += frame->size;
+    while(wrote < frame->size)
+    {
+        ssize_t len = write(feed_fd, &frame->bytes[wrote], frame->size - wrote);
+
+        if(0 > len)
+        {
+            perror("replay");
+            exit(EXIT_FAILURE);
+        }
+        wrote += (size_t)len;
+    }
+}
+
+static void replay_next(void *arg)
+{
+    (void)arg;
+    host_irq_cancel(&timeout_event);
+    current++;
+    if(current < frame_count)
+    {
+        host_irq_schedule(&send_event, options.gap_ms * REPLAY_US_IN_MS, replay_send, NULL);
+    }
+    else
+    {
+        host_irq_schedule(&send_event, REPLAY_SETTLE_US, replay_finish, NULL);
+    }
+}
+
+static void replay_on_response(void)
+{
+    replay_frame_t *frame = &frames[current];
+
+    if((current >= frame_count) || (response_size < 5U) || !frame->etx || frame->responded ||
+       (replay_hex_byte(&response[1]) != frame->packet_number))
+    {
+        unmatched++;
+        return;
+    }
+
+    frame->responded   = true;
+    frame->response_us = host_irq_now_us();
+    frame->nak         = (CB_CMD_ID_STATUS_BIT_ERR == (replay_hex_byte(&response[3]) & CB_CMD_ID_STATUS_BITS_MASK));
+    replay_next(NULL);
+}
+
+static void replay_uart_monitor(void *arg, bool is_rx, uint8_t byte)
+{
+    (void)arg;
+    if(is_rx)
+    {
+        rx_bytes++;
+        if((current < frame_count) && (rx_bytes == rx_frame_end))
+        {
+            frames[current].etx    = true;
+            frames[current].etx_us = host_irq_now_us();
+            last_etx               = (int32_t)current;
+            host_irq_schedule(&timeout_event, options.timeout_ms * REPLAY_US_IN_MS, replay_next, NULL);
+        }
+        return;
+    }
+
+    if(0x02U == byte)
+    {
+        response_size = 0;
+    }
+    if(response_size < sizeof(response))
+    {
+        response[response_size++] = byte;
+    }
+    if(0x00U == byte)
+    {
+        replay_on_response();
+    }
+}
+
+// Called with interrupts masked by the SPI fake, before the transfer is on the wire: a change is dated when the
+// transfer carrying it leaves the bus.
+static void replay_spi_sink(void *arg, const uint16_t *data, size_t count)
+{
+    (void)arg;
+    uc1601s_write(&panel, data, count);
+    if(panel.ram_changes != ram_changes)
+    {
+        ram_changes = panel.ram_changes;
+        if(0 <= last_etx)
+        {
+            frames[last_etx].lcd_changed = true;
+            frames[last_etx].lcd_us      = host_spi_wire_free_us();
+        }
+    }
+}
+
+/**************************************************** OPTIONS ********************************************************/
+
+static void replay_usage(const char *name)
+{
+    fprintf(stderr,
+            "usage: %s [--baud N] [--gap-ms N] [--timeout-ms N] [--pad-write-line] [--frames] CAPTURE\n"
+            "  Replays a .ptp capture or the " REPLAY_PY_LIST " list of inputdata.py into the firmware, one\n"
+            "  request at a time: the next one is sent --gap-ms (default %u) after the response, or after\n"
+            "  --timeout-ms (default %u) without one. Reports the latency from ETX to the response NULL byte\n"
+            "  and from ETX to the last display RAM change it caused, per command.\n"
+            "  --pad-write-line pads short WRITE_LINE payloads with spaces so the firmware accepts them,\n"
+            "  --frames prints every request.\n",
+            name, REPLAY_GAP_MS_DEFAULT, REPLAY_TIMEOUT_MS_DEFAULT);
+}
+
+static int replay_parse_options(int argc, char **argv)
+{
+    static const struct option long_options[] = {
+        {"baud", required_argument, NULL, 'b'},
+        {"gap-ms", required_argument, NULL, 'g'},
+        {"timeout-ms", required_argument, NULL, 't'},
+        {"pad-write-line", no_argument, NULL, 'p'},
+        {"frames", no_argument, NULL, 'f'},
+        {"help", no_argument, NULL, 'h'},
+        {NULL, 0, NULL, 0},
+    };
+    int opt;
+
+    while(-1 != (opt = getopt_long(argc, argv, "b:g:t:pfh", long_options, NULL)))
+    {
+        switch(opt)
+        {
+            case 'b':
+                options.baud = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            case 'g':
+                options.gap_ms = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            case 't':
+                options.timeout_ms = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            case 'p':
+                options.pad_write_line = true;
+                break;
+            case 'f':
+                options.frames = true;
+                break;
+            default:
+                replay_usage(argv[0]);
+                return ('h' == opt) ? 0 : 1;
+        }
+    }
+
+    if((optind + 1) != argc)
+    {
+        replay_usage(argv[0]);
+        return 1;
+    }
+    options.path = argv[optind];
+
+    return -1;
+}
+
+int main(int argc, char **argv)
+{
+    int status = replay_parse_options(argc, argv);
+    int pipe_fds[2];
+
+    if(0 <= status)
+    {
+        return status;
+    }
+    if((0 != replay_load(options.path)) || (0 != pipe(pipe_fds)))
+    {
+        return 1;
+    }
+    feed_fd = pipe_fds[1];
+
+    host_irq_init();
+    host_uart_configure(HOST_UART_POWERED, pipe_fds[0], -1, options.baud);
+    host_uart_configure(HOST_UART_DEBUG, -1, STDERR_FILENO, 0);
+    host_uart_set_monitor(HOST_UART_POWERED, replay_uart_monitor, NULL);
+    uc1601s_init(&panel, HOST_SPI_BITRATE, NULL, NULL);
+    host_spi_set_sink(replay_spi_sink, NULL);
+    host_irq_schedule(&send_event, REPLAY_BOOT_US, replay_send, NULL);
+
+    app_init();
+
+    while(1)
+    {
+        app_process_action();
+    }
+}
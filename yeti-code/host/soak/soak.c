@@ -0,0 +1,590 @@
+/** @file soak.c
+ *
+ * @brief Soak test: many simulated displays, each with its own broker, renderer and panel, run on worker threads.
+ *
+ * @author Rene Delgado
+ *
+ * @copyright 2023 The Chamberlain Group, LLC. All rights reserved. All
+ * information within this file and associated files, including all
+ * information and files transmitted with this file are CONFIDENTIAL
+ * and the proprietary property of The Chamberlain Group, LLC.
+ *
+ * In using the Licensed Software, Company shall not use with, combine, or
+ * incorporate any viral open source software with or into any of the Licensed
+ * Software in a manner that would require any portion of the Licensed software to
+ * be (i) disclosed or distributed in source code form; (ii) licensed for the
+ * purpose of making derivative works; or (iii) distributable or redistributable
+ * at no charge.
+ */
+
+#include <getopt.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "command_broker.h"
+#include "host_irq.h"
+#include "host_spi.h"
+#include "lcd.h"
+#include "uc1601s.h"
+
+#define SOAK_DISPLAYS_DEFAULT (64U)         ///< Simulated displays.
+#define SOAK_REQUESTS_DEFAULT (2000U)       ///< Requests sent to every display.
+#define SOAK_STREAMS_DEFAULT (4U)           ///< Distinct traffic streams, display n gets stream n % streams.
+#define SOAK_FRAME_MAX (64U)                ///< Longest request frame (WRITE_LINE is 49).
+#define SOAK_TEXT_CHARS (LCD_CHAR_NUM - 3U) ///< Characters between the format byte and the right icon.
+#define SOAK_VERSION (0x0046U)              ///< GET_VERSION answer.
+#define SOAK_UART_BAUD (9600U)              ///< Powered UART baud rate, for the real time ratio.
+#define SOAK_BITS_PER_UART_BYTE (10U)       ///< 8N1: start + 8 data + stop.
+#define SOAK_FLUSH_CALLS_MAX ((NUM_PIX_COL_PER_ROW_BYTES + 2U) * NUM_PIX_ROW_PER_COL_BYTES * 2U)
+#define SOAK_NS_IN_S (1000000000ULL)
+#define SOAK_FNV_OFFSET (0xCBF29CE484222325ULL)
+#define SOAK_FNV_PRIME (0x00000100000001B3ULL)
+
+// Main board side of the WRITE_LINE format byte, see lcd.c.
+#define SOAK_FORMAT_INVERTED (1U << 0)
+#define SOAK_FORMAT_LEFT (1U << 1)
+#define SOAK_FORMAT_RIGHT (1U << 2)
+
+/**
+ * @brief  One simulated display: the same broker, renderer and panel app.c runs, with the UART played by the worker.
+ */
+typedef struct
+{
+    cbroker_t           broker;
+    lcd_t               lcd;
+    uc1601s_t           panel;
+    base_driver         uart;           ///< Powered UART stand-in, bytes are exchanged by the worker.
+    base_driver         spi;            ///< LCD SPI stand-in, frames go straight to the panel.
+    callback_receive_t  rx_callback;    ///< Armed by the broker for the next request byte.
+    uint8_t            *rx_byte;        ///< Buffer given with rx_callback.
+    callback_transmit_t tx_callback;    ///< Set while a response byte is on the wire.
+    uint8_t            *tx_byte;        ///< Buffer given with tx_callback.
+    uint32_t            stream;         ///< Traffic stream.
+    uint32_t            rng;            ///< Traffic generator state.
+    uint32_t            requests;       ///< Requests sent.
+    uint32_t            responses;      ///< Responses received, counted on their NULL byte.
+    uint32_t            naks;           ///< Responses carrying the error status bit.
+    uint64_t            rx_bytes;       ///< Request bytes sent.
+    uint64_t            tx_bytes;       ///< Response bytes received.
+    uint64_t            response_hash;  ///< FNV-1a of every response byte.
+    uint64_t            panel_hash;     ///< FNV-1a of the panel image at the end of the run.
+    uint8_t             response[SOAK_FRAME_MAX];
+    uint8_t             response_size;
+} soak_display_t;
+
+/**
+ * @brief  Worker thread, it owns every display whose index is its own modulo the worker count.
+ */
+typedef struct
+{
+    pthread_t thread;
+    uint32_t  index;
+} soak_worker_t;
+
+/**
+ * @brief  Command line options.
+ */
+typedef struct
+{
+    uint32_t displays; ///< Simulated displays.
+    uint32_t threads;  ///< Worker threads, 0 for one per online core.
+    uint32_t requests; ///< Requests sent to every display.
+    uint32_t streams;  ///< Distinct traffic streams.
+} soak_options_t;
+
+static soak_options_t    options  = {.displays = SOAK_DISPLAYS_DEFAULT,
+                                     .threads  = 0,
+                                     .requests = SOAK_REQUESTS_DEFAULT,
+                                     .streams  = SOAK_STREAMS_DEFAULT};
+static soak_display_t   *displays = NULL;
+static soak_worker_t    *workers  = NULL;
+static pthread_barrier_t initialized; ///< Every display initialized, its panel bring-up is queued on the clock.
+static pthread_barrier_t started;     ///< Every panel ready, the timed part starts.
+
+/************************************************* FRAME ENCODING ****************************************************/
+
+static uint16_t soak_crc16arc(const uint8_t *data, size_t len)
+{
+    uint16_t crc = 0;
+
+    for(size_t i = 0; i < len; i++)
+    {
+        crc ^= data[i];
+        for(uint8_t k = 0; k < 8U; k++)
+        {
+            crc = (crc & 1U) ? (uint16_t)((crc >> 1) ^ 0xA001U) : (uint16_t)(crc >> 1);
+        }
+    }
+    return crc;
+}
+
+static uint64_t soak_fnv(uint64_t hash, const uint8_t *data, size_t size)
+{
+    for(size_t i = 0; i < size; i++)
+    {
+        hash = (hash ^ data[i]) * SOAK_FNV_PRIME;
+    }
+    return hash;
+}
+
+// xorshift32: every display of a stream draws the same requests.
+static uint32_t soak_random(soak_display_t *self, uint32_t range)
+{
+    self->rng ^= self->rng << 13;
+    self->rng ^= self->rng >> 17;
+    self->rng ^= self->rng << 5;
+    return self->rng % range;
+}
+
+static uint8_t soak_encode(uint8_t *frame, uint8_t packet_number, cbroker_cmd_id_e cmd_id, const uint8_t *payload,
+                           uint8_t payload_size)
+{
+    char     text[SOAK_FRAME_MAX];
+    int      len = 0;
+    uint16_t crc = 0;
+
+    len = snprintf(text, sizeof(text), "%02X%02X", (unsigned)packet_number, (unsigned)cmd_id);
+    for(uint8_t i = 0; i < payload_size; i++)
+    {
+        len += snprintf(&text[len], sizeof(text) - (size_t)len, "%02X", payload[i]);
+    }
+    crc = soak_crc16arc((const uint8_t *)text, (size_t)len);
+    len += snprintf(&text[len], sizeof(text) - (size_t)len, "%04X", crc);
+
+    frame[0] = 0x02;
+    memcpy(&frame[1], text, (size_t)len);
+    frame[len + 1] = 0x03;
+    return (uint8_t)(len + 2);
+}
+
+/**
+ * @brief  Mostly WRITE_LINE, as the main board sends. The text is printable ASCII only: blinking glyphs run their
+ * timer on the host_irq thread, which would render into the display while its worker does.
+ */
+static uint8_t soak_next_request(soak_display_t *self, uint8_t *frame)
+{
+    static const uint8_t formats[] = {SOAK_FORMAT_LEFT,
+                                      SOAK_FORMAT_RIGHT,
+                                      SOAK_FORMAT_LEFT | SOAK_FORMAT_RIGHT,
+                                      SOAK_FORMAT_LEFT | SOAK_FORMAT_INVERTED,
+                                      SOAK_FORMAT_RIGHT | SOAK_FORMAT_INVERTED,
+                                      SOAK_FORMAT_LEFT | SOAK_FORMAT_RIGHT | SOAK_FORMAT_INVERTED};
+    uint8_t              payload[CB_BYTES_IN_WRITE_LINE_DATA];
+    uint8_t              packet_number = (uint8_t)self->requests;
+    uint32_t             pick          = soak_random(self, 100U);
+
+    if(pick < 5U)
+    {
+        return soak_encode(frame, packet_number, DISP_CLEAR, NULL, 0);
+    }
+    if(pick < 15U)
+    {
+        return soak_encode(frame, packet_number, DISP_GET_VERSION, NULL, 0);
+    }
+    if(pick < 30U)
+    {
+        payload[0] = CB_READ_KEYS_DATA_LED_ON;
+        return soak_encode(frame, packet_number, DISP_READ_KEYS, payload, 1);
+    }
+
+    // Line, left icon, format byte, text and right icon.
+    payload[0] = (uint8_t)soak_random(self, CB_WRITE_LINE_DATA0_MAX);
+    payload[1] = ' ';
+    payload[2] = formats[soak_random(self, sizeof(formats))];
+    for(uint8_t i = 0; i < SOAK_TEXT_CHARS; i++)
+    {
+        payload[3U + i] = (uint8_t)(' ' + soak_random(self, '~' - ' ' + 1));
+    }
+    payload[CB_BYTES_IN_WRITE_LINE_DATA - 1] = ' ';
+    return soak_encode(frame, packet_number, DISP_WRITE_LINE, payload, sizeof(payload));
+}
+
+/************************************************ DRIVER STAND-INS ***************************************************/
+
+static void soak_request_callback(void *arg, cbroker_cmd_id_e cmd_id, const cbroker_request_data_t *const payload,
+                                  cbroker_response_data_t *const output)
+{
+    soak_display_t *self = (soak_display_t *)arg;
+
+    switch(cmd_id)
+    {
+        case DISP_READ_KEYS:
+            output->read_keys = 0;
+            break;
+        case DISP_WRITE_LINE:
+            lcd_put_line(&self->lcd, payload->write_line.data, sizeof(payload->write_line.data),
+                         payload->write_line.line, 0);
+            break;
+        case DISP_CLEAR:
+            lcd_clear(&self->lcd);
+            break;
+        case DISP_GET_VERSION:
+            output->version = SOAK_VERSION;
+            break;
+        default:
+            break;
+    }
+}
+
+static int soak_uart_write(void *handle, const uint8_t *buff, size_t size, callback_transmit_t callback)
+{
+    soak_display_t *self = (soak_display_t *)handle;
+
+    (void)size;
+    self->tx_callback = callback;
+    self->tx_byte     = (uint8_t *)buff;
+    return 0;
+}
+
+static int soak_uart_read(void *handle, const uint8_t *buff, size_t size, callback_receive_t callback)
+{
+    soak_display_t *self = (soak_display_t *)handle;
+
+    (void)size;
+    self->rx_callback = callback;
+    self->rx_byte     = (uint8_t *)buff;
+    return 0;
+}
+
+// The completion runs right away, as if the SPI DMA were infinitely fast.
+static int soak_spi_write(void *handle, const uint8_t *buff, size_t size, callback_transmit_t callback)
+{
+    soak_display_t *self = (soak_display_t *)handle;
+
+    uc1601s_write(&self->panel, (const uint16_t *)(const void *)buff, size);
+    if(NULL != callback)
+    {
+        callback(0, (uint8_t *)buff, size);
+    }
+    return 0;
+}
+
+/***************************************************** DISPLAY *******************************************************/
+
+static void soak_display_init(soak_display_t *self, uint32_t index)
+{
+    // Full height lines: the four lines fit the panel.
+    static const lcd_line_t layout[LCD_LINE_NUM] = {{0, LCD_LINE_PIXEL_HEIGHT},
+                                                    {0, LCD_LINE_PIXEL_HEIGHT},
+                                                    {0, LCD_LINE_PIXEL_HEIGHT},
+                                                    {0, LCD_LINE_PIXEL_HEIGHT}};
+
+    memset(self, 0x00, sizeof(soak_display_t));
+    self->stream                  = index % options.streams;
+    self->rng                     = 0x9E3779B9U ^ (self->stream * 0x85EBCA6BU);
+    self->rng                     = (0U == self->rng) ? 1U : self->rng;
+    self->uart.write_non_blocking = soak_uart_write;
+    self->uart.read_non_blocking  = soak_uart_read;
+    self->uart.handle             = self;
+    self->spi.write_non_blocking  = soak_spi_write;
+    self->spi.handle              = self;
+    self->response_hash           = SOAK_FNV_OFFSET;
+
+    uc1601s_init(&self->panel, HOST_SPI_BITRATE, NULL, NULL);
+    lcd_init(&self->lcd, &self->spi, layout);
+    cbroker_init(&self->broker, &self->uart, soak_request_callback, self);
+}
+
+static void soak_display_on_response_byte(soak_display_t *self, uint8_t byte)
+{
+    self->tx_bytes++;
+    self->response_hash = soak_fnv(self->response_hash, &byte, 1);
+    if(self->response_size < SOAK_FRAME_MAX)
+    {
+        self->response[self->response_size++] = byte;
+    }
+
+    // STX, packet number, command id with status, ..., ETX, NULL.
+    if(0x00 == byte)
+    {
+        char    status[3] = {(char)self->response[3], (char)self->response[4], '\0'};
+        uint8_t cmd       = (uint8_t)strtoul(status, NULL, 16);
+
+        if(CB_CMD_ID_STATUS_BIT_NO_ERR != (cmd & CB_CMD_ID_STATUS_BITS_MASK))
+        {
+            self->naks++;
+        }
+        self->responses++;
+        self->response_size = 0;
+    }
+}
+
+// Completes response bytes until the broker stops transmitting, each callback queues the next byte.
+static void soak_display_drain(soak_display_t *self)
+{
+    while(NULL != self->tx_callback)
+    {
+        callback_transmit_t callback = self->tx_callback;
+
+        self->tx_callback = NULL;
+        soak_display_on_response_byte(self, *self->tx_byte);
+        callback(0, self->tx_byte, 1);
+    }
+}
+
+static bool soak_display_is_dirty(const soak_display_t *self)
+{
+    for(uint8_t page = 0; page < NUM_PIX_ROW_PER_COL_BYTES; page++)
+    {
+        if(self->lcd.front_dirty[page] != 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Sends one request a byte at a time, answers it, then refreshes the panel as the app_process_action() loop does.
+static void soak_display_step(soak_display_t *self)
+{
+    uint8_t  frame[SOAK_FRAME_MAX];
+    uint8_t  size  = soak_next_request(self, frame);
+    uint32_t calls = 0;
+
+    for(uint8_t i = 0; i < size; i++)
+    {
+        if(NULL != self->rx_callback)
+        {
+            *self->rx_byte = frame[i];
+            self->rx_callback(0, self->rx_byte, 1);
+        }
+        soak_display_drain(self);
+    }
+    self->requests++;
+    self->rx_bytes += size;
+
+    while(soak_display_is_dirty(self) && (calls < SOAK_FLUSH_CALLS_MAX))
+    {
+        while(!lcd_update(&self->lcd, 1) && (++calls < SOAK_FLUSH_CALLS_MAX))
+        {
+        }
+    }
+}
+
+static void soak_display_finish(soak_display_t *self)
+{
+    uint8_t image[UC1601S_PANEL_PAGES][UC1601S_PANEL_COLUMNS];
+
+    uc1601s_get_image(&self->panel, image);
+    self->panel_hash = soak_fnv(SOAK_FNV_OFFSET, &image[0][0], sizeof(image));
+}
+
+/***************************************************** WORKERS *******************************************************/
+
+static uint32_t soak_worker_count(void)
+{
+    return (options.threads < options.displays) ? options.threads : options.displays;
+}
+
+// Requests go round robin over the displays of the worker, as a main board would poll a bus of displays.
+static void *soak_worker(void *arg)
+{
+    const soak_worker_t *self  = (const soak_worker_t *)arg;
+    const uint32_t       count = soak_worker_count();
+
+    for(uint32_t d = self->index; d < options.displays; d += count)
+    {
+        soak_display_init(&displays[d], d);
+    }
+    pthread_barrier_wait(&initialized);
+    pthread_barrier_wait(&started);
+    for(uint32_t r = 0; r < options.requests; r++)
+    {
+        for(uint32_t d = self->index; d < options.displays; d += count)
+        {
+            soak_display_step(&displays[d]);
+        }
+    }
+    for(uint32_t d = self->index; d < options.displays; d += count)
+    {
+        soak_display_finish(&displays[d]);
+    }
+    return NULL;
+}
+
+static uint64_t soak_now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * SOAK_NS_IN_S) + (uint64_t)ts.tv_nsec;
+}
+
+/****************************************************** REPORT *******************************************************/
+
+/**
+ * @brief  Every display of a stream got the same requests: they must answer the same bytes and show the same image.
+ * A difference means state leaked between two instances.
+ */
+static uint32_t soak_check(void)
+{
+    uint32_t failures = 0;
+
+    for(uint32_t d = 0; d < options.displays; d++)
+    {
+        const soak_display_t *self  = &displays[d];
+        const soak_display_t *first = &displays[self->stream];
+
+        if(self->responses != self->requests)
+        {
+            printf("FAIL display %u: %u requests, %u responses\n", d, self->requests, self->responses);
+            failures++;
+        }
+        else if(0U != self->naks)
+        {
+            printf("FAIL display %u: %u requests answered with the error bit\n", d, self->naks);
+            failures++;
+        }
+        else if((self->response_hash != first->response_hash) || (self->panel_hash != first->panel_hash))
+        {
+            printf("FAIL display %u: responses %016" PRIx64 ", panel %016" PRIx64 ", display %u of the same stream "
+                   "has %016" PRIx64 ", %016" PRIx64 "\n",
+                   d, self->response_hash, self->panel_hash, self->stream, first->response_hash, first->panel_hash);
+            failures++;
+        }
+    }
+    return failures;
+}
+
+static void soak_report(uint64_t elapsed_ns, uint32_t failures)
+{
+    const double seconds  = (double)elapsed_ns / (double)SOAK_NS_IN_S;
+    uint64_t     requests = 0;
+    uint64_t     bytes    = 0;
+    uint64_t     frames   = 0;
+
+    for(uint32_t d = 0; d < options.displays; d++)
+    {
+        requests += displays[d].requests;
+        bytes += displays[d].rx_bytes + displays[d].tx_bytes;
+        frames += displays[d].panel.frames;
+    }
+
+    printf("yeti-display-soak: %u displays on %u threads, %u requests each, %u streams\n", options.displays,
+           soak_worker_count(), options.requests, options.streams);
+    printf("  %.3f s: %" PRIu64 " requests, %" PRIu64 " uart bytes, %" PRIu64 " panel frames\n", seconds, requests,
+           bytes, frames);
+    printf("  %.0f requests/s, %.0f uart bytes/s, %.1f displays at %u baud in real time\n", (double)requests / seconds,
+           (double)bytes / seconds, ((double)bytes * SOAK_BITS_PER_UART_BYTE) / (seconds * SOAK_UART_BAUD),
+           SOAK_UART_BAUD);
+    printf("%s: %u of %u displays failed\n", (0U == failures) ? "PASS" : "FAIL", failures, options.displays);
+}
+
+static void soak_usage(const char *name)
+{
+    fprintf(stderr,
+            "usage: %s [--displays N] [--threads N] [--requests N] [--streams N]\n"
+            "  Runs N simulated displays, each with its own command broker, LCD renderer and panel, on worker\n"
+            "  threads (default one per core) and reports the throughput. Display n gets traffic stream n %% streams:\n"
+            "  displays of a stream must answer the same bytes and show the same image, exits with 1 otherwise.\n"
+            "  Defaults: %u displays, %u requests, %u streams.\n",
+            name, SOAK_DISPLAYS_DEFAULT, SOAK_REQUESTS_DEFAULT, SOAK_STREAMS_DEFAULT);
+}
+
+static int soak_parse_options(int argc, char **argv)
+{
+    static const struct option long_options[] = {
+        {"displays", required_argument, NULL, 'd'},
+        {"threads", required_argument, NULL, 't'},
+        {"requests", required_argument, NULL, 'r'},
+        {"streams", required_argument, NULL, 's'},
+        {"help", no_argument, NULL, 'h'},
+        {NULL, 0, NULL, 0},
+    };
+    int opt;
+
+    while(-1 != (opt = getopt_long(argc, argv, "d:t:r:s:h", long_options, NULL)))
+    {
+        switch(opt)
+        {
+            case 'd':
+                options.displays = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            case 't':
+                options.threads = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            case 'r':
+                options.requests = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            case 's':
+                options.streams = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            default:
+                soak_usage(argv[0]);
+                return ('h' == opt) ? 0 : 1;
+        }
+    }
+
+    if((0U == options.displays) || (0U == options.streams))
+    {
+        soak_usage(argv[0]);
+        return 1;
+    }
+    if(0U == options.threads)
+    {
+        long cores = sysconf(_SC_NPROCESSORS_ONLN);
+
+        options.threads = (cores > 0) ? (uint32_t)cores : 1U;
+    }
+    options.streams = (options.streams < options.displays) ? options.streams : options.displays;
+
+    return -1;
+}
+
+int main(int argc, char **argv)
+{
+    int      exit_code = soak_parse_options(argc, argv);
+    uint32_t failures  = 0;
+    uint64_t start     = 0;
+
+    if(exit_code >= 0)
+    {
+        return exit_code;
+    }
+
+    displays = calloc(options.displays, sizeof(soak_display_t));
+    workers  = calloc(soak_worker_count(), sizeof(soak_worker_t));
+    if((NULL == displays) || (NULL == workers))
+    {
+        fprintf(stderr, "yeti-display-soak: out of memory\n");
+        return EXIT_FAILURE;
+    }
+
+    // lcd_init() queues the panel bring-up on the clock: it runs here, on the virtual clock, while the workers wait.
+    host_irq_init_virtual();
+    pthread_barrier_init(&initialized, NULL, soak_worker_count() + 1U);
+    pthread_barrier_init(&started, NULL, soak_worker_count() + 1U);
+    for(uint32_t w = 0; w < soak_worker_count(); w++)
+    {
+        workers[w].index = w;
+        pthread_create(&workers[w].thread, NULL, soak_worker, &workers[w]);
+    }
+    pthread_barrier_wait(&initialized);
+    for(uint32_t d = 0; d < options.displays; d++)
+    {
+        while(!lcd_is_ready(&displays[d].lcd))
+        {
+            sl_sleeptimer_delay_millisecond(1);
+        }
+    }
+    pthread_barrier_wait(&started);
+    start = soak_now_ns();
+    for(uint32_t w = 0; w < soak_worker_count(); w++)
+    {
+        pthread_join(workers[w].thread, NULL);
+    }
+
+    failures = soak_check();
+    soak_report(soak_now_ns() - start, failures);
+
+    pthread_barrier_destroy(&initialized);
+    pthread_barrier_destroy(&started);
+    free(workers);
+    free(displays);
+    return (0U == failures) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
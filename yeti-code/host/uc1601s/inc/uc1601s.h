@@ -0,0 +1,171 @@
+/** @file uc1601s.h
+ *
+ * @brief Virtual UC1601s: decodes the 9-bit SPI stream of lcd.c into display RAM and measures the bus cost of every frame.
+ *
+ * @author Rene Delgado
+ *
+ * @copyright 2023 The Chamberlain Group, LLC. All rights reserved. All
+ * information within this file and associated files, including all
+ * information and files transmitted with this file are CONFIDENTIAL
+ * and the proprietary property of The Chamberlain Group, LLC.
+ *
+ * In using the Licensed Software, Company shall not use with, combine, or
+ * incorporate any viral open source software with or into any of the Licensed
+ * Software in a manner that would require any portion of the Licensed software to
+ * be (i) disclosed or distributed in source code form; (ii) licensed for the
+ * purpose of making derivative works; or (iii) distributable or redistributable
+ * at no charge.
+ */
+
+#ifndef HOST_UC1601S_INC_UC1601S_H_
+#define HOST_UC1601S_INC_UC1601S_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define UC1601S_RAM_PAGES (9U)       ///< 65 rows: 8 pages plus the icon row.
+#define UC1601S_RAM_COLUMNS (132U)   ///< Segment drivers.
+#define UC1601S_RAM_ROWS (65U)       ///< COM drivers.
+#define UC1601S_PANEL_PAGES (6U)     ///< Pages wired on the yeti display (48 rows).
+#define UC1601S_PANEL_COLUMNS (128U) ///< Columns wired on the yeti display.
+#define UC1601S_FRAME_CD (0x100U)    ///< Bit 8 of a SPI frame: 1 display data, 0 command.
+
+/**
+ * @brief  Bus cost, in 9-bit SPI frames.
+ */
+typedef struct
+{
+    uint32_t address_frames; ///< SET_PAGE, SET_COL_L and SET_COL_H commands.
+    uint32_t command_frames; ///< Every other command byte, parameters included.
+    uint32_t data_frames;    ///< Display data bytes.
+    uint64_t bus_ns;         ///< Time the frames take on the wire at the configured bitrate.
+} uc1601s_bus_stats_t;
+
+/**
+ * @brief  Controller state that changes the picture without touching display RAM.
+ */
+typedef struct
+{
+    bool    enabled;        ///< DC[2], display enable.
+    bool    all_on;         ///< DC[1], all pixels on.
+    bool    inverse;        ///< DC[0], inverse display.
+    bool    partial;        ///< LC[4], partial display enable.
+    uint8_t scroll_line;    ///< SL[5:0].
+    uint8_t partial_start;  ///< DST[6:0].
+    uint8_t partial_end;    ///< DEN[6:0].
+    uint8_t com_end;        ///< CEN[6:0].
+    uint8_t mapping;        ///< LC[2:1], MX/MY.
+    uint8_t ram_control;    ///< AC[2:0].
+    uint8_t bias_ratio;     ///< BR[1:0].
+    uint8_t vbias;          ///< PM[7:0].
+    uint8_t temp_comp;      ///< TC[1:0].
+    uint8_t power_control;  ///< PC[2:0].
+    uint8_t frame_rate;     ///< LC[3].
+} uc1601s_display_t;
+
+typedef struct uc1601s uc1601s_t;
+
+/**
+ * @brief  Called every time a frame completes.
+ *
+ * @param [in] arg - Argument given to uc1601s_init().
+ * @param [in] self - Emulator instance.
+ * @param [in] frame - Bus cost of the frame that just completed.
+ */
+typedef void (*uc1601s_frame_callback_t)(void *arg, const uc1601s_t *self, const uc1601s_bus_stats_t *frame);
+
+/**
+ * @brief  Emulator instance.
+ *
+ * The bus cost is split in flushes and frames. A flush is the traffic up to a DISPLAY ENABLE command that follows
+ * display data: lcd_update() ends every page with one. A frame groups consecutive flushes until every panel page was
+ * written, or until a flush writes a page again (a partial refresh), so frames compare across flush strategies.
+ */
+struct uc1601s
+{
+    uint8_t           ram[UC1601S_RAM_PAGES][UC1601S_RAM_COLUMNS];
+    uint8_t           page;          ///< PA[3:0].
+    uint8_t           column;        ///< CA[7:0].
+    uint8_t           pending_param; ///< Double byte command waiting for its parameter, 0 for none.
+    uc1601s_display_t display;
+
+    uint32_t                 bitrate;
+    uint16_t                 flush_pages;   ///< Bit n set once page n got data in the flush in progress.
+    uint16_t                 pages_written; ///< Bit n set once page n got data in the current frame.
+    uint32_t                 frames;        ///< Completed frames.
+    uint32_t                 resets;        ///< SYSTEM RESET commands.
+    uint32_t                 unknown;       ///< Command bytes that do not decode.
+    uint32_t                 ram_changes;   ///< Data writes that changed a display RAM byte.
+    uc1601s_bus_stats_t      flush;         ///< Cost of the flush in progress.
+    uc1601s_bus_stats_t      frame;         ///< Cost of the completed flushes of the current frame.
+    uc1601s_bus_stats_t      last_frame;    ///< Cost of the last completed frame.
+    uc1601s_bus_stats_t      worst_frame;   ///< Most expensive completed frame.
+    uc1601s_bus_stats_t      total;         ///< Cost of all traffic since init.
+    uc1601s_frame_callback_t on_frame;
+    void                    *on_frame_arg;
+};
+
+/**
+ * @brief  Power on the controller.
+ *
+ * @param [in] self - Instance to initialize.
+ * @param [in] bitrate - SPI bitrate used for the bus time figures.
+ * @param [in] on_frame - Frame completion callback, may be NULL.
+ * @param [in] arg - Callback argument.
+ */
+void uc1601s_init(uc1601s_t *self, uint32_t bitrate, uc1601s_frame_callback_t on_frame, void *arg);
+
+/**
+ * @brief  Consume SPI frames. Same shape as host_spi_sink_t so it can be plugged in the LCD SPI fake directly.
+ *
+ * @param [in] arg - Emulator instance.
+ * @param [in] frames - 9-bit frames.
+ * @param [in] count - Number of frames.
+ */
+void uc1601s_write(void *arg, const uint16_t *frames, size_t count);
+
+/**
+ * @brief  Close the current frame early, e.g. at the end of a scenario. Does nothing when no data was written.
+ *
+ * @param [in] self - Emulator instance.
+ */
+void uc1601s_end_frame(uc1601s_t *self);
+
+/**
+ * @brief  What the panel shows: display RAM seen through scroll, partial display, inverse, all-on and enable.
+ *
+ * Columns follow RAM order: the MX mapping set by lcd_init() only compensates for the way the glass is mounted.
+ *
+ * @param [in] self - Emulator instance.
+ * @param [out] image - Page major image, same layout as the lcd.c line buffer (bit 0 is the top row of a page).
+ */
+void uc1601s_get_image(const uc1601s_t *self, uint8_t image[UC1601S_PANEL_PAGES][UC1601S_PANEL_COLUMNS]);
+
+/**
+ * @brief  One pixel of the panel image.
+ *
+ * @param [in] self - Emulator instance.
+ * @param [in] x - Column, 0 to UC1601S_PANEL_COLUMNS - 1.
+ * @param [in] y - Row, 0 to UC1601S_PANEL_PAGES * 8 - 1.
+ * @return True when the pixel is dark.
+ */
+bool uc1601s_get_pixel(const uc1601s_t *self, uint8_t x, uint8_t y);
+
+/**
+ * @brief  Bus efficiency: share of the frames that carry display data, in percent.
+ *
+ * @param [in] stats - Bus cost to rate.
+ */
+uint32_t uc1601s_efficiency(const uc1601s_bus_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HOST_UC1601S_INC_UC1601S_H_ */
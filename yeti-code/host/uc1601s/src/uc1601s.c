@@ -0,0 +1,415 @@
+/** @file uc1601s.c
+ *
+ * @brief Virtual UC1601s: decodes the 9-bit SPI stream of lcd.c into display RAM and measures the bus cost of every frame.
+ *
+ * @author Rene Delgado
+ *
+ * @copyright 2023 The Chamberlain Group, LLC. All rights reserved. All
+ * information within this file and associated files, including all
+ * information and files transmitted with this file are CONFIDENTIAL
+ * and the proprietary property of The Chamberlain Group, LLC.
+ *
+ * In using the Licensed Software, Company shall not use with, combine, or
+ * incorporate any viral open source software with or into any of the Licensed
+ * Software in a manner that would require any portion of the Licensed software to
+ * be (i) disclosed or distributed in source code form; (ii) licensed for the
+ * purpose of making derivative works; or (iii) distributable or redistributable
+ * at no charge.
+ */
+
+#include <string.h>
+
+#include "uc1601s.h"
+
+#define UC1601S_FRAME_BITS (9U)
+#define UC1601S_NS_IN_S (1000000000ULL)
+#define UC1601S_PAGE_ROWS (8U)
+#define UC1601S_SCROLL_ROWS (64U) ///< Rows the scroll line wraps on, the icon row does not scroll.
+#define UC1601S_PANEL_PAGE_MASK ((uint16_t)((1U << UC1601S_PANEL_PAGES) - 1U))
+
+// Command encodings, see the UC1601s datasheet command table.
+#define UC1601S_CMD_COL_L (0x00U) // 0000 CCCC, CA[3:0]
+#define UC1601S_CMD_COL_H (0x10U) // 0001 CCCC, CA[7:4]
+#define UC1601S_CMD_TC (0x24U)    // 0010 01TT
+#define UC1601S_CMD_POWER (0x28U) // 0010 1PPP
+#define UC1601S_CMD_ADV (0x30U)   // 0011 000R + parameter
+#define UC1601S_CMD_SL (0x40U)    // 01SS SSSS
+#define UC1601S_CMD_BIAS (0x81U)  // 1000 0001 + parameter
+#define UC1601S_CMD_PART (0x84U)  // 1000 010L
+#define UC1601S_CMD_RAMA (0x88U)  // 1000 1AAA
+#define UC1601S_CMD_FR (0xA0U)    // 1010 000L
+#define UC1601S_CMD_PON (0xA4U)   // 1010 010D
+#define UC1601S_CMD_INV (0xA6U)   // 1010 011D
+#define UC1601S_CMD_EN (0xAEU)    // 1010 111D
+#define UC1601S_CMD_PAGE (0xB0U)  // 1011 PPPP
+#define UC1601S_CMD_MAP (0xC0U)   // 1100 0MM0
+#define UC1601S_CMD_RESET (0xE2U)
+#define UC1601S_CMD_NOP (0xE3U)
+#define UC1601S_CMD_TEST (0xE4U) // 1110 01TT + parameter
+#define UC1601S_CMD_BR (0xE8U)   // 1110 10BB
+#define UC1601S_CMD_CEN (0xF1U)  // + parameter
+#define UC1601S_CMD_DST (0xF2U)  // + parameter
+#define UC1601S_CMD_DEN (0xF3U)  // + parameter
+
+#define UC1601S_AC_WA (0x01U)  // AC[0], wrap around
+#define UC1601S_AC_AIO (0x02U) // AC[1], page first auto increment
+#define UC1601S_AC_PID (0x04U) // AC[2], page decrement
+
+static uint64_t uc1601s_frame_ns(const uc1601s_t *self, uint32_t frames)
+{
+    return ((uint64_t)frames * UC1601S_FRAME_BITS * UC1601S_NS_IN_S) / self->bitrate;
+}
+
+static void uc1601s_reset(uc1601s_t *self)
+{
+    self->page          = 0;
+    self->column        = 0;
+    self->pending_param = 0;
+    self->display       = (uc1601s_display_t){.enabled       = false,
+                                              .all_on        = false,
+                                              .inverse       = false,
+                                              .partial       = false,
+                                              .scroll_line   = 0,
+                                              .partial_start = 0,
+                                              .partial_end   = UC1601S_SCROLL_ROWS - 1U,
+                                              .com_end       = UC1601S_SCROLL_ROWS - 1U,
+                                              .mapping       = 0,
+                                              .ram_control   = UC1601S_AC_WA,
+                                              .bias_ratio    = 3,
+                                              .vbias         = 0x40,
+                                              .temp_comp     = 0,
+                                              .power_control = 0x06,
+                                              .frame_rate    = 0};
+}
+
+typedef enum
+{
+    UC1601S_FRAME_ADDRESS,
+    UC1601S_FRAME_COMMAND,
+    UC1601S_FRAME_DATA,
+} uc1601s_frame_kind_e;
+
+static void uc1601s_count_in(const uc1601s_t *self, uc1601s_bus_stats_t *stats, uc1601s_frame_kind_e kind)
+{
+    switch(kind)
+    {
+        case UC1601S_FRAME_ADDRESS:
+            stats->address_frames++;
+            break;
+        case UC1601S_FRAME_COMMAND:
+            stats->command_frames++;
+            break;
+        default:
+            stats->data_frames++;
+            break;
+    }
+    stats->bus_ns = uc1601s_frame_ns(self, stats->address_frames + stats->command_frames + stats->data_frames);
+}
+
+// Accounts one SPI frame to the flush in progress and to the totals.
+static void uc1601s_count(uc1601s_t *self, uc1601s_frame_kind_e kind)
+{
+    uc1601s_count_in(self, &self->flush, kind);
+    uc1601s_count_in(self, &self->total, kind);
+}
+
+static void uc1601s_close_frame(uc1601s_t *self)
+{
+    self->frames++;
+    self->last_frame = self->frame;
+    if(self->frame.bus_ns > self->worst_frame.bus_ns)
+    {
+        self->worst_frame = self->frame;
+    }
+    self->frame         = (uc1601s_bus_stats_t){0};
+    self->pages_written = 0;
+
+    if(NULL != self->on_frame)
+    {
+        self->on_frame(self->on_frame_arg, self, &self->last_frame);
+    }
+}
+
+// Moves the flush in progress into the current frame.
+static void uc1601s_close_flush(uc1601s_t *self)
+{
+    self->frame.address_frames += self->flush.address_frames;
+    self->frame.command_frames += self->flush.command_frames;
+    self->frame.data_frames += self->flush.data_frames;
+    self->frame.bus_ns += self->flush.bus_ns;
+    self->pages_written |= self->flush_pages;
+    self->flush       = (uc1601s_bus_stats_t){0};
+    self->flush_pages = 0;
+}
+
+static void uc1601s_advance(uc1601s_t *self)
+{
+    const uint8_t ac         = self->display.ram_control;
+    const int8_t  page_step  = (0U != (ac & UC1601S_AC_PID)) ? -1 : 1;
+    bool          column_end = false;
+    bool          page_end   = false;
+
+    if(0U == (ac & UC1601S_AC_AIO))
+    {
+        // Column first.
+        column_end = (self->column >= (UC1601S_RAM_COLUMNS - 1U));
+        if(!column_end)
+        {
+            self->column++;
+        }
+        else if(0U != (ac & UC1601S_AC_WA))
+        {
+            self->column = 0;
+            self->page   = (uint8_t)((self->page + UC1601S_RAM_PAGES + page_step) % UC1601S_RAM_PAGES);
+        }
+    }
+    else
+    {
+        // Page first.
+        page_end = (page_step > 0) ? (self->page >= (UC1601S_RAM_PAGES - 1U)) : (0U == self->page);
+        if(!page_end)
+        {
+            self->page = (uint8_t)(self->page + page_step);
+        }
+        else if(0U != (ac & UC1601S_AC_WA))
+        {
+            self->page   = (page_step > 0) ? 0U : (uint8_t)(UC1601S_RAM_PAGES - 1U);
+            self->column = (uint8_t)((self->column + 1U) % UC1601S_RAM_COLUMNS);
+        }
+    }
+}
+
+static void uc1601s_data(uc1601s_t *self, uint8_t data)
+{
+    uc1601s_count(self, UC1601S_FRAME_DATA);
+
+    if((self->page < UC1601S_RAM_PAGES) && (self->column < UC1601S_RAM_COLUMNS))
+    {
+        const uint16_t page_bit = (uint16_t)(1U << self->page);
+
+        if(data != self->ram[self->page][self->column])
+        {
+            self->ram_changes++;
+        }
+        self->ram[self->page][self->column] = data;
+
+        // Rewriting a page the current frame already flushed starts the next frame.
+        if(0U != (self->pages_written & page_bit))
+        {
+            uc1601s_close_frame(self);
+        }
+        self->flush_pages |= page_bit;
+    }
+    uc1601s_advance(self);
+}
+
+static void uc1601s_parameter(uc1601s_t *self, uint8_t param)
+{
+    switch(self->pending_param)
+    {
+        case UC1601S_CMD_BIAS:
+            self->display.vbias = param;
+            break;
+        case UC1601S_CMD_CEN:
+            self->display.com_end = param & 0x7FU;
+            break;
+        case UC1601S_CMD_DST:
+            self->display.partial_start = param & 0x7FU;
+            break;
+        case UC1601S_CMD_DEN:
+            self->display.partial_end = param & 0x7FU;
+            break;
+        default:
+            // Advanced program control and test control do not change the picture.
+            break;
+    }
+    self->pending_param = 0;
+}
+
+static void uc1601s_command(uc1601s_t *self, uint8_t cmd)
+{
+    if(0U != self->pending_param)
+    {
+        uc1601s_count(self, UC1601S_FRAME_COMMAND);
+        uc1601s_parameter(self, cmd);
+        return;
+    }
+
+    if(UC1601S_CMD_COL_L == (cmd & 0xF0U))
+    {
+        uc1601s_count(self, UC1601S_FRAME_ADDRESS);
+        self->column = (uint8_t)((self->column & 0xF0U) | (cmd & 0x0FU));
+        return;
+    }
+    if(UC1601S_CMD_COL_H == (cmd & 0xF0U))
+    {
+        uc1601s_count(self, UC1601S_FRAME_ADDRESS);
+        self->column = (uint8_t)((self->column & 0x0FU) | ((cmd & 0x0FU) << 4));
+        return;
+    }
+    if(UC1601S_CMD_PAGE == (cmd & 0xF0U))
+    {
+        uc1601s_count(self, UC1601S_FRAME_ADDRESS);
+        self->page = cmd & 0x0FU;
+        return;
+    }
+
+    uc1601s_count(self, UC1601S_FRAME_COMMAND);
+
+    if(UC1601S_CMD_SL == (cmd & 0xC0U))
+    {
+        self->display.scroll_line = cmd & 0x3FU;
+    }
+    else if(UC1601S_CMD_TC == (cmd & 0xFCU))
+    {
+        self->display.temp_comp = cmd & 0x03U;
+    }
+    else if(UC1601S_CMD_POWER == (cmd & 0xF8U))
+    {
+        self->display.power_control = cmd & 0x07U;
+    }
+    else if(UC1601S_CMD_ADV == (cmd & 0xFEU) || UC1601S_CMD_TEST == (cmd & 0xFCU) || UC1601S_CMD_BIAS == cmd ||
+            UC1601S_CMD_CEN == cmd || UC1601S_CMD_DST == cmd || UC1601S_CMD_DEN == cmd)
+    {
+        self->pending_param = cmd;
+    }
+    else if(UC1601S_CMD_PART == (cmd & 0xFEU))
+    {
+        self->display.partial = (0U != (cmd & 0x01U));
+    }
+    else if(UC1601S_CMD_RAMA == (cmd & 0xF8U))
+    {
+        self->display.ram_control = cmd & 0x07U;
+    }
+    else if(UC1601S_CMD_FR == (cmd & 0xFEU))
+    {
+        self->display.frame_rate = cmd & 0x01U;
+    }
+    else if(UC1601S_CMD_PON == (cmd & 0xFEU))
+    {
+        self->display.all_on = (0U != (cmd & 0x01U));
+    }
+    else if(UC1601S_CMD_INV == (cmd & 0xFEU))
+    {
+        self->display.inverse = (0U != (cmd & 0x01U));
+    }
+    else if(UC1601S_CMD_EN == (cmd & 0xFEU))
+    {
+        self->display.enabled = (0U != (cmd & 0x01U));
+        if(self->display.enabled && (0U != self->flush.data_frames))
+        {
+            uc1601s_close_flush(self);
+            if(UC1601S_PANEL_PAGE_MASK == (self->pages_written & UC1601S_PANEL_PAGE_MASK))
+            {
+                uc1601s_close_frame(self);
+            }
+        }
+    }
+    else if(UC1601S_CMD_MAP == (cmd & 0xF0U))
+    {
+        self->display.mapping = cmd & 0x06U;
+    }
+    else if(UC1601S_CMD_RESET == cmd)
+    {
+        self->resets++;
+        uc1601s_reset(self);
+    }
+    else if(UC1601S_CMD_BR == (cmd & 0xFCU))
+    {
+        self->display.bias_ratio = cmd & 0x03U;
+    }
+    else if(UC1601S_CMD_NOP != cmd)
+    {
+        self->unknown++;
+    }
+}
+
+void uc1601s_init(uc1601s_t *self, uint32_t bitrate, uc1601s_frame_callback_t on_frame, void *arg)
+{
+    memset(self, 0, sizeof(*self));
+    self->bitrate      = bitrate;
+    self->on_frame     = on_frame;
+    self->on_frame_arg = arg;
+    uc1601s_reset(self);
+}
+
+void uc1601s_end_frame(uc1601s_t *self)
+{
+    uc1601s_close_flush(self);
+    if(0U != self->pages_written)
+    {
+        uc1601s_close_frame(self);
+    }
+}
+
+void uc1601s_write(void *arg, const uint16_t *frames, size_t count)
+{
+    uc1601s_t *self = (uc1601s_t *)arg;
+
+    for(size_t i = 0; i < count; i++)
+    {
+        if(0U != (frames[i] & UC1601S_FRAME_CD))
+        {
+            uc1601s_data(self, (uint8_t)frames[i]);
+        }
+        else
+        {
+            uc1601s_command(self, (uint8_t)frames[i]);
+        }
+    }
+}
+
+bool uc1601s_get_pixel(const uc1601s_t *self, uint8_t x, uint8_t y)
+{
+    const uc1601s_display_t *display = &self->display;
+    uint8_t                  row;
+    bool                     pixel;
+
+    if(!display->enabled || (x >= UC1601S_PANEL_COLUMNS) || (y >= (UC1601S_PANEL_PAGES * UC1601S_PAGE_ROWS)))
+    {
+        return false;
+    }
+    if(display->partial && ((y < display->partial_start) || (y > display->partial_end)))
+    {
+        return false;
+    }
+
+    if(display->all_on)
+    {
+        pixel = true;
+    }
+    else
+    {
+        row   = (uint8_t)((y + display->scroll_line) % UC1601S_SCROLL_ROWS);
+        pixel = (0U != (self->ram[row / UC1601S_PAGE_ROWS][x] & (1U << (row % UC1601S_PAGE_ROWS))));
+    }
+
+    return pixel != display->inverse;
+}
+
+void uc1601s_get_image(const uc1601s_t *self, uint8_t image[UC1601S_PANEL_PAGES][UC1601S_PANEL_COLUMNS])
+{
+    for(uint8_t page = 0; page < UC1601S_PANEL_PAGES; page++)
+    {
+        for(uint8_t x = 0; x < UC1601S_PANEL_COLUMNS; x++)
+        {
+            uint8_t byte = 0;
+
+            for(uint8_t bit = 0; bit < UC1601S_PAGE_ROWS; bit++)
+            {
+                if(uc1601s_get_pixel(self, x, (uint8_t)((page * UC1601S_PAGE_ROWS) + bit)))
+                {
+                    byte |= (uint8_t)(1U << bit);
+                }
+            }
+            image[page][x] = byte;
+        }
+    }
+}
+
+uint32_t uc1601s_efficiency(const uc1601s_bus_stats_t *stats)
+{
+    uint32_t frames = stats->address_frames + stats->command_frames + stats->data_frames;
+
+    return (0U != frames) ? (uint32_t)(((uint64_t)stats->data_frames * 100U) / frames) : 0U;
+}
@@ -13,9 +13,10 @@ extern "C"
  * @brief  UART tx generic callback.
  *
  * @param [out] status - Status of transmission.
+ * @param [out] data - Pointer to the transmitted data.
  * @param [out] size - Lenght of transmited data.
  */
-typedef uint8_t (*callback_transmit_t)(uint8_t status, size_t size);
+typedef uint8_t (*callback_transmit_t)(uint8_t status, uint8_t *data, size_t size);
 /**
  * @brief  UART rx generic callback.
  *
@@ -0,0 +1,46 @@
+/** @file cycle_counter.h
+ *
+ * @brief Free running core cycle counter Interfaces library
+ *
+ * @author Rene Delgado
+ *
+ * @copyright 2023 The Chamberlain Group, LLC. All rights reserved. All
+ * information within this file and associated files, including all
+ * information and files transmitted with this file are CONFIDENTIAL
+ * and the proprietary property of The Chamberlain Group, LLC.
+ *
+ * In using the Licensed Software, Company shall not use with, combine, or
+ * incorporate any viral open source software with or into any of the Licensed
+ * Software in a manner that would require any portion of the Licensed software to
+ * be (i) disclosed or distributed in source code form; (ii) licensed for the
+ * purpose of making derivative works; or (iii) distributable or redistributable
+ * at no charge.
+ */
+
+#ifndef CYCLE_COUNTER_WRAPPER_H_
+#define CYCLE_COUNTER_WRAPPER_H_
+
+#include <stdint.h>
+
+#ifdef  __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @brief  Start the free running counter.
+ */
+void cycle_counter_init(void);
+
+/**
+ * @brief  Current count. The counter wraps at 32 bits, the difference of two reads stays valid across one wrap.
+ *
+ * @return Core clock cycles on target, nanoseconds on the host build.
+ */
+uint32_t cycle_counter_read(void);
+
+#ifdef  __cplusplus
+}
+#endif
+
+#endif /* CYCLE_COUNTER_WRAPPER_H_ */
@@ -0,0 +1,34 @@
+/** @file cycle_counter.c
+ *
+ * @brief Free running core cycle counter: Cortex-M33 DWT CYCCNT
+ *
+ * @author Rene Delgado
+ *
+ * @copyright 2023 The Chamberlain Group, LLC. All rights reserved. All
+ * information within this file and associated files, including all
+ * information and files transmitted with this file are CONFIDENTIAL
+ * and the proprietary property of The Chamberlain Group, LLC.
+ *
+ * In using the Licensed Software, Company shall not use with, combine, or
+ * incorporate any viral open source software with or into any of the Licensed
+ * Software in a manner that would require any portion of the Licensed software to
+ * be (i) disclosed or distributed in source code form; (ii) licensed for the
+ * purpose of making derivative works; or (iii) distributable or redistributable
+ * at no charge.
+ */
+
+#include "em_device.h"
+#include "cycle_counter.h"
+
+void cycle_counter_init(void)
+{
+    // The DWT only counts with trace enabled. CYCCNT runs from SYSCLK, it stops while the core sleeps.
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+uint32_t cycle_counter_read(void)
+{
+    return DWT->CYCCNT;
+}
@@ -29,7 +29,6 @@ void debug_uart_non_blocking_tx_callback(struct UARTDRV_HandleData *handle,
                                          UARTDRV_Count_t            transferCount)
 {
     (void)handle;
-    (void)data;
     uint8_t status = 0;
 
     if(debug_uart_tx_callback)
@@ -38,7 +37,7 @@ void debug_uart_non_blocking_tx_callback(struct UARTDRV_HandleData *handle,
         {
             status = 1;
         }
-        debug_uart_tx_callback(status, transferCount);
+        debug_uart_tx_callback(status, data, transferCount);
     }
 }
 
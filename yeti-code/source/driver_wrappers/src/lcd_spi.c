@@ -17,11 +17,13 @@
  * at no charge.
  */
 
+#include "em_core.h"
 #include "sl_spidrv_instances.h"
 #include "lcd_spi.h"
 
 static callback_transmit_t lcd_spi_tx_callback;
 static callback_receive_t  lcd_spi_rx_callback;
+static uint8_t            *lcd_spi_tx_buffer; // Buffer handed back to the tx callback
 
 static uint8_t **rx_buffer; // Address of the return pointer
 
@@ -36,7 +38,7 @@ void lcd_spi_non_blocking_tx_callback(struct SPIDRV_HandleData *handle, Ecode_t
 
     if(lcd_spi_tx_callback)
     {
-        lcd_spi_tx_callback(status, (uint8_t)itemsTransferred);
+        lcd_spi_tx_callback(status, lcd_spi_tx_buffer, (uint8_t)itemsTransferred);
     }
 }
 
@@ -58,9 +60,20 @@ void lcd_spi_non_blocking_rx_callback(struct SPIDRV_HandleData *handle, Ecode_t
 
 uint8_t lcd_spi_non_blocking_tx(void *self, const uint8_t *buff, size_t size, callback_transmit_t callback)
 {
-    uint8_t retval      = 0;
-    lcd_spi_tx_callback = callback;
-    uint32_t res        = SPIDRV_MTransmit((SPIDRV_Handle_t)self, (void *)buff, size, lcd_spi_non_blocking_tx_callback);
+    uint8_t  retval = 0;
+    uint32_t res;
+    CORE_DECLARE_IRQ_STATE;
+
+    // A refused transfer leaves the callback of the one in flight in place: the completion can not run before the
+    // accepted transfer claims it, it waits for the end of the atomic section
+    CORE_ENTER_ATOMIC();
+    res = SPIDRV_MTransmit((SPIDRV_Handle_t)self, (void *)buff, size, lcd_spi_non_blocking_tx_callback);
+    if(ECODE_OK == res)
+    {
+        lcd_spi_tx_callback = callback;
+        lcd_spi_tx_buffer   = (uint8_t *)buff;
+    }
+    CORE_EXIT_ATOMIC();
 
     if(ECODE_OK != res)
     {
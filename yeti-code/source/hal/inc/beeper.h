@@ -55,6 +55,8 @@ typedef struct beeper_config
     volatile uint32_t num_of_cycles;
     volatile uint32_t time_on;
     volatile uint32_t time_off;
+    uint32_t          time_on_reset;  ///< time_on restarted on every cycle.
+    uint32_t          time_off_reset; ///< time_off restarted on every cycle.
     beeper_timer_t    timer;
 
 } beeper_config_t;
@@ -82,6 +84,14 @@ typedef struct beeper_handle
  */
 uint32_t beeper_init_handle(beeper_t *handle);
 
+/**
+ * @brief  Beeper timer tick, called on every overflow of the beeper timer.
+ * The TIMER2 IRQ ticks the beeper whose timer is TIMER2.
+ *
+ * @param[in] self - Beeper to tick.
+ */
+void beeper_timer_tick(beeper_t *const self);
+
 #ifdef __cplusplus
 }
 #endif
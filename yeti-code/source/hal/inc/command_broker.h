@@ -25,6 +25,7 @@
 #ifndef HAL_INC_COMMAND_BROKER_H_
 #define HAL_INC_COMMAND_BROKER_H_
 
+#include <stdbool.h>
 #include <stdint.h>
 #include "base_sercomm_driver.h"
 
@@ -49,6 +50,33 @@ extern "C"
 #define CB_BUZ_CTRL_DATA1_BEEPER_ON_STEP (128)  ///< Beeper ON in 128 milliseconds counts.
 #define CB_BUZ_CTRL_DATA2_BEEPER_OFF_STEP (128) ///< Beeper OFF in 128 milliseconds counts.
 
+#define CB_REQUEST_BUFF_SIZE (3)  ///< Max Rx buffer size.
+#define CB_NIBBLES_IN_A_BYTE (2)  ///< Nibbles in a byte.
+
+#define CB_BYTES_IN_FRAME (2)         ///< Expected frame bytes in binary format (<STX>, <ETX>).
+#define CB_BYTES_IN_PACKET_NUMBER (1) ///< Packet number max binary data size.
+#define CB_BYTES_IN_CMD_ID (1)        ///< Packet number max binary data size.
+#define CB_BYTES_IN_CRC16_ARC (2)     ///< CRC16 ARC binary data size.
+
+#define CB_RX_BYTES_IN_READ_KEYS_DATA (1) ///< Read keys request command max binary data size.
+#define CB_RX_BYTES_IN_WRITE_LINE_DATA \
+    (CB_BYTES_IN_WRITE_LINE_DATA)            ///< Write line request command max binary data size.
+#define CB_RX_BYTES_IN_SET_BGLIGHT_DATA (1)  ///< Set backlight request command max binary data size.
+#define CB_RX_BYTES_IN_CLEAR_DATA (0)        ///< Clear request command max binary data size.
+#define CB_RX_BYTES_IN_SET_LANGUAGE_DATA (1) ///< Set language request command max binary data size.
+#define CB_RX_BYTES_IN_GET_VERSION_DATA (0)  ///< Get version request command max binary data size.
+#define CB_RX_BYTES_IN_BUZ_PARAM_DATA (2)    ///< Buz param request command max binary data size.
+#define CB_RX_BYTES_IN_BUZ_CTRL_DATA (3)     ///< Buz ctrl request command max binary data size.
+
+#define CB_TX_BYTES_IN_READ_KEYS_DATA (1)    ///< Read keys response command max binary data size.
+#define CB_TX_BYTES_IN_WRITE_LINE_DATA (0)   ///< Write line response command max binary data size.
+#define CB_TX_BYTES_IN_SET_BGLIGHT_DATA (0)  ///< Set backlight response command max binary data size.
+#define CB_TX_BYTES_IN_CLEAR_DATA (0)        ///< Clear response max command binary data size.
+#define CB_TX_BYTES_IN_SET_LANGUAGE_DATA (0) ///< Set language response command max binary data size.
+#define CB_TX_BYTES_IN_GET_VERSION_DATA (2)  ///< Get version response command max binary data size.
+#define CB_TX_BYTES_IN_BUZ_PARAM_DATA (2)    ///< Buz param response command max binary data size.
+#define CB_TX_BYTES_IN_BUZ_CTRL_DATA (0)     ///< Buz ctrl response command max binary data size.
+
 /********************************************* COMMON PROTOCOL ENUMS *************************************************/
 
 /**
@@ -313,21 +341,147 @@ typedef union cbroker_response_data
 /**
  * @brief  Command Broker request callback.
  *
+ * @param [in] arg - Argument given to cbroker_init().
  * @param [in] command_id - Command id without status bits.
  * @param [in] payload - Data payload from request command.
  * @param [out] output - Data payload for response command.
  */
-typedef void (*cbroker_request_callback_t)(cbroker_cmd_id_e                    cmd_id,
+typedef void (*cbroker_request_callback_t)(void                               *arg,
+                                           cbroker_cmd_id_e                    cmd_id,
                                            const cbroker_request_data_t *const payload,
                                            cbroker_response_data_t *const      output);
 
+/********************************************** COMMAND BROKER CONTEXT ***********************************************/
+
+/**
+ * @brief Acknowledge states.
+ */
+typedef enum
+{
+    CB_ACK_NOT_READY = 0x00, ///< There is no data in the current request (RX) buffer to respond to the main board.
+    CB_ACK_TO_BE_SEND,       ///< Enough data to create a response command to the main board.
+    CB_ACK_SENDING,          ///< The TX callback (ISR) is consuming the response buffer.
+    CB_ACK_SENT,             ///< The ETX byte is ready to be sent.
+    CB_ACK_MAX,              ///<
+
+} cbroker_ack_status_e;
+
+/**
+ * @brief States of request Command Broker finite state machine.
+ * These states are called every time there is an rxByte on the sercomm.
+ */
+typedef enum
+{
+    CB_RX_IDLE_STATE,                   ///< Idle_state.
+    CB_RX_VALIDATE_FRAME_STATE,         ///< Validate frame.
+    CB_RX_VALIDATE_PACKET_NUMBER_STATE, ///< Validate packet number.
+    CB_RX_VALIDATE_CMD_ID_STATE,        ///< Validate cmd id.
+    CB_RX_VALIDATE_PAYLOAD_STATE,       ///< Validate payload.
+    CB_RX_VALIDATE_CRC_STATE,           ///< Validate crc.
+    CB_RX_MAX_STATE                     ///<
+} cbroker_rx_system_state_e;
+
+/***************************************  REQUEST (RX) STRUCTS AND UNIONS ******************************************/
+
+/**
+ * @brief Binary representation of request command.
+ */
+typedef struct cbroker_request_msg_format
+{
+    uint8_t                 stx;            ///< Start of Transmission Character.
+    uint8_t                 packet_number;  ///< Packet Number (increments 00 to FF).
+    cbroker_cmd_id_format_t cmd;            ///< Command ID.
+    cbroker_request_data_t  data;           ///< Buffer for each request command's data.
+    uint16_t                crc16_received; ///< CRC16 (over Packet Number to end of Data)
+    uint8_t                 etx;            ///< End of Transmission Character.
+
+} cbroker_request_msg_format_t;
+
+/*************************************** COMMAND BROKER STRUCTS AND UNIONS ******************************************/
+
+/**
+ * @brief Data used by Command Broker to link the crc16 and ACK status for each request (Rx).
+ */
+typedef struct cbroker_rx_data
+{
+    uint16_t                     crc16_calc; ///< CRC16 (over Packet Number to end of Data).
+    cbroker_request_msg_format_t buff;       ///< Binary representation of incoming request command.
+    cbroker_ack_status_e         ack_status; ///< ACK status.
+} cbroker_rx_data_t;
+
+/**
+ * @brief Data used by Command Broker to handle request (Rx) commands.
+ */
+typedef struct cbroker_request
+{
+    uint8_t                    index;                    ///< Current request buffer index.
+    cbroker_rx_system_state_e  next_state;               ///< Next state for request state machine.
+    uint8_t                    rxbyte;                   ///< Rxbyte from serial communication driver.
+    cbroker_request_callback_t callback;                 ///<  Function pointer called in valid request commands.
+    void                      *arg;                      ///< Argument passed to the request callback.
+    cbroker_rx_data_t          data[CB_REQUEST_BUFF_SIZE];
+    uint8_t                    remaining_frame_bytes;    ///< Frame bytes (<STX>, <ETX>) still expected.
+    uint8_t                    remaining_pn_nibbles;     ///< Packet number nibbles still expected.
+    uint8_t                    remaining_cmd_id_nibbles; ///< Command id nibbles still expected.
+    cbroker_cmd_id_e           cmd_id_bits;              ///< Command id being received.
+    uint8_t                    nibbles_to_shiff;         ///< Payload nibble being received (1: MSN, 0: LSN).
+    uint8_t                    saved_bytes_cnt;          ///< Payload bytes already received.
+    uint8_t                    remaining_crc_nibbles;    ///< CRC16 nibbles still expected.
+} cbroker_request_t;
+
+/**
+ * @brief Response states.
+ */
+typedef struct cbroker_tx_state_machine
+{
+    bool is_transmiting;
+
+} cbroker_tx_state_machine_t;
+
+/**
+ * @brief Data used by Command Broker to handle response (Tx) commands.
+ */
+typedef struct cbroker_response
+{
+    uint8_t                    index;            ///< Current responding buffer index.
+    cbroker_tx_state_machine_t state_machine;    ///< Response states.
+    uint8_t                    txByte;           ///< Txbyte for serial communication driver.
+    cbroker_response_data_t    bin_data;         ///< Reserved bytes for each response command's data.
+    uint16_t                   crc16_calc;       ///< CRC16 (over Packet Number to end of Data)
+    uint8_t                    transmited_bytes; ///< Response bytes already handed to the driver.
+    // clang-format off
+    uint8_t buff[
+                           (CB_BYTES_IN_FRAME) +
+                           (CB_NIBBLES_IN_A_BYTE * CB_BYTES_IN_PACKET_NUMBER) +
+                           (CB_NIBBLES_IN_A_BYTE * CB_BYTES_IN_CMD_ID ) +
+                           (CB_NIBBLES_IN_A_BYTE * CB_TX_BYTES_IN_BUZ_PARAM_DATA ) + /*Max response data size element.*/
+                           (CB_NIBBLES_IN_A_BYTE * CB_BYTES_IN_CRC16_ARC) 
+                        ] ;
+} cbroker_response_t;
+
+/**
+ * @brief Main Command Broker Struct.
+ */
+typedef struct cbroker
+{
+    cbroker_request_t  request; ///< Data used by Command Broker to handle request (Rx) commands.
+    cbroker_response_t response; ///< Data used by Command Broker to handle response (Tx) commands.
+    base_driver        *sercomm; ///<Pointer to structure represents, base serial communication driver.
+} cbroker_t;
+
+
 /**
  * @brief  Command Brocker init.
  *
+ * Every broker keeps its whole state in self, so several brokers can run side by side, each one on its own
+ * serial communication driver.
+ *
+ * @param[out] self - Command Broker instance.
  * @param[in] sercomm - Pointer to a structure represents, base serial communication driver.
  * @param[in] callback - Function pointer called in valid request commands.
+ * @param[in] arg - Argument passed to the callback.
  */
-uint8_t cbroker_init(base_driver *sercomm, cbroker_request_callback_t callback);
+uint8_t cbroker_init(cbroker_t *self, base_driver *sercomm, cbroker_request_callback_t callback, void *arg);
 
 #ifdef __cplusplus
 }
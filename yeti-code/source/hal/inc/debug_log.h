@@ -27,7 +27,9 @@ extern "C"
 {
 #endif
 
+#ifndef DEBUG_LOG_ENABLE
 #define DEBUG_LOG_ENABLE (false)
+#endif /* DEBUG_LOG_ENABLE */
 
 #if DEBUG_LOG_ENABLE == true
 #define APP_PRINTF_ENABLE (false)
@@ -37,8 +39,43 @@ extern "C"
 #define LCD_PRINTF_ENABLE (false)
 #endif /* DEBUG_LOG_ENABLE */
 
-uint8_t debug_log_init(base_driver *sercomm);
-void    debug_log_print(const int8_t *format, ...);
+#if DEBUG_LOG_ENABLE == true
+#define DEBUG_LOG_BUFF_SIZE ((size_t)1024)
+#else
+#define DEBUG_LOG_BUFF_SIZE ((size_t)1) ///< Nothing is queued while the logger is disabled.
+#endif /* DEBUG_LOG_ENABLE */
+
+/**
+ * @brief Main Debug Logger Struct.
+ */
+typedef struct debug_log
+{
+    int8_t       buff[DEBUG_LOG_BUFF_SIZE];
+    int32_t      start;           ///<  Read index.
+    int32_t      end;             ///<  Write index.
+    uint8_t      is_transmitting; ///< Flag to indicate if sercomm is transmitting.
+    uint8_t      tx_byte;         ///< Byte being transmitted by sercomm.
+    base_driver *sercomm;         ///< Pointer to structure represents, base serial communication driver.
+} debug_log_t;
+
+/**
+ * @brief  Debug logger init. The last logger initialized is the one used by debug_log_print().
+ *
+ * @param[out] self - Debug logger instance.
+ * @param[in] sercomm - Pointer to a structure represents, base serial communication driver.
+ * @return Zero for no error, otherwise error number.
+ */
+uint8_t debug_log_init(debug_log_t *const self, base_driver *sercomm);
+
+/**
+ * @brief  Queues a formatted message on the given logger.
+ */
+void debug_log_write(debug_log_t *const self, const int8_t *format, ...);
+
+/**
+ * @brief  Queues a formatted message on the default logger.
+ */
+void debug_log_print(const int8_t *format, ...);
 
 #if DEBUG_LOG_ENABLE == true
 
@@ -24,6 +24,7 @@
 
 #include "base_sercomm_driver.h"
 #include "lcd_font_4_22.h"
+#include "sl_sleeptimer.h"
 
 #define LCD_CHAR_RESERVED_FOR_LINE_NUMBER (1)
 #define LCD_CHAR_NUM (20 - LCD_CHAR_RESERVED_FOR_LINE_NUMBER)
@@ -34,12 +35,173 @@
 #define QR_CODE_NUM_COL (45)
 #define QR_CODE_NUM_ROW (6)
 
+#define LCD_BURST_ADDRESS_FRAMES (3) // Page, column LSB and column MSB address commands ahead of a page
+#define LCD_BURST_FRAMES (LCD_BURST_ADDRESS_FRAMES + NUM_PIX_COL_PER_ROW_BYTES + 1) // Worst case: address, whole page, display enable
+
+#define LCD_DIRTY_BLOCK_COLS (8) // Columns per bit of the dirty bitmaps, a page fits a uint16_t
+
+// The build may enable the 4-level grayscale mode, its two planes take 1.5 KB of RAM per display
+#ifndef LCD_GRAY_ENABLE
+#define LCD_GRAY_ENABLE (false)
+#endif /* LCD_GRAY_ENABLE */
+
+#if LCD_GRAY_ENABLE == true
+#define LCD_GRAY_SUBFRAMES (3)    // Sub-frames of a grayscale period, a level is dark in 0 to 3 of them
+#define LCD_GRAY_SUBFRAME_MS (12) // Default sub-frame cadence, close to the 80 fps panel frame rate
+#endif /* LCD_GRAY_ENABLE */
+
+#ifndef LCD_GLYPH_CACHE_BUDGET
+#define LCD_GLYPH_CACHE_BUDGET (2048U) // RAM of the pre-shifted glyphs, an evicted glyph is shifted again on its next draw
+#endif /* LCD_GLYPH_CACHE_BUDGET */
+#define LCD_GLYPH_COLS (8)  // Most drawn columns of a glyph the cache holds, the wider icons are shifted on each draw
+#define LCD_GLYPH_PAGES (3) // Pages a line of up to 16 rows covers, whatever its first row
+
+// Panel bring-up steps of lcd_init(), each one runs from the init timer once the previous delay elapsed
+typedef enum
+{
+    LCD_INIT_POWER_UP = 0, // Waiting for the supply to settle before the reset pulse
+    LCD_INIT_RESET,        // Reset pulse given, waiting for the controller to come out of it
+    LCD_INIT_CONFIGURE,    // Configuration sent, waiting before the display is enabled
+    LCD_INIT_READY         // Display enabled, the flush may run
+} lcd_init_state_e;
+
+// Screen area in pages of 8 rows and columns, an area without pages is empty
+typedef struct
+{
+    uint8_t page;  // First page
+    uint8_t pages; // Number of pages, 0 for none
+    uint8_t col;   // First column
+    uint8_t cols;  // Number of columns
+} lcd_area_t;
+
+// Whole screen effects run by the controller: a command each, the frame buffers are left untouched
+typedef struct
+{
+    bool    inverse;      // Every pixel inverted
+    bool    all_on;       // Every pixel dark, the picture is kept in the panel RAM
+    uint8_t scroll_line;  // Panel RAM row shown on the top row, the rows wrap around the 64 rows of the RAM
+    bool    window;       // Partial display: only the rows of the window are driven, the others stay blank
+    uint8_t window_first; // First row of the window
+    uint8_t window_last;  // Last row of the window
+    bool    contrast_set; // The contrast was adjusted, the panel keeps its reset value until then
+    uint8_t contrast;     // Vbias potentiometer value
+} lcd_effects_t;
+
+// A rendered picture, saved and loaded back whole: its pixels and the text lcd_put_line() compares against
+typedef struct
+{
+    uint8_t pixels[NUM_PIX_ROW_PER_COL_BYTES][NUM_PIX_COL_PER_ROW_BYTES];
+    uint8_t cached_str[LCD_LINE_NUM][LCD_CHAR_NUM];
+} lcd_frame_t;
+
+// A glyph shifted to the rows of a text line: each column as the bytes of the pages the line covers
+typedef struct
+{
+    uint8_t glyph;                                 // Glyph of the font, index in font_glyphs
+    uint8_t shift;                                 // First row of the line
+    uint8_t rows;                                  // Rows of the line
+    uint8_t size;                                  // Drawn columns of the glyph, 0 for an empty slot
+    uint8_t cols[LCD_GLYPH_COLS][LCD_GLYPH_PAGES]; // Page bytes of the columns, from the first page of the line
+} lcd_glyph_t;
+
+#define LCD_GLYPH_CACHE_SLOTS                                                                                          \
+    ((LCD_GLYPH_CACHE_BUDGET >= sizeof(lcd_glyph_t)) ? (LCD_GLYPH_CACHE_BUDGET / sizeof(lcd_glyph_t)) : 1U)
+
 typedef struct lcd_line
 {
     size_t upper_indent;
     size_t height;
 } lcd_line_t;
 
+// Text of a line as last laid out, an update measures and lays out again only the characters it changes
+typedef struct
+{
+    uint16_t width;             // Columns of the characters and of the gaps after those other than a space
+    uint8_t  last;              // Last character other than a space, before the first character when none
+    uint8_t  start;             // Column of the first character gap
+    uint8_t  end;               // Column past the last character
+    uint8_t  pos[LCD_CHAR_NUM]; // Column of the gap before each character
+} lcd_text_t;
+
+typedef struct
+{
+    bool    is_blinking;
+    uint8_t my_char;
+    uint8_t state;
+    uint8_t buffer_shift;
+    uint8_t line_size;
+    uint8_t position;
+} char_context_t;
+
+struct lcd;
+
+/**
+ * @brief Called from interrupt context once lcd_flush_async() sent every changed page
+ *
+ * @param[in] self - display instance
+ *
+ * @param[in] arg - argument given to lcd_flush_async()
+ */
+typedef void (*lcd_flush_callback_t)(struct lcd *self, void *arg);
+
+// One page on the wire as a single 9-bit SPI DMA transfer: the changed columns of the page, addressed once per run
+// and relying on the column auto-increment. The frames must stay untouched until the completion callback
+typedef struct
+{
+    uint16_t             frames[LCD_BURST_FRAMES];
+    uint8_t              page;
+    uint16_t             dirty;        // Dirty blocks of the page on the wire, flagged again if it fails
+    bool                 effects;      // The transfer carries effect commands instead of a page
+    volatile bool        busy;
+    volatile bool        flushing;     // lcd_flush_async() chains the next page from the completion
+    lcd_flush_callback_t callback;     // End of the asynchronous flush
+    void                *callback_arg;
+} lcd_burst_t;
+
+/**
+ * @brief Display instance, it keeps the whole state of one panel
+ */
+typedef struct lcd
+{
+    base_driver                 *sercomm;                                      // Panel serial communication driver
+    lcd_line_t                   layout[LCD_LINE_NUM];                         // Display layout
+    uint8_t                      line_top[LCD_LINE_NUM];                       // First row of each line, from the layout
+    uint8_t                      cached_str[LCD_LINE_NUM][LCD_CHAR_NUM];       // Prevents unwanted line updates
+    uint8_t                      line_rendered;                                // Lines showing the render of cached_str alone, bit per line
+    lcd_text_t                   text[LCD_LINE_NUM];                           // Layout of the text of each rendered line
+    uint8_t                      line_buf[NUM_PIX_ROW_PER_COL_BYTES][NUM_PIX_COL_PER_ROW_BYTES];  // Back buffer, the renderers draw here
+    uint8_t                      front_buf[NUM_PIX_ROW_PER_COL_BYTES][NUM_PIX_COL_PER_ROW_BYTES]; // Last committed frame, the only one the flush reads
+    uint16_t                     line_dirty[NUM_PIX_ROW_PER_COL_BYTES];        // Blocks of line_buf changed since the last commit, bit per block
+    uint16_t                     front_dirty[NUM_PIX_ROW_PER_COL_BYTES];       // Blocks of front_buf committed but not sent yet, bit per block
+#if LCD_GRAY_ENABLE == true
+    uint8_t                      gray_buf[NUM_PIX_ROW_PER_COL_BYTES][NUM_PIX_COL_PER_ROW_BYTES];   // Back gray plane, a set bit gives the pixel the other duty: dark gray when set in line_buf, light gray when clear
+    uint8_t                      gray_pages;                                   // Pages of gray_buf that may hold gray pixels, bit per page
+    uint8_t                      front_gray[NUM_PIX_ROW_PER_COL_BYTES][NUM_PIX_COL_PER_ROW_BYTES]; // Last committed gray plane
+    uint16_t                     gray_blocks[NUM_PIX_ROW_PER_COL_BYTES];       // Blocks of front_gray holding gray pixels, bit per block
+    volatile uint8_t             gray_subframe;                                // Sub-frame the flush composes, 0 shows line_buf alone
+    sl_sleeptimer_timer_handle_t gray_timer;                                   // Sub-frame cadence of the grayscale mode
+    uint32_t                     gray_subframes;                               // Sub-frames scheduled since lcd_gray_start()
+    uint32_t                     gray_late;                                    // Sub-frames due while the previous one was not sent yet
+#endif /* LCD_GRAY_ENABLE */
+    volatile uint8_t             draw_depth;                                   // Open lcd_draw_begin() calls
+    uint8_t                      shadow[NUM_PIX_ROW_PER_COL_BYTES][NUM_PIX_COL_PER_ROW_BYTES]; // Panel RAM as last sent
+    uint8_t                      shadow_valid;                                 // Pages of shadow the panel holds, bit per page
+    char_context_t               blink_tasks[LCD_LINE_NUM];                    // Blinking tasks - 1 per line
+    lcd_glyph_t                  glyph_cache[LCD_GLYPH_CACHE_SLOTS];           // Glyphs pre-shifted to their line, direct mapped
+    sl_sleeptimer_timer_handle_t task_timer_handler;                           // Blinking tasks timer
+    sl_sleeptimer_timer_handle_t init_timer;                                   // Bring-up delays of lcd_init()
+    volatile lcd_init_state_e    init_state;                                   // Bring-up step
+    lcd_effects_t                effects;                                      // Controller effects wanted
+    lcd_effects_t                effects_sent;                                 // Controller effects as last sent
+    bool                         effects_valid;                                // The panel holds effects_sent
+    lcd_area_t                   invert_area;                                  // Area inverted by the commit, local effects only
+    lcd_area_t                   flash_area;                                   // Area lcd_flash() inverts every other period
+    bool                         flash_phase;                                  // The flash area is inverted
+    sl_sleeptimer_timer_handle_t flash_timer;                                  // lcd_flash() period
+    lcd_burst_t                  burst;                                        // Page transfer of the flush
+    uint8_t                      i_lin_s;                                      // Page checked last by the flush
+} lcd_t;
+
 #ifdef __cplusplus
 extern "C"
 {
@@ -49,28 +211,91 @@ extern "C"
 /**
  * @brief Display Init function
  *
+ * Starts the panel bring-up and returns right away: the reset pulse and the configuration are sent from a timer
+ * once their delays elapsed. The screen may be drawn meanwhile, it is flushed once lcd_is_ready()
+ *
+ * @param[in] self - display instance, zero initialized before the first call
+ *
  * @param[in] sercomm_instance - pointer to base serial communication
  *                           driver model instance
  *
+ * @param[in] lcd_layout - display layout, the default layout is kept if 0
+ *
+ */
+void lcd_init(lcd_t *self, base_driver *sercomm_instance, const lcd_line_t *lcd_layout);
+
+/**
+ * @brief Display ready function
+ *
+ * @param[in] self - display instance
+ *
+ * @return true - the bring-up started by lcd_init() is done
+ *         false - otherwise
  */
-void lcd_init(base_driver *sercomm_instance, const lcd_line_t *lcd_layout);
+bool lcd_is_ready(lcd_t *self);
 
 /**
  * @brief Display update function
  *
+ * @param[in] self - display instance
+ *
+ * Checks one page per call and sends it when it changed, as one SPI transfer
+ *
  * @param[in] lcd_status - Ported from old the project flag,
  *                         should be set to true - should be be removed
  *                         in near future
  *
- * @return true - If the screen was updated completely
- *         false - otherwise
+ * @return true - If a changed page was handed to the SPI driver
+ *         false - otherwise, also while the previous page is still on the wire or before lcd_is_ready()
+ */
+bool lcd_update(lcd_t *self, bool lcd_status);
+
+/**
+ * @brief Display asynchronous flush function
+ *
+ * Sends the first changed page and returns, every next changed page is sent from the SPI completion of the previous
+ * one. Pages changed while the flush runs are sent before it ends
+ *
+ * @param[in] self - display instance
+ *
+ * @param[in] callback - called from interrupt context once every page is sent, may be 0
+ *
+ * @param[in] arg - callback argument
+ *
+ * @return true - the flush started, the callback will be called
+ *         false - no page changed, a flush is already running or the panel is not ready yet
+ */
+bool lcd_flush_async(lcd_t *self, lcd_flush_callback_t callback, void *arg);
+
+/**
+ * @brief Display draw begin function
+ *
+ * Opens a frame: the renderers keep drawing into the back buffer and nothing is published to the flush until the
+ * matching lcd_commit(). Frames nest, a draw made from an interrupt inside an open frame is published with it
+ *
+ * @param[in] self - display instance
  */
-bool lcd_update(bool lcd_status);
+void lcd_draw_begin(lcd_t *self);
+
+/**
+ * @brief Display commit function
+ *
+ * Closes a frame opened by lcd_draw_begin(). Closing the outermost one copies the changed pages of the back buffer
+ * to the front buffer with interrupts masked, the flush never sends a half drawn frame
+ *
+ * @param[in] self - display instance
+ *
+ * @return true - the frame was published
+ *         false - an outer frame is still open
+ */
+bool lcd_commit(lcd_t *self);
 
 /**
  * @brief Display set line function, filling specificed buffer line with
  *        provided array of ascii symbols
  *
+ * @param[in] self - display instance
+ *
  * @param[in] str - pointer to provided array of symbols
  *
  * @param[in] size - size of provided array of symbols
@@ -82,7 +307,7 @@ bool lcd_update(bool lcd_status);
  * @return true - line were successfully updated
  *         false - otherwise
  */
-bool lcd_put_line(const uint8_t *str, const size_t size, const uint8_t line, language_e language);
+bool lcd_put_line(lcd_t *self, const uint8_t *str, const size_t size, const uint8_t line, language_e language);
 
 /**
  * @brief Display set big number function, filling all buffer lines with
@@ -105,6 +330,8 @@ bool lcd_put_line(const uint8_t *str, const size_t size, const uint8_t line, lan
  * @brief Display set raw data function, filling specificed buffer line with
  *        raw array data;
  *
+ * @param[in] self - display instance
+ *
  * @param[in] data - value of raw data
  *
  * @param[in] line - specific line to update number (0 - 4)
@@ -114,13 +341,82 @@ bool lcd_put_line(const uint8_t *str, const size_t size, const uint8_t line, lan
  * @return true - line were successfully updated
  *         false - otherwise
  */
-bool lcd_put_raw_data(uint8_t data, uint8_t line, uint8_t offset);
+bool lcd_put_raw_data(lcd_t *self, uint8_t data, uint8_t line, uint8_t offset);
 
+#if LCD_GRAY_ENABLE == true
 /**
- * @brief Display clear function
+ * @brief Display set gray data function, 2 bits per pixel for a column of a page
  *
+ * Levels are 0 white, 1 light, 2 dark and 3 black. They only show while the grayscale mode runs, otherwise light is
+ * white and dark is black
+ *
+ * @param[in] self - display instance
+ *
+ * @param[in] high - high bit of the level of each pixel of the column
+ *
+ * @param[in] low - low bit of the level of each pixel of the column
+ *
+ * @param[in] page - page of the column (0 - 5)
+ *
+ * @param[in] offset - column
+ *
+ * @return true - the column was updated
+ *         false - otherwise
+ */
+bool lcd_put_gray_data(lcd_t *self, uint8_t high, uint8_t low, uint8_t page, uint8_t offset);
+
+/**
+ * @brief Display grayscale start function
+ *
+ * Shows the gray levels by frame rate modulation: every sub-frame, the blocks holding gray pixels are sent again with
+ * the next of LCD_GRAY_SUBFRAMES patterns, and the flush is started from the timer if it is not running. The flush
+ * must be driven by lcd_flush_async(), it is shared with the main loop
+ *
+ * @param[in] self - display instance
+ *
+ * @param[in] subframe_ms - sub-frame cadence, LCD_GRAY_SUBFRAME_MS suits the panel
+ */
+void lcd_gray_start(lcd_t *self, uint32_t subframe_ms);
+
+/**
+ * @brief Display grayscale stop function, the gray blocks are sent once more with the levels rounded to black or white
+ *
+ * @param[in] self - display instance
+ */
+void lcd_gray_stop(lcd_t *self);
+#endif /* LCD_GRAY_ENABLE */
+
+/**
+ * @brief Display clear function, gray levels included. The next lcd_put_line() of each line draws it even with the
+ *        same text
+ *
+ * @param[in] self - display instance
+ *
+ */
+void lcd_clear(lcd_t *self);
+
+/**
+ * @brief Display save frame function, copies the back buffer picture out
+ *
+ * @param[in] self - display instance
+ *
+ * @param[out] frame - saved picture
+ *
+ * @return true - the frame was saved
+ *         false - glyphs are blinking, a saved frame would freeze them
+ */
+bool lcd_save_frame(lcd_t *self, lcd_frame_t *frame);
+
+/**
+ * @brief Display load frame function, replaces the picture as lcd_clear() and the draws that made the frame would
+ *
+ * Only the blocks that differ are copied and flagged, the flush sends the difference
+ *
+ * @param[in] self - display instance
+ *
+ * @param[in] frame - picture saved by lcd_save_frame()
  */
-void lcd_clear();
+void lcd_load_frame(lcd_t *self, const lcd_frame_t *frame);
 
 /**
  * @brief Display turn on backlight function
@@ -136,27 +432,86 @@ void lcd_backlight_on();
 void lcd_backlight_off();
 
 /**
- * @brief Display adjust contrast function
+ * @brief Display adjust contrast function, a controller effect sent by the next flush
+ *
+ * @param[in] self - display instance
  *
  * @param[in] value - desired contrast value (0 - 255)
  *
  */
-void lcd_adjust_contrast(uint8_t value);
+void lcd_adjust_contrast(lcd_t *self, uint8_t value);
+
+/**
+ * @brief Display turns all pixel on function, a controller effect sent by the next flush
+ *
+ * @param[in] self - display instance
+ *
+ */
+void lcd_all_pixels_on(lcd_t *self);
+
+/**
+ * @brief Display turns all pixel off function, the picture held by the panel shows again
+ *
+ * @param[in] self - display instance
+ *
+ */
+void lcd_all_pixels_off(lcd_t *self);
+
+/**
+ * @brief Display invert function
+ *
+ * The whole screen is inverted by the controller with a single command. A smaller area is a local effect: the commit
+ * inverts it on the way to the front buffer and only its blocks are sent. The area stays inverted, later draws too,
+ * until the next call. Stops lcd_flash()
+ *
+ * @param[in] self - display instance
+ *
+ * @param[in] area - area to invert, NULL or no pages for none
+ */
+void lcd_invert(lcd_t *self, const lcd_area_t *area);
+
+/**
+ * @brief Display flash function, inverts an area every other period as lcd_invert() does
+ *
+ * Flashing the whole screen costs one command per period, whatever is drawn
+ *
+ * @param[in] self - display instance
+ *
+ * @param[in] area - area to flash, NULL or no pages to stop
+ *
+ * @param[in] period_ms - time the area stays inverted, then normal, 0 to keep it inverted
+ */
+void lcd_flash(lcd_t *self, const lcd_area_t *area, uint32_t period_ms);
 
 /**
- * @brief Display turns all pixel on function
+ * @brief Display vertical scroll function, a controller effect sent by the next flush
+ *
+ * The frame only fills the first 48 of the 64 panel RAM rows: rows scrolled in past them show what the RAM holds there
+ *
+ * @param[in] self - display instance
  *
+ * @param[in] row - panel RAM row shown on the top row (0 - 63)
  */
-void lcd_all_pixels_on();
+void lcd_scroll(lcd_t *self, uint8_t row);
 
 /**
- * @brief Display turns all pixel off function
+ * @brief Display partial window function, a controller effect sent by the next flush
+ *
+ * Only the rows of the window are driven, the others are blank whatever the frame holds
+ *
+ * @param[in] self - display instance
+ *
+ * @param[in] first_row - first row shown
+ *
+ * @param[in] last_row - last row shown, the window covering every row turns the partial display off
  *
+ * @return true - the window is set
+ *         false - the rows are out of the panel or reversed
  */
-void lcd_all_pixels_off();
+bool lcd_window(lcd_t *self, uint8_t first_row, uint8_t last_row);
 
 
-bool lcd_put_qr_code(uint8_t qr_version_number, uint16_t num, uint8_t offset, uint8_t index, uint8_t contrast);
+bool lcd_put_qr_code(lcd_t *self, uint8_t qr_version_number, uint16_t num, uint8_t offset, uint8_t index, uint8_t contrast);
 
 
 #ifdef __cplusplus
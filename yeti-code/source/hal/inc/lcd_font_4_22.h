@@ -117,15 +117,36 @@ typedef struct big_font_s
 
 typedef uint8_t lcd_character_t[CHAR_PIXEL_HEIGHT];
 
+#define FONT_GLYPH_BLINKING (1U << 0) // The glyph is blanked every other period on a blinking line
+#define FONT_GLYPH_NONE (0xFF)        // font_map entry of a code without a glyph
+#define FONT_CODE_COUNT (256)         // Character codes, font_widths has an entry for each
+
+// A glyph of the packed font, compiled from source/hal/font by tools/font_compiler.py. Its drawn columns are
+// font_columns[offset] onwards, a byte per column with bit 0 on the top row
 typedef struct
 {
-    uint8_t size;
-    uint8_t arr[64];
-    bool    is_blinking;//is blinking icon
-    bool    trimmable;//should be false for aligment icons
-} font_char;
+    uint16_t offset; // First drawn column in font_columns
+    uint8_t  size;   // Width in columns, the trimmed ones included
+    uint8_t  left;   // First drawn column, trimmable icons skip their blank columns
+    uint8_t  right;  // End of the drawn columns
+    uint8_t  flags;  // FONT_GLYPH_ flags
+} font_glyph_t;
+
+#include "lcd_font_packed.h"
 
-extern const font_char *font_array[];
+extern const uint8_t      font_columns[FONT_COLUMN_COUNT];                   // Drawn columns of every glyph
+extern const font_glyph_t font_glyphs[FONT_GLYPH_COUNT];                     // Glyphs of the font
+extern const uint8_t      font_map[FONT_LAST_CODE - FONT_FIRST_CODE + 1];   // Glyph of each code, from FONT_FIRST_CODE
+extern const uint8_t      font_widths[FONT_CODE_COUNT];                      // Drawn columns of each code, a space without glyph
+
+/**
+ * @brief Glyph of a character code
+ *
+ * @param[in] code - character code
+ *
+ * @return the glyph, 0 when the font has none for the code
+ */
+const font_glyph_t *font_glyph(uint8_t code);
 
 
 
@@ -0,0 +1,131 @@
+/** @file perf_probe.h
+ *
+ * @brief Cycle profiling probes - named static slots, dumped through the debug logger
+ *
+ * @author Rene Delgado
+ *
+ * @copyright 2023 The Chamberlain Group, LLC. All rights reserved. All
+ * information within this file and associated files, including all
+ * information and files transmitted with this file are CONFIDENTIAL
+ * and the proprietary property of The Chamberlain Group, LLC.
+ *
+ * In using the Licensed Software, Company shall not use with, combine, or
+ * incorporate any viral open source software with or into any of the Licensed
+ * Software in a manner that would require any portion of the Licensed software to
+ * be (i) disclosed or distributed in source code form; (ii) licensed for the
+ * purpose of making derivative works; or (iii) distributable or redistributable
+ * at no charge.
+ */
+
+#ifndef HAL_INC_PERF_PROBE_H_
+#define HAL_INC_PERF_PROBE_H_
+#include <stdbool.h>
+#include <stdint.h>
+#include "cycle_counter.h"
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// The build may enable the probes, the dump also needs DEBUG_LOG_ENABLE.
+#ifndef PERF_PROBE_ENABLE
+#define PERF_PROBE_ENABLE (false)
+#endif /* PERF_PROBE_ENABLE */
+
+#define PERF_PROBE_DUMP_PERIOD_MS (5000) ///< Statistics dump period of PERF_PROBE_POLL().
+
+/**
+ * @brief Probe slots, one per profiled code path.
+ */
+typedef enum
+{
+    PERF_PROBE_CBROKER_RX_BYTE = 0,   ///< cbroker_rx_byte(), UART RX interrupt.
+    PERF_PROBE_CBROKER_TX_NEXT_BYTE,  ///< cbroker_tx_set_next_byte(), UART TX interrupt.
+    PERF_PROBE_STUFF_FONT,            ///< stuff_font(), renders one LCD text line.
+    PERF_PROBE_LCD_UPDATE,            ///< lcd_update(), one step of the LCD flush.
+    PERF_PROBE_LCD_FLUSH_PAGE,        ///< Next page of lcd_flush_async(), mostly from the SPI completion interrupt.
+    PERF_PROBE_TIMER2_IRQ,            ///< TIMER2_IRQHandler(), beeper timing.
+    PERF_PROBE_APP_PROCESS_ACTION,    ///< app_process_action(), one main loop pass.
+    PERF_PROBE_NUM
+} perf_probe_id_e;
+
+/**
+ * @brief Boot milestones, each timed once from reset.
+ */
+typedef enum
+{
+    PERF_PROBE_BOOT_FIRST_FRAME = 0, ///< First LCD frame sent to the panel.
+    PERF_PROBE_BOOT_FIRST_ACK,       ///< First ACK sent by the command broker.
+    PERF_PROBE_BOOT_NUM
+} perf_probe_boot_e;
+
+/**
+ * @brief Statistics of one probe.
+ */
+typedef struct
+{
+    uint32_t count; ///< Recorded samples.
+    uint32_t min;   ///< Shortest sample, in cycle_counter_read() units.
+    uint32_t max;   ///< Longest sample.
+    uint64_t sum;   ///< Sum of the samples, for the average.
+} perf_probe_stats_t;
+
+/**
+ * @brief Start the cycle counter and clear the statistics.
+ */
+void perf_probe_init(void);
+
+/**
+ * @brief Add a sample to a probe. Samples are not locked: a probe hit from two interrupt levels may lose one.
+ *
+ * @param [in] id - Probe slot.
+ * @param [in] cycles - Sample.
+ */
+void perf_probe_record(perf_probe_id_e id, uint32_t cycles);
+
+/**
+ * @brief Record the time from reset to a boot milestone. Only the first call per milestone counts.
+ *
+ * @param [in] mark - Boot milestone.
+ */
+void perf_probe_boot_mark(perf_probe_boot_e mark);
+
+/**
+ * @brief Copy the statistics of a probe.
+ *
+ * @param [in] id - Probe slot.
+ * @param [out] stats - Statistics.
+ * @return Zero for no error, otherwise error number.
+ */
+uint8_t perf_probe_get(perf_probe_id_e id, perf_probe_stats_t *stats);
+
+/**
+ * @brief Print min/max/avg of every probe that got samples on the debug logger, then clear the statistics.
+ *        Reached boot milestones are printed on every dump.
+ */
+void perf_probe_dump(void);
+
+/**
+ * @brief Call perf_probe_dump() once every PERF_PROBE_DUMP_PERIOD_MS. Meant for the main loop.
+ */
+void perf_probe_poll(void);
+
+#if PERF_PROBE_ENABLE == true
+#define PERF_PROBE_INIT() perf_probe_init();
+#define PERF_PROBE_BEGIN(id) const uint32_t perf_probe_start_##id = cycle_counter_read();
+#define PERF_PROBE_END(id) perf_probe_record((id), cycle_counter_read() - perf_probe_start_##id);
+#define PERF_PROBE_POLL() perf_probe_poll();
+#define PERF_PROBE_BOOT(mark) perf_probe_boot_mark(mark);
+#else
+#define PERF_PROBE_INIT()
+#define PERF_PROBE_BEGIN(id)
+#define PERF_PROBE_END(id)
+#define PERF_PROBE_POLL()
+#define PERF_PROBE_BOOT(mark)
+#endif /* PERF_PROBE_ENABLE */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HAL_INC_PERF_PROBE_H_ */
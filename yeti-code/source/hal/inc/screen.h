@@ -0,0 +1,121 @@
+/** @file screen.h
+ *
+ * @brief Retained screen model, drawn on the display only when it changes
+ *
+ * @author Rene Delgado
+ *
+ * @copyright 2023 The Chamberlain Group, LLC. All rights reserved. All
+ * information within this file and associated files, including all
+ * information and files transmitted with this file are CONFIDENTIAL
+ * and the proprietary property of The Chamberlain Group, LLC.
+ *
+ * In using the Licensed Software, Company shall not use with, combine, or
+ * incorporate any viral open source software with or into any of the Licensed
+ * Software in a manner that would require any portion of the Licensed software to
+ * be (i) disclosed or distributed in source code form; (ii) licensed for the
+ * purpose of making derivative works; or (iii) distributable or redistributable
+ * at no charge.
+ */
+
+#ifndef HAL_INC_SCREEN_H_
+#define HAL_INC_SCREEN_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "lcd.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define SCREEN_QR_NONE (0) ///< No QR code slot, the text lines are shown.
+
+// Rendered screens kept for the screen switches, the build may enable them. An entry takes about 930 bytes of RAM: the
+// QR code carousel of app.c (versions 4 to 7) needs 4. With none, every switch is drawn from blank.
+#ifndef SCREEN_CACHE_ENTRIES
+#define SCREEN_CACHE_ENTRIES (0U)
+#endif /* SCREEN_CACHE_ENTRIES */
+
+/**
+ * @brief What the screen shows. Bytes only: two states are compared with memcmp().
+ */
+typedef struct
+{
+    uint8_t qr_version;                        ///< QR code over the whole screen, SCREEN_QR_NONE for the text lines.
+    uint8_t line_mask;                         ///< Lines written since the last clear, bit per line.
+    bool    backlight;                         ///< Backlight on.
+    uint8_t lines[LCD_LINE_NUM][LCD_CHAR_NUM]; ///< lcd_put_line() text, the icons are its first and last characters.
+} screen_state_t;
+
+/**
+ * @brief A rendered screen, found again by the state that drew it.
+ */
+typedef struct
+{
+    screen_state_t key;       ///< Drawn state, backlight off and hidden text cleared.
+    lcd_frame_t    frame;     ///< What the state drew.
+    uint32_t       last_used; ///< Use stamp, the least recently used entry is replaced first.
+    bool           is_used;   ///< The entry holds a screen.
+} screen_cache_entry_t;
+
+/**
+ * @brief Retained screen: the app describes the screen, screen_refresh() draws what changed.
+ */
+typedef struct
+{
+    lcd_t               *lcd;                         ///< Display the screen is drawn on.
+    screen_state_t       wanted;                      ///< Updated by the setters, from the main loop or interrupts.
+    screen_state_t       shown;                       ///< Last state drawn and committed to the display.
+    volatile uint8_t     changes;                     ///< Bumped by every setter.
+    uint8_t              shown_changes;               ///< changes when shown was taken.
+    bool                 is_shown;                    ///< Something was drawn already.
+#if SCREEN_CACHE_ENTRIES > 0
+    screen_cache_entry_t cache[SCREEN_CACHE_ENTRIES]; ///< Screens drawn from blank, a switch back loads them.
+    uint32_t             cache_uses;                  ///< Use stamp counter.
+#endif /* SCREEN_CACHE_ENTRIES */
+    uint32_t             cache_hits;                  ///< Switches served by the cache.
+    uint32_t             cache_misses;                ///< Switches drawn from blank.
+} screen_t;
+
+/**
+ * @brief  Screen init: no QR code, no text, backlight off. Nothing is drawn before the first screen_refresh().
+ *
+ * @param[out] self - Screen instance.
+ * @param[in] lcd - Initialized display the screen is drawn on.
+ */
+void screen_init(screen_t *const self, lcd_t *lcd);
+
+/**
+ * @brief  Shows a QR code version over the whole screen, SCREEN_QR_NONE goes back to the text lines.
+ */
+void screen_set_qr(screen_t *const self, uint8_t qr_version);
+
+/**
+ * @brief  Sets the text of a line, as lcd_put_line() takes it.
+ *
+ * @return Zero for no error, otherwise error number.
+ */
+uint8_t screen_set_line(screen_t *const self, uint8_t line, const uint8_t *str, size_t size);
+
+/**
+ * @brief  Turns the backlight on or off.
+ */
+void screen_set_backlight(screen_t *const self, bool on);
+
+/**
+ * @brief  Draws the screen if it differs from the last state shown, as one display frame. Main loop only.
+ *
+ * With SCREEN_CACHE_ENTRIES, a switch to a screen drawn before, e.g. the next QR code of the carousel, loads it from
+ * the cache: the flush only sends the difference. Text changes on the screen shown are drawn in place.
+ *
+ * @return true if the screen was drawn and committed, false if the display already shows it.
+ */
+bool screen_refresh(screen_t *const self);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HAL_INC_SCREEN_H_ */
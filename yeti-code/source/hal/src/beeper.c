@@ -21,12 +21,11 @@
 #include "base_pwm_driver.h"
 #include "buzzer_pwm.h"
 #include "debug_log.h"
+#include "perf_probe.h"
 #include "beeper.h"
 
-//"beeper_p" is only for Timer's IRQ usage.
-static beeper_t *beeper_p             = NULL;
-static uint32_t  time_on_reset_value  = 0;
-static uint32_t  time_off_reset_value = 0;
+//"beeper_p" is the beeper bound to TIMER2, only for Timer's IRQ usage.
+static beeper_t *beeper_p = NULL;
 
 /**
  * @brief  Timer Init: Initialize the timer used by the module.
@@ -202,7 +201,7 @@ static uint32_t beeper_silence(const beeper_t *const self)
  * @param [in] self->pwm.handler - PWM to turn off.
  * @return Zero for no error, otherwise error number.
  */
-static uint32_t beeper_off(const beeper_t *const self)
+static uint32_t beeper_off(beeper_t *const self)
 {
     BEEPER_PRINTF("Beeper - %s()\r\n", __func__);
     uint32_t retval = 0;
@@ -210,7 +209,7 @@ static uint32_t beeper_off(const beeper_t *const self)
     if(NULL != self->pwm.stop)
     {
         self->pwm.stop(self->pwm.handler);
-        beeper_p->cfg.num_of_cycles = 0;
+        self->cfg.num_of_cycles = 0;
         // Clear one or more pending TIMER interrupts.
         TIMER_IntClear(self->cfg.timer.self, true);
         // Stop TIMER.
@@ -232,23 +231,23 @@ static uint32_t beeper_off(const beeper_t *const self)
  * @param [in] self->cfg.num_of_cycles - Number of beeps.
  * @return Zero for no error, otherwise error number.
  */
-static void beeper_cyclic_beep(const beeper_t *const self)
+static void beeper_cyclic_beep(beeper_t *const self)
 {
     BEEPER_PRINTF("Beeper - %s(cycles=0x%.2X time_on=%dms, time_off=%dms)\r\n", __func__, self->cfg.num_of_cycles,
                   self->cfg.time_on, self->cfg.time_off);
 
     // Backing up the time_on to restart it in the Timer's IRQ  every cycle.
-    time_on_reset_value = self->cfg.time_on;
+    self->cfg.time_on_reset = self->cfg.time_on;
     // Backing up the time_off to restart it in the Timer's IRQ every cycle.
-    time_off_reset_value = self->cfg.time_off;
+    self->cfg.time_off_reset = self->cfg.time_off;
 
     if(self->cfg.num_of_cycles)
     {
-        if(time_on_reset_value)
+        if(self->cfg.time_on_reset)
         {
             beeper_on(self);
         }
-        else if(time_off_reset_value)
+        else if(self->cfg.time_off_reset)
         {
             beeper_off(self);
         }
@@ -287,63 +286,78 @@ uint32_t beeper_init_handle(beeper_t *const handle)
     return retval;
 }
 
-void TIMER2_IRQHandler(void)
+/**
+ * @brief  Beeper timer tick: advances the cyclic beep by one timer period (1ms).
+ *
+ * @param [in] self - Beeper whose timer overflowed.
+ */
+void beeper_timer_tick(beeper_t *const self)
 {
-    if(beeper_p->cfg.num_of_cycles)
+    if(self->cfg.num_of_cycles)
     {
-        if(beeper_p->cfg.time_on)
+        if(self->cfg.time_on)
         {
-            beeper_p->cfg.time_on--;
-            if(!beeper_p->cfg.time_on)
+            self->cfg.time_on--;
+            if(!self->cfg.time_on)
             {
-                if(time_off_reset_value)
+                if(self->cfg.time_off_reset)
                 {
-                    beeper_silence(beeper_p);
-                    beeper_p->cfg.time_off = time_off_reset_value;
+                    beeper_silence(self);
+                    self->cfg.time_off = self->cfg.time_off_reset;
                 }
                 else
                 {
-                    beeper_p->cfg.num_of_cycles--;
-                    beeper_p->cfg.time_on = time_on_reset_value;
-                    if(beeper_p->cfg.num_of_cycles)
+                    self->cfg.num_of_cycles--;
+                    self->cfg.time_on = self->cfg.time_on_reset;
+                    if(self->cfg.num_of_cycles)
                     {
-                        beeper_p->on(beeper_p);
+                        self->on(self);
                     }
                     else
                     {
-                        beeper_silence(beeper_p);
+                        beeper_silence(self);
                     }
                 }
             }
         }
-        else if(beeper_p->cfg.time_off)
+        else if(self->cfg.time_off)
         {
-            beeper_p->cfg.time_off--;
-            if(!beeper_p->cfg.time_off)
+            self->cfg.time_off--;
+            if(!self->cfg.time_off)
             {
-                beeper_p->cfg.num_of_cycles--;
-                beeper_p->cfg.time_off = time_off_reset_value;
-                if(beeper_p->cfg.num_of_cycles)
+                self->cfg.num_of_cycles--;
+                self->cfg.time_off = self->cfg.time_off_reset;
+                if(self->cfg.num_of_cycles)
                 {
-                    if(time_on_reset_value)
+                    if(self->cfg.time_on_reset)
                     {
-                        beeper_p->on(beeper_p);
-                        beeper_p->cfg.time_on = time_on_reset_value;
+                        self->on(self);
+                        self->cfg.time_on = self->cfg.time_on_reset;
                     }
                     else
                     {
-                        beeper_silence(beeper_p);
+                        beeper_silence(self);
                     }
                 }
             }
         }
 
-        if(!beeper_p->cfg.num_of_cycles)
+        if(!self->cfg.num_of_cycles)
         {
             // Stop TIMER.
-            TIMER_Enable(beeper_p->cfg.timer.self, false);
+            TIMER_Enable(self->cfg.timer.self, false);
         }
     }
     // Clear one or more pending TIMER interrupts.
-    TIMER_IntClear(beeper_p->cfg.timer.self, true);
+    TIMER_IntClear(self->cfg.timer.self, true);
+}
+
+void TIMER2_IRQHandler(void)
+{
+    PERF_PROBE_BEGIN(PERF_PROBE_TIMER2_IRQ)
+    if(NULL != beeper_p)
+    {
+        beeper_timer_tick(beeper_p);
+    }
+    PERF_PROBE_END(PERF_PROBE_TIMER2_IRQ)
 }
@@ -28,151 +28,32 @@
 #include <string.h>
 #include "command_broker.h"
 #include "debug_log.h"
+#include "perf_probe.h"
 
 /********************************************* COMMAND BROKER MACROS *************************************************/
 
-#define CB_REQUEST_BUFF_SIZE (3)                 ///< Max Rx buffer size.
 #define CB_BITS_IN_A_BYTE (8)                    ///< Bits in a byte.
 #define CB_BITS_IN_A_NIBBLE (4)                  ///< Bits in a nibble.
-#define CB_NIBBLES_IN_A_BYTE (2)                 ///< Nibbles in a byte.
 #define CB_INVALID_ASCCIHEX_TO_BIN_NIBBLE (0xFF) ///< Invalid ASCII HEX to bin byte.
 
+/**
+ * @brief Recovers the broker that owns the byte buffer handed back by the serial communication driver.
+ */
+#define CB_SELF_FROM_MEMBER(ptr, member) ((cbroker_t *)(void *)((uint8_t *)(ptr)-offsetof(cbroker_t, member)))
+
 /********************************************* COMMON PROTOCOL MACROS *************************************************/
 
 #define CB_FRAME_BYTE_STX ((uint8_t)(0x02))  ///< Start of Transmission Character.
 #define CB_FRAME_BYTE_ETX ((uint8_t)(0x03))  ///< End of Transmission Character
 #define CB_FRAME_BYTE_NULL ((uint8_t)(0x00)) ///< Null character sent by the display.
 
-#define CB_BYTES_IN_FRAME (2)         ///< Expected frame bytes in binary format (<STX>, <ETX>).
-#define CB_BYTES_IN_PACKET_NUMBER (1) ///< Packet number max binary data size.
-#define CB_BYTES_IN_CMD_ID (1)        ///< Packet number max binary data size.
-#define CB_BYTES_IN_CRC16_ARC (2)     ///< CRC16 ARC binary data size.
-#define CB_BYTES_IN_FRAME (2)         ///< Expected frame bytes in binary format (<STX>, <ETX>).
-#define CB_BYTES_IN_PACKET_NUMBER (1) ///< Packet number max binary data size.
-#define CB_BYTES_IN_CMD_ID (1)        ///< Packet number max binary data size.
-#define CB_BYTES_IN_CRC16_ARC (2)     ///< CRC16 ARC binary data size.
-
-#define CB_RX_BYTES_IN_READ_KEYS_DATA (1) ///< Read keys request command max binary data size.
-#define CB_RX_BYTES_IN_WRITE_LINE_DATA \
-    (CB_BYTES_IN_WRITE_LINE_DATA)            ///< Write line request command max binary data size.
-#define CB_RX_BYTES_IN_SET_BGLIGHT_DATA (1)  ///< Set backlight request command max binary data size.
-#define CB_RX_BYTES_IN_CLEAR_DATA (0)        ///< Clear request command max binary data size.
-#define CB_RX_BYTES_IN_SET_LANGUAGE_DATA (1) ///< Set language request command max binary data size.
-#define CB_RX_BYTES_IN_GET_VERSION_DATA (0)  ///< Get version request command max binary data size.
-#define CB_RX_BYTES_IN_BUZ_PARAM_DATA (2)    ///< Buz param request command max binary data size.
-#define CB_RX_BYTES_IN_BUZ_CTRL_DATA (3)     ///< Buz ctrl request command max binary data size.
-
-#define CB_TX_BYTES_IN_READ_KEYS_DATA (1)    ///< Read keys response command max binary data size.
-#define CB_TX_BYTES_IN_WRITE_LINE_DATA (0)   ///< Write line response command max binary data size.
-#define CB_TX_BYTES_IN_SET_BGLIGHT_DATA (0)  ///< Set backlight response command max binary data size.
-#define CB_TX_BYTES_IN_CLEAR_DATA (0)        ///< Clear response max command binary data size.
-#define CB_TX_BYTES_IN_SET_LANGUAGE_DATA (0) ///< Set language response command max binary data size.
-#define CB_TX_BYTES_IN_GET_VERSION_DATA (2)  ///< Get version response command max binary data size.
-#define CB_TX_BYTES_IN_BUZ_PARAM_DATA (2)    ///< Buz param response command max binary data size.
-#define CB_TX_BYTES_IN_BUZ_CTRL_DATA (0)     ///< Buz ctrl response command max binary data size.
-/********************************************** COMMAND BROKER ENUMS *************************************************/
-
-/**
- * @brief Acknowledge states.
- */
-typedef enum
-{
-    CB_ACK_NOT_READY = 0x00, ///< There is no data in the current request (RX) buffer to respond to the main board.
-    CB_ACK_TO_BE_SEND,       ///< Enough data to create a response command to the main board.
-    CB_ACK_SENDING,          ///< The TX callback (ISR) is consuming the response buffer.
-    CB_ACK_SENT,             ///< The ETX byte is ready to be sent.
-    CB_ACK_MAX,              ///<
-
-} cbroker_ack_status_e;
-
-/**
- * @brief States of request Command Broker finite state machine.
- * These states are called every time there is an rxByte on the sercomm.
- */
-typedef enum
-{
-    CB_RX_IDLE_STATE,                   ///< Idle_state.
-    CB_RX_VALIDATE_FRAME_STATE,         ///< Validate frame.
-    CB_RX_VALIDATE_PACKET_NUMBER_STATE, ///< Validate packet number.
-    CB_RX_VALIDATE_CMD_ID_STATE,        ///< Validate cmd id.
-    CB_RX_VALIDATE_PAYLOAD_STATE,       ///< Validate payload.
-    CB_RX_VALIDATE_CRC_STATE,           ///< Validate crc.
-    CB_RX_MAX_STATE                     ///<
-} cbroker_rx_system_state_e;
-
-/***************************************  REQUEST (RX) STRUCTS AND UNIONS ******************************************/
-
-/**
- * @brief Binary representation of request command.
- */
-typedef struct cbroker_request_msg_format
-{
-    uint8_t                 stx;            ///< Start of Transmission Character.
-    uint8_t                 packet_number;  ///< Packet Number (increments 00 to FF).
-    cbroker_cmd_id_format_t cmd;            ///< Command ID.
-    cbroker_request_data_t  data;           ///< Buffer for each request command's data.
-    uint16_t                crc16_received; ///< CRC16 (over Packet Number to end of Data)
-    uint8_t                 etx;            ///< End of Transmission Character.
-
-} cbroker_request_msg_format_t;
-
 /*************************************** COMMAND BROKER STRUCTS AND UNIONS ******************************************/
 
-/**
- * @brief Data used by Command Broker to link the crc16 and ACK status for each request (Rx).
- */
-typedef struct cbroker_rx_data
-{
-    uint16_t                     crc16_calc; ///< CRC16 (over Packet Number to end of Data).
-    cbroker_request_msg_format_t buff;       ///< Binary representation of incoming request command.
-    cbroker_ack_status_e         ack_status; ///< ACK status.
-} cbroker_rx_data_t;
-
-/**
- * @brief Data used by Command Broker to handle request (Rx) commands.
- */
-typedef struct cbroker_request
-{
-    uint8_t                    index;      ///< Current request buffer index.
-    cbroker_rx_system_state_e  next_state; ///< Next state for request state machine.
-    uint8_t                    rxbyte;     ///< Rxbyte from serial communication driver.
-    cbroker_request_callback_t callback;   ///<  Function pointer called in valid request commands.
-    cbroker_rx_data_t          data[CB_REQUEST_BUFF_SIZE];
-} cbroker_request_t;
-
-/**
- * @brief Response states.
- */
-typedef struct cbroker_tx_state_machine
-{
-    bool is_transmiting;
-
-} cbroker_tx_state_machine_t;
-
-/**
- * @brief Data used by Command Broker to handle response (Tx) commands.
- */
-typedef struct cbroker_response
-{
-    uint8_t                    index;         ///< Current responding buffer index.
-    cbroker_tx_state_machine_t state_machine; ///< Response states.
-    uint8_t                    txByte;        ///< Txbyte for serial communication driver.
-    cbroker_response_data_t    bin_data;      ///< Reserved bytes for each response command's data.
-    uint16_t                   crc16_calc;    ///< CRC16 (over Packet Number to end of Data)
-    // clang-format off
-    uint8_t buff[
-                           (CB_BYTES_IN_FRAME) +
-                           (CB_NIBBLES_IN_A_BYTE * CB_BYTES_IN_PACKET_NUMBER) +
-                           (CB_NIBBLES_IN_A_BYTE * CB_BYTES_IN_CMD_ID ) +
-                           (CB_NIBBLES_IN_A_BYTE * CB_TX_BYTES_IN_BUZ_PARAM_DATA ) + /*Max response data size element.*/
-                           (CB_NIBBLES_IN_A_BYTE * CB_BYTES_IN_CRC16_ARC) 
-                        ] ;
-} cbroker_response_t;
-
 /**
  * @brief Pointer function for rx request event handler.
  */
-typedef cbroker_rx_system_state_e (*cbroker_rx_system_event_handler)(const uint8_t * const rxByte);
+typedef cbroker_rx_system_state_e (*cbroker_rx_system_event_handler)(cbroker_t *const     self,
+                                                                     const uint8_t *const rxByte);
 
 /**
  * @brief Structure of state with event handler.
@@ -183,20 +64,6 @@ typedef struct
     cbroker_rx_system_event_handler handler; ///< States called every time there is an rxByte on the sercomm.
 } cbroker_rx_state_machine_t;
 
-/**
- * @brief Main Command Broker Struct.
- */
-typedef struct cbroker
-{
-    cbroker_request_t  request; ///< Data used by Command Broker to handle request (Rx) commands.
-    cbroker_response_t response; ///< Data used by Command Broker to handle response (Tx) commands.
-    base_driver        *sercomm; ///<Pointer to structure represents, base serial communication driver.
-} cbroker_t;
-
-/************************************************* LOCAL VARIABLES ***************************************************/
-
-static cbroker_t cb = {.request.next_state = CB_RX_IDLE_STATE, .request.index = 0};
-
 /************************************************* COMMON FUNCTIONS **************************************************/
 static uint16_t cborker_calc_crc16arc(uint16_t crc, void const *mem, size_t len)
 {
@@ -217,7 +84,7 @@ static uint16_t cborker_calc_crc16arc(uint16_t crc, void const *mem, size_t len)
 }
 
 /*********************************************** RESPONSE FUNCTIONS (TX) *********************************************/
-uint8_t cbroker_tx_fill_buff(uint8_t *buff, const uint8_t index)
+uint8_t cbroker_tx_fill_buff(cbroker_t *const self, uint8_t *buff, const uint8_t index)
 {
    /**
     * @brief Response command ID to data size table.
@@ -241,8 +108,8 @@ uint8_t cbroker_tx_fill_buff(uint8_t *buff, const uint8_t index)
 
     // clang-format on
 
-    uint8_t  cmd_id            = (CB_CMD_ID_BITS_MASK & cb.request.data[index].buff.cmd.id_with_status);
-    uint8_t  status            = (CB_CMD_ID_STATUS_BITS_MASK & cb.request.data[index].buff.cmd.id_with_status);
+    uint8_t  cmd_id            = (CB_CMD_ID_BITS_MASK & self->request.data[index].buff.cmd.id_with_status);
+    uint8_t  status            = (CB_CMD_ID_STATUS_BITS_MASK & self->request.data[index].buff.cmd.id_with_status);
     uint8_t  read_keys_data    = 0;
     uint16_t get_version_data  = 0;
     uint8_t  cmd_id_data_size  = 0;
@@ -252,12 +119,12 @@ uint8_t cbroker_tx_fill_buff(uint8_t *buff, const uint8_t index)
     // STX - START TRANSMISSION
     buff[0] = CB_FRAME_BYTE_STX;
     // PACKET NUMBER
-    buff[1] = bin_to_asciihex_tbl[((0xF0 & cb.request.data[index].buff.packet_number) >> CB_BITS_IN_A_NIBBLE)];
-    buff[2] = bin_to_asciihex_tbl[0x0F & cb.request.data[index].buff.packet_number];
+    buff[1] = bin_to_asciihex_tbl[((0xF0 & self->request.data[index].buff.packet_number) >> CB_BITS_IN_A_NIBBLE)];
+    buff[2] = bin_to_asciihex_tbl[0x0F & self->request.data[index].buff.packet_number];
 
     // COMMAND ID
-    buff[3] = bin_to_asciihex_tbl[((0xF0 & cb.request.data[index].buff.cmd.id_with_status) >> CB_BITS_IN_A_NIBBLE)];
-    buff[4] = bin_to_asciihex_tbl[0x0F & cb.request.data[index].buff.cmd.id_with_status];
+    buff[3] = bin_to_asciihex_tbl[((0xF0 & self->request.data[index].buff.cmd.id_with_status) >> CB_BITS_IN_A_NIBBLE)];
+    buff[4] = bin_to_asciihex_tbl[0x0F & self->request.data[index].buff.cmd.id_with_status];
 
     // PAYLOAD response
     if(CB_CMD_ID_STATUS_BIT_NO_ERR == status)
@@ -265,20 +132,22 @@ uint8_t cbroker_tx_fill_buff(uint8_t *buff, const uint8_t index)
         cmd_id_data_size = response_cmd_id_to_data_size_table[cmd_id];
         if(DISP_READ_KEYS == cmd_id)
         {
-            if(cb.request.callback)
+            if(self->request.callback)
             {
-                cb.request.callback(cmd_id, &cb.request.data[index].buff.data, &cb.response.bin_data);
-                read_keys_data = cb.response.bin_data.read_keys;
+                self->request.callback(self->request.arg, cmd_id, &self->request.data[index].buff.data,
+                                       &self->response.bin_data);
+                read_keys_data = self->response.bin_data.read_keys;
             }
             buff[5] = bin_to_asciihex_tbl[((0xF0 & read_keys_data) >> CB_BITS_IN_A_NIBBLE)];
             buff[6] = bin_to_asciihex_tbl[0x0F & read_keys_data];
         }
         else if(DISP_GET_VERSION == cmd_id)
         {
-            if(cb.request.callback)
+            if(self->request.callback)
             {
-                cb.request.callback(cmd_id, &cb.request.data[index].buff.data, &cb.response.bin_data);
-                get_version_data = cb.response.bin_data.version;
+                self->request.callback(self->request.arg, cmd_id, &self->request.data[index].buff.data,
+                                       &self->response.bin_data);
+                get_version_data = self->response.bin_data.version;
             }
             buff[5] = bin_to_asciihex_tbl[((0xF000 & get_version_data) >> CB_BITS_IN_A_NIBBLE * 3)];
             buff[6] = bin_to_asciihex_tbl[((0x0F00 & get_version_data) >> CB_BITS_IN_A_NIBBLE * 2)];
@@ -287,12 +156,12 @@ uint8_t cbroker_tx_fill_buff(uint8_t *buff, const uint8_t index)
         }
         else if(DISP_BUZZER_PARAM)
         {
-            buff[5] =
-                bin_to_asciihex_tbl[((0xF0 & cb.request.data[index].buff.data.buz_param.type) >> CB_BITS_IN_A_NIBBLE)];
-            buff[6] = bin_to_asciihex_tbl[((0x0F & cb.request.data[index].buff.data.buz_param.type))];
-            buff[7] = bin_to_asciihex_tbl[((0xF0 & cb.request.data[index].buff.data.buz_param.value.freq_and_duty_cycle) >>
-                                           CB_BITS_IN_A_NIBBLE)];
-            buff[8] = bin_to_asciihex_tbl[((0x0F & cb.request.data[index].buff.data.buz_param.value.freq_and_duty_cycle))];
+            const cbroker_buz_param_data_t *const buz_param = &self->request.data[index].buff.data.buz_param;
+
+            buff[5] = bin_to_asciihex_tbl[((0xF0 & buz_param->type) >> CB_BITS_IN_A_NIBBLE)];
+            buff[6] = bin_to_asciihex_tbl[((0x0F & buz_param->type))];
+            buff[7] = bin_to_asciihex_tbl[((0xF0 & buz_param->value.freq_and_duty_cycle) >> CB_BITS_IN_A_NIBBLE)];
+            buff[8] = bin_to_asciihex_tbl[((0x0F & buz_param->value.freq_and_duty_cycle))];
         }
         else
         {
@@ -301,9 +170,9 @@ uint8_t cbroker_tx_fill_buff(uint8_t *buff, const uint8_t index)
     }
 
     // CRC CALC
-    cb.response.crc16_calc = 0;
+    self->response.crc16_calc = 0;
     // clang-format off
-    cb.response.crc16_calc =cborker_calc_crc16arc(cb.response.crc16_calc, &buff[1],
+    self->response.crc16_calc =cborker_calc_crc16arc(self->response.crc16_calc, &buff[1],
                                         (CB_NIBBLES_IN_A_BYTE * CB_BYTES_IN_PACKET_NUMBER) +
                                         (CB_NIBBLES_IN_A_BYTE * CB_BYTES_IN_CMD_ID) +
                                         (CB_NIBBLES_IN_A_BYTE * cmd_id_data_size) 
@@ -312,10 +181,10 @@ uint8_t cbroker_tx_fill_buff(uint8_t *buff, const uint8_t index)
 
     // CRC FILL
     offset             = CB_NIBBLES_IN_A_BYTE * cmd_id_data_size;
-    buff[(5 + offset)] = bin_to_asciihex_tbl[((0xF000 & cb.response.crc16_calc) >> CB_BITS_IN_A_NIBBLE * 3)];
-    buff[(6 + offset)] = bin_to_asciihex_tbl[((0x0F00 & cb.response.crc16_calc) >> CB_BITS_IN_A_NIBBLE * 2)];
-    buff[(7 + offset)] = bin_to_asciihex_tbl[((0x00F0 & cb.response.crc16_calc) >> CB_BITS_IN_A_NIBBLE * 1)];
-    buff[(8 + offset)] = bin_to_asciihex_tbl[((0x000F & cb.response.crc16_calc))];
+    buff[(5 + offset)] = bin_to_asciihex_tbl[((0xF000 & self->response.crc16_calc) >> CB_BITS_IN_A_NIBBLE * 3)];
+    buff[(6 + offset)] = bin_to_asciihex_tbl[((0x0F00 & self->response.crc16_calc) >> CB_BITS_IN_A_NIBBLE * 2)];
+    buff[(7 + offset)] = bin_to_asciihex_tbl[((0x00F0 & self->response.crc16_calc) >> CB_BITS_IN_A_NIBBLE * 1)];
+    buff[(8 + offset)] = bin_to_asciihex_tbl[((0x000F & self->response.crc16_calc))];
 
     // ETX - END TRANSMISSION
     buff[(9 + offset)] = CB_FRAME_BYTE_ETX;
@@ -330,25 +199,25 @@ uint8_t cbroker_tx_fill_buff(uint8_t *buff, const uint8_t index)
                        (CB_NIBBLES_IN_A_BYTE * CB_BYTES_IN_CRC16_ARC);
     // clang-format on
 
-    CB_PRINTF("CB - [Tx]: PN=0x%.4X, ST=0x%.2X, ID=0x%.2X, CRC=0x%.4X\r\n", cb.request.data[index].buff.packet_number,
-              status, cmd_id, cb.response.crc16_calc);
+    CB_PRINTF("CB - [Tx]: PN=0x%.4X, ST=0x%.2X, ID=0x%.2X, CRC=0x%.4X\r\n",
+              self->request.data[index].buff.packet_number, status, cmd_id, self->response.crc16_calc);
 
     return bytes_to_transmit;
 }
 
-uint8_t cbroker_tx_set_next_byte(uint8_t *const txByte)
+uint8_t cbroker_tx_set_next_byte(cbroker_t *const self, uint8_t *const txByte)
 {
-    static uint8_t transmited_bytes  = 0;
-    uint8_t        bytes_to_transmit = 1;
+    uint8_t bytes_to_transmit = 1;
 
-    uint8_t next_index                       = 0;
-    cb.response.state_machine.is_transmiting = true;
+    uint8_t next_index                          = 0;
+    PERF_PROBE_BEGIN(PERF_PROBE_CBROKER_TX_NEXT_BYTE)
+    self->response.state_machine.is_transmiting = true;
 
     // Verifying if the current Request command (Rx) is ready to Response (Tx).
-    if(CB_ACK_NOT_READY == cb.request.data[cb.response.index].ack_status ||
-       CB_ACK_SENT == cb.request.data[cb.response.index].ack_status)
+    if(CB_ACK_NOT_READY == self->request.data[self->response.index].ack_status ||
+       CB_ACK_SENT == self->request.data[self->response.index].ack_status)
     {
-        next_index = cb.response.index;
+        next_index = self->response.index;
 
         // If current response index is CB_ACK_NOT_READY or CB_ACK_SENT, verify the next index.
         if(CB_REQUEST_BUFF_SIZE - 1 > next_index)
@@ -360,93 +229,97 @@ uint8_t cbroker_tx_set_next_byte(uint8_t *const txByte)
             next_index = 0;
         }
         // If next index is CB_ACK_TO_BE_SEND, update the current index.
-        if(CB_ACK_TO_BE_SEND == cb.request.data[next_index].ack_status)
+        if(CB_ACK_TO_BE_SEND == self->request.data[next_index].ack_status)
         {
-            cb.response.index = next_index;
-            transmited_bytes  = 0;
+            self->response.index            = next_index;
+            self->response.transmited_bytes = 0;
         }
         else
         {
             // There is no more bytes to transmit.
-            bytes_to_transmit                        = 0;
-            cb.response.state_machine.is_transmiting = false;
+            bytes_to_transmit                           = 0;
+            self->response.state_machine.is_transmiting = false;
+            PERF_PROBE_END(PERF_PROBE_CBROKER_TX_NEXT_BYTE)
             return bytes_to_transmit;
         }
     }
 
-    if(CB_ACK_TO_BE_SEND == cb.request.data[cb.response.index].ack_status)
+    if(CB_ACK_TO_BE_SEND == self->request.data[self->response.index].ack_status)
     {
-        transmited_bytes                              = 0;
-        cb.request.data[cb.response.index].ack_status = CB_ACK_SENDING;
-        (*txByte)                                     = CB_FRAME_BYTE_STX;
+        self->response.transmited_bytes                     = 0;
+        self->request.data[self->response.index].ack_status = CB_ACK_SENDING;
+        (*txByte)                                           = CB_FRAME_BYTE_STX;
     }
-    else if(CB_ACK_SENDING == cb.request.data[cb.response.index].ack_status)
+    else if(CB_ACK_SENDING == self->request.data[self->response.index].ack_status)
     {
-        if(1 == transmited_bytes)
+        if(1 == self->response.transmited_bytes)
         {
             // The buffer is filled after STX is sent, to spend time in the tx_callback instead of rx_callback.
-            cbroker_tx_fill_buff(cb.response.buff, cb.response.index);
+            cbroker_tx_fill_buff(self, self->response.buff, self->response.index);
         }
 
         // Filling the txByte to be transmitted.
-        (*txByte) = cb.response.buff[transmited_bytes];
+        (*txByte) = self->response.buff[self->response.transmited_bytes];
 
         if(CB_FRAME_BYTE_NULL == (*txByte))
         {
-            cb.request.data[cb.response.index].ack_status = CB_ACK_SENT;
+            self->request.data[self->response.index].ack_status = CB_ACK_SENT;
+            PERF_PROBE_BOOT(PERF_PROBE_BOOT_FIRST_ACK)
         }
     }
 
-    transmited_bytes++;
+    self->response.transmited_bytes++;
+    PERF_PROBE_END(PERF_PROBE_CBROKER_TX_NEXT_BYTE)
     return bytes_to_transmit;
 }
 
-uint8_t cbroker_tx_cb(uint8_t status, size_t size)
+uint8_t cbroker_tx_cb(uint8_t status, uint8_t *data, size_t size)
 {
     (void)size;
-    uint8_t bytes_to_transmit = 0;
+    cbroker_t *self              = CB_SELF_FROM_MEMBER(data, response.txByte);
+    uint8_t    bytes_to_transmit = 0;
 
-    bytes_to_transmit = cbroker_tx_set_next_byte(&cb.response.txByte);
+    bytes_to_transmit = cbroker_tx_set_next_byte(self, &self->response.txByte);
     if(bytes_to_transmit)
     {
-        cb.sercomm->write_non_blocking(cb.sercomm->handle, &cb.response.txByte, 1, cbroker_tx_cb);
+        self->sercomm->write_non_blocking(self->sercomm->handle, &self->response.txByte, 1, cbroker_tx_cb);
     }
     return status;
 }
 
-void cbroker_tx_send_response(void)
+void cbroker_tx_send_response(cbroker_t *const self)
 {
     uint8_t bytes_to_transmit;
 
     // If the response state machine is already transmitting this response will be sent in FIFO order.
-    if(false == cb.response.state_machine.is_transmiting)
+    if(false == self->response.state_machine.is_transmiting)
     {
         // Setting STX byte.
-        bytes_to_transmit = cbroker_tx_set_next_byte(&cb.response.txByte);
+        bytes_to_transmit = cbroker_tx_set_next_byte(self, &self->response.txByte);
         if(bytes_to_transmit)
         {
             // Transmit STX byte.
-            cb.sercomm->write_non_blocking(cb.sercomm->handle, &cb.response.txByte, 1, cbroker_tx_cb);
+            self->sercomm->write_non_blocking(self->sercomm->handle, &self->response.txByte, 1, cbroker_tx_cb);
         }
     }
 }
 
 /**********************************************  REQUEST FUNCTIONS (RX) **********************************************/
-static void cbroker_rx_set_status_bit(cbroker_cmd_id_status_bits_e flag)
+static void cbroker_rx_set_status_bit(cbroker_t *const self, cbroker_cmd_id_status_bits_e flag)
 {
     if(CB_CMD_ID_STATUS_BIT_ERR == flag)
     {
-        cb.request.data[cb.request.index].buff.cmd.status &= (~CB_CMD_ID_STATUS_BIT_NO_ERR);
-        cb.request.data[cb.request.index].buff.cmd.status |= CB_CMD_ID_STATUS_BIT_ERR;
+        self->request.data[self->request.index].buff.cmd.status &= (~CB_CMD_ID_STATUS_BIT_NO_ERR);
+        self->request.data[self->request.index].buff.cmd.status |= CB_CMD_ID_STATUS_BIT_ERR;
     }
     else
     {
-        cb.request.data[cb.request.index].buff.cmd.status &= (~CB_CMD_ID_STATUS_BIT_ERR);
-        cb.request.data[cb.request.index].buff.cmd.status |= CB_CMD_ID_STATUS_BIT_NO_ERR;
+        self->request.data[self->request.index].buff.cmd.status &= (~CB_CMD_ID_STATUS_BIT_ERR);
+        self->request.data[self->request.index].buff.cmd.status |= CB_CMD_ID_STATUS_BIT_NO_ERR;
     }
 }
 
-static void cbroker_rx_asciihex_to_bin(uint8_t *const pRxByte)
+static void cbroker_rx_asciihex_to_bin(cbroker_t *const self, uint8_t *const pRxByte)
 {
     /**
      * @brief ASCIIHEX to bin table.
@@ -481,147 +354,147 @@ static void cbroker_rx_asciihex_to_bin(uint8_t *const pRxByte)
     {
         // Later, some functions reset their static variables based on this flag.
         CB_PRINTF("CB - [Rx]: PN=0x%.4X, ST=0x%.2X, ID=0x%.2X, Err=Asciihex to bin invalid (0x%.2X)\r\n",
-                  cb.request.data[cb.request.index].buff.packet_number,
-                  (CB_CMD_ID_STATUS_BITS_MASK & cb.request.data[cb.request.index].buff.cmd.id_with_status),
-                  (CB_CMD_ID_BITS_MASK & cb.request.data[cb.request.index].buff.cmd.id_with_status), (*pRxByte));
-        cbroker_rx_set_status_bit(CB_CMD_ID_STATUS_BIT_ERR);
+                  self->request.data[self->request.index].buff.packet_number,
+                  (CB_CMD_ID_STATUS_BITS_MASK & self->request.data[self->request.index].buff.cmd.id_with_status),
+                  (CB_CMD_ID_BITS_MASK & self->request.data[self->request.index].buff.cmd.id_with_status), (*pRxByte));
+        cbroker_rx_set_status_bit(self, CB_CMD_ID_STATUS_BIT_ERR);
     }
 }
 
-static cbroker_rx_system_state_e cbroker_rx_validate_frame(const uint8_t *const pRxByte)
+static cbroker_rx_system_state_e cbroker_rx_validate_frame(cbroker_t *const self, const uint8_t *const pRxByte)
 {
-    static uint8_t               remaining_frame_bytes = CB_BYTES_IN_FRAME;
-    cbroker_rx_system_state_e    next_state            = CB_RX_IDLE_STATE;
+    cbroker_rx_system_state_e    next_state = CB_RX_IDLE_STATE;
     cbroker_cmd_id_status_bits_e status_bits =
-        (CB_CMD_ID_STATUS_BITS_MASK & cb.request.data[cb.request.index].buff.cmd.status);
+        (CB_CMD_ID_STATUS_BITS_MASK & self->request.data[self->request.index].buff.cmd.status);
 
     // If cbroker_rx_validate_frame() function/state is called when error flag is set, means that the state machine
     // should wait for STX byte (new requet).
     if(CB_CMD_ID_STATUS_BIT_ERR == status_bits)
     {
-        remaining_frame_bytes = CB_BYTES_IN_FRAME;
+        self->request.remaining_frame_bytes = CB_BYTES_IN_FRAME;
     }
 
-    if(CB_FRAME_BYTE_STX == (*pRxByte) && CB_BYTES_IN_FRAME == remaining_frame_bytes)
+    if(CB_FRAME_BYTE_STX == (*pRxByte) && CB_BYTES_IN_FRAME == self->request.remaining_frame_bytes)
     {
         // If the current ACK state is CB_ACK_NOT_READY, the Request (Rx) index should not be updated to allow the
         // Response (Tx) state machine to consume the index in consecutive order.
-        if(CB_ACK_NOT_READY != cb.request.data[cb.request.index].ack_status)
+        if(CB_ACK_NOT_READY != self->request.data[self->request.index].ack_status)
         {
-            if((CB_REQUEST_BUFF_SIZE - 1) > cb.request.index)
+            if((CB_REQUEST_BUFF_SIZE - 1) > self->request.index)
             {
-                cb.request.index++;
+                self->request.index++;
             }
             else
             {
-                cb.request.index = 0;
+                self->request.index = 0;
             }
         }
 
         // Clean the index buffer to used in this iteration.
-        memset(&cb.request.data[cb.request.index], 0x00, sizeof(cbroker_rx_data_t));
+        memset(&self->request.data[self->request.index], 0x00, sizeof(cbroker_rx_data_t));
         // Set status bits to NO Error flag.
-        cbroker_rx_set_status_bit(CB_CMD_ID_STATUS_BIT_NO_ERR);
+        cbroker_rx_set_status_bit(self, CB_CMD_ID_STATUS_BIT_NO_ERR);
         // Saving STX byte.
-        cb.request.data[cb.request.index].buff.stx = (*pRxByte);
+        self->request.data[self->request.index].buff.stx = (*pRxByte);
         // STX byte received.
-        remaining_frame_bytes--;
+        self->request.remaining_frame_bytes--;
         next_state = CB_RX_VALIDATE_PACKET_NUMBER_STATE;
     }
-    else if(CB_FRAME_BYTE_ETX == (*pRxByte) && (CB_BYTES_IN_FRAME - 1) == remaining_frame_bytes)
+    else if(CB_FRAME_BYTE_ETX == (*pRxByte) && (CB_BYTES_IN_FRAME - 1) == self->request.remaining_frame_bytes)
     {
         next_state = CB_RX_IDLE_STATE;
-        // Restart remaining_frame_bytes for next command.
-        remaining_frame_bytes = CB_BYTES_IN_FRAME;
+        // Restart self->request.remaining_frame_bytes for next command.
+        self->request.remaining_frame_bytes = CB_BYTES_IN_FRAME;
         // Saving ETX byte.
-        cb.request.data[cb.request.index].buff.etx = (*pRxByte);
+        self->request.data[self->request.index].buff.etx = (*pRxByte);
 
         if(CB_CMD_ID_STATUS_BIT_NO_ERR == status_bits)
         {
-            if(cb.request.callback)
+            if(self->request.callback)
             {
-                cbroker_cmd_id_e cmd_id = (CB_CMD_ID_BITS_MASK & cb.request.data[cb.request.index].buff.cmd.id);
-                cb.request.callback(cmd_id, &cb.request.data[cb.request.index].buff.data, &cb.response.bin_data);
+                cbroker_cmd_id_e cmd_id = (CB_CMD_ID_BITS_MASK & self->request.data[self->request.index].buff.cmd.id);
+                self->request.callback(self->request.arg, cmd_id, &self->request.data[self->request.index].buff.data,
+                                       &self->response.bin_data);
                 CB_PRINTF("CB - [Rx]: PN=0x%.4X, ST=0x%.2X, ID=0x%.2X, CRC=0x%.4X\r\n",
-                          cb.request.data[cb.request.index].buff.packet_number,
-                          (CB_CMD_ID_STATUS_BITS_MASK & cb.request.data[cb.request.index].buff.cmd.id_with_status),
-                          cmd_id, cb.request.data[cb.request.index].buff.crc16_received);
+                          self->request.data[self->request.index].buff.packet_number,
+                          (CB_CMD_ID_STATUS_BITS_MASK &
+                           self->request.data[self->request.index].buff.cmd.id_with_status),
+                          cmd_id, self->request.data[self->request.index].buff.crc16_received);
             }
         }
         // As soon ETX byte is received, the command response can starts.
-        cbroker_tx_send_response();
+        cbroker_tx_send_response(self);
     }
     else
     {
-        remaining_frame_bytes = CB_BYTES_IN_FRAME;
+        self->request.remaining_frame_bytes = CB_BYTES_IN_FRAME;
     }
 
     return next_state;
 }
 
-static cbroker_rx_system_state_e cbroker_rx_validate_packet_number(const uint8_t *const pRxByte)
+static cbroker_rx_system_state_e cbroker_rx_validate_packet_number(cbroker_t *const self, const uint8_t *const pRxByte)
 {
-    static uint8_t               remaining_nibbles = (CB_BYTES_IN_PACKET_NUMBER * CB_NIBBLES_IN_A_BYTE);
-    cbroker_rx_system_state_e    next_state        = CB_RX_VALIDATE_PACKET_NUMBER_STATE;
+    cbroker_rx_system_state_e    next_state = CB_RX_VALIDATE_PACKET_NUMBER_STATE;
     cbroker_cmd_id_status_bits_e status_bits =
-        (CB_CMD_ID_STATUS_BITS_MASK & cb.request.data[cb.request.index].buff.cmd.status);
+        (CB_CMD_ID_STATUS_BITS_MASK & self->request.data[self->request.index].buff.cmd.status);
 
     // This flag indicates that an invalid rxByte was detected during AsciiHex to Bin conversion.
     if(CB_CMD_ID_STATUS_BIT_ERR == status_bits)
     {
-        remaining_nibbles                                    = (CB_BYTES_IN_PACKET_NUMBER * CB_NIBBLES_IN_A_BYTE);
-        cb.request.data[cb.request.index].buff.packet_number = 0;
-        next_state                                           = CB_RX_IDLE_STATE;
+        self->request.remaining_pn_nibbles                         = (CB_BYTES_IN_PACKET_NUMBER * CB_NIBBLES_IN_A_BYTE);
+        self->request.data[self->request.index].buff.packet_number = 0;
+        next_state                                                 = CB_RX_IDLE_STATE;
         return next_state;
     }
 
-    remaining_nibbles--;
+    self->request.remaining_pn_nibbles--;
     // Saving the rxByte in the corresponding nibble.
-    cb.request.data[cb.request.index].buff.packet_number = cb.request.data[cb.request.index].buff.packet_number |
-                                                           ((*pRxByte) << (CB_BITS_IN_A_NIBBLE * remaining_nibbles));
+    self->request.data[self->request.index].buff.packet_number =
+        self->request.data[self->request.index].buff.packet_number |
+        ((*pRxByte) << (CB_BITS_IN_A_NIBBLE * self->request.remaining_pn_nibbles));
 
-    if(0 == remaining_nibbles)
+    if(0 == self->request.remaining_pn_nibbles)
     {
-        remaining_nibbles = (CB_BYTES_IN_PACKET_NUMBER * CB_NIBBLES_IN_A_BYTE);
-        next_state        = CB_RX_VALIDATE_CMD_ID_STATE;
+        self->request.remaining_pn_nibbles = (CB_BYTES_IN_PACKET_NUMBER * CB_NIBBLES_IN_A_BYTE);
+        next_state                         = CB_RX_VALIDATE_CMD_ID_STATE;
     }
 
     return next_state;
 }
 
-static cbroker_rx_system_state_e cbroker_rx_validate_cmd_id(const uint8_t *const pRxByte)
+static cbroker_rx_system_state_e cbroker_rx_validate_cmd_id(cbroker_t *const self, const uint8_t *const pRxByte)
 {
-    static uint8_t               remaining_nibbles = (CB_BYTES_IN_CMD_ID * CB_NIBBLES_IN_A_BYTE);
-    static cbroker_cmd_id_e      cmd_id_bits       = 0;
-    cbroker_rx_system_state_e    next_state        = CB_RX_VALIDATE_CMD_ID_STATE;
+    cbroker_rx_system_state_e    next_state = CB_RX_VALIDATE_CMD_ID_STATE;
     cbroker_cmd_id_status_bits_e status_bits =
-        (CB_CMD_ID_STATUS_BITS_MASK & cb.request.data[cb.request.index].buff.cmd.status);
+        (CB_CMD_ID_STATUS_BITS_MASK & self->request.data[self->request.index].buff.cmd.status);
 
     // This flag indicates that an invalid rxByte was detected during AsciiHex to Bin conversion.
     if(CB_CMD_ID_STATUS_BIT_ERR == status_bits)
     {
-        remaining_nibbles = (CB_BYTES_IN_CMD_ID * CB_NIBBLES_IN_A_BYTE);
-        cmd_id_bits       = 0;
-        next_state        = CB_RX_IDLE_STATE;
+        self->request.remaining_cmd_id_nibbles = (CB_BYTES_IN_CMD_ID * CB_NIBBLES_IN_A_BYTE);
+        self->request.cmd_id_bits              = 0;
+        next_state                             = CB_RX_IDLE_STATE;
         return next_state;
     }
 
-    remaining_nibbles--;
+    self->request.remaining_cmd_id_nibbles--;
     // Saving the rxByte in the corresponding nibble.
-    cmd_id_bits = cmd_id_bits | ((*pRxByte) << (CB_BITS_IN_A_NIBBLE * remaining_nibbles));
+    self->request.cmd_id_bits =
+        self->request.cmd_id_bits | ((*pRxByte) << (CB_BITS_IN_A_NIBBLE * self->request.remaining_cmd_id_nibbles));
 
-    if(0 == remaining_nibbles)
+    if(0 == self->request.remaining_cmd_id_nibbles)
     {
         next_state = CB_RX_IDLE_STATE;
 
-        // Restart remaining_nibbles for the next request command.
-        remaining_nibbles = (CB_BYTES_IN_CMD_ID * CB_NIBBLES_IN_A_BYTE);
-        if(DISP_CMD_ID_UNUSED < cmd_id_bits && DISP_CMD_ID_MAX > cmd_id_bits)
+        // Restart self->request.remaining_cmd_id_nibbles for the next request command.
+        self->request.remaining_cmd_id_nibbles = (CB_BYTES_IN_CMD_ID * CB_NIBBLES_IN_A_BYTE);
+        if(DISP_CMD_ID_UNUSED < self->request.cmd_id_bits && DISP_CMD_ID_MAX > self->request.cmd_id_bits)
         {
             // Adding the status bits to the Rx command id.
-            cb.request.data[cb.request.index].buff.cmd.id = (cmd_id_bits | status_bits);
+            self->request.data[self->request.index].buff.cmd.id = (self->request.cmd_id_bits | status_bits);
 
-            if((DISP_CLEAR == cmd_id_bits) || (DISP_GET_VERSION == cmd_id_bits))
+            if((DISP_CLEAR == self->request.cmd_id_bits) || (DISP_GET_VERSION == self->request.cmd_id_bits))
             {
                 // There is no data payload expected in CB_CMD_ID_CLEAR and CB_CMD_ID_GET_VERSION commands.
                 next_state = CB_RX_VALIDATE_CRC_STATE;
@@ -632,60 +505,60 @@ static cbroker_rx_system_state_e cbroker_rx_validate_cmd_id(const uint8_t *const
             }
 
             // As soon as we have the command id, we can start sending the response message.
-            cb.request.data[cb.request.index].ack_status = CB_ACK_TO_BE_SEND;
+            self->request.data[self->request.index].ack_status = CB_ACK_TO_BE_SEND;
         }
 
-        cmd_id_bits = 0;
+        self->request.cmd_id_bits = 0;
     }
 
     return next_state;
 }
 
-static cbroker_rx_system_state_e cbroker_rx_validate_read_keys_data(void)
+static cbroker_rx_system_state_e cbroker_rx_validate_read_keys_data(const cbroker_request_data_t *const data)
 {
     cbroker_rx_system_state_e next_state = CB_RX_VALIDATE_CRC_STATE;
-    if(CB_READ_KEYS_DATA_MAX <= cb.request.data[cb.request.index].buff.data.read_keys)
+    if(CB_READ_KEYS_DATA_MAX <= data->read_keys)
     {
         next_state = CB_RX_IDLE_STATE;
     }
     return next_state;
 }
 
-static cbroker_rx_system_state_e cbroker_rx_validate_set_bglight_data(void)
+static cbroker_rx_system_state_e cbroker_rx_validate_set_bglight_data(const cbroker_request_data_t *const data)
 {
     cbroker_rx_system_state_e next_state = CB_RX_VALIDATE_CRC_STATE;
-    if(CB_SET_BGLIGHT_DATA_MAX <= cb.request.data[cb.request.index].buff.data.set_bglight)
+    if(CB_SET_BGLIGHT_DATA_MAX <= data->set_bglight)
     {
         next_state = CB_RX_IDLE_STATE;
     }
     return next_state;
 }
 
-static cbroker_rx_system_state_e cbroker_rx_validate_set_language_data(void)
+static cbroker_rx_system_state_e cbroker_rx_validate_set_language_data(const cbroker_request_data_t *const data)
 {
     cbroker_rx_system_state_e next_state = CB_RX_VALIDATE_CRC_STATE;
-    if(CB_SET_LANGUAGE_DATA_MAX <= cb.request.data[cb.request.index].buff.data.set_language)
+    if(CB_SET_LANGUAGE_DATA_MAX <= data->set_language)
     {
         next_state = CB_RX_IDLE_STATE;
     }
     return next_state;
 }
 
-static cbroker_rx_system_state_e cbroker_rx_validate_buz_param_data(void)
+static cbroker_rx_system_state_e cbroker_rx_validate_buz_param_data(const cbroker_request_data_t *const data)
 {
     cbroker_rx_system_state_e next_state = CB_RX_IDLE_STATE;
-    if(CB_BUZ_PARAM_DATA0_FREQ == cb.request.data[cb.request.index].buff.data.buz_param.type)
+    if(CB_BUZ_PARAM_DATA0_FREQ == data->buz_param.type)
     {
-        if(CB_BUZ_PARAM_DATA1_FREQ_LOWER_LIMIT <= cb.request.data[cb.request.index].buff.data.buz_param.value.freq &&
-           CB_BUZ_PARAM_DATA1_FREQ_UPPER_LIMIT >= cb.request.data[cb.request.index].buff.data.buz_param.value.freq)
+        if(CB_BUZ_PARAM_DATA1_FREQ_LOWER_LIMIT <= data->buz_param.value.freq &&
+           CB_BUZ_PARAM_DATA1_FREQ_UPPER_LIMIT >= data->buz_param.value.freq)
         {
             next_state = CB_RX_VALIDATE_CRC_STATE;
         }
     }
-    else if(CB_BUZ_PARAM_DATA0_DUTY_CYCLE == cb.request.data[cb.request.index].buff.data.buz_param.type)
+    else if(CB_BUZ_PARAM_DATA0_DUTY_CYCLE == data->buz_param.type)
     {
-        if(CB_BUZ_PARAM_DATA1_DUTY_CYCLE_LOWER_LIMIT <= cb.request.data[cb.request.index].buff.data.buz_param.value.duty_cycle &&
-           CB_BUZ_PARAM_DATA1_DUTY_CYCLE_UPPER_LIMIT >= cb.request.data[cb.request.index].buff.data.buz_param.value.duty_cycle)
+        if(CB_BUZ_PARAM_DATA1_DUTY_CYCLE_LOWER_LIMIT <= data->buz_param.value.duty_cycle &&
+           CB_BUZ_PARAM_DATA1_DUTY_CYCLE_UPPER_LIMIT >= data->buz_param.value.duty_cycle)
         {
             next_state = CB_RX_VALIDATE_CRC_STATE;
         }
@@ -693,13 +566,13 @@ static cbroker_rx_system_state_e cbroker_rx_validate_buz_param_data(void)
     return next_state;
 }
 
-static cbroker_rx_system_state_e cbroker_rx_validate_buz_ctrl_data(void)
+static cbroker_rx_system_state_e cbroker_rx_validate_buz_ctrl_data(const cbroker_request_data_t *const data)
 {
     cbroker_rx_system_state_e            next_state = CB_RX_IDLE_STATE;
     cbroker_buz_ctrl_data0_action_bits_e action_bits =
-        (CB_BUZ_CTRL_DATA0_ACTION_BITS_MASK & cb.request.data[cb.request.index].buff.data.buz_ctrl.data0.action);
+        (CB_BUZ_CTRL_DATA0_ACTION_BITS_MASK & data->buz_ctrl.data0.action);
     cbroker_buz_ctrl_data0_num_cycles_bits_e num_cycles =
-        (CB_BUZ_CTRL_DATA0_CYCLES_BITS_MASK & cb.request.data[cb.request.index].buff.data.buz_ctrl.data0.cycles);
+        (CB_BUZ_CTRL_DATA0_CYCLES_BITS_MASK & data->buz_ctrl.data0.cycles);
 
     if(CB_BUZ_CTRL_DATA0_ACTION_OFF == action_bits || CB_BUZ_CTRL_DATA0_ACTION_ON == action_bits)
     {
@@ -711,13 +584,11 @@ static cbroker_rx_system_state_e cbroker_rx_validate_buz_ctrl_data(void)
     }
     else if(CB_BUZ_CTRL_DATA0_ACTION_BEEP == action_bits)
     {
-        if(CB_BUZ_CTRL_DATA1_BEEPER_ON_LOWER_LIMIT <= cb.request.data[cb.request.index].buff.data.buz_ctrl.beeper_on &&
-           CB_BUZ_CTRL_DATA1_BEEPER_ON_UPPER_LIMIT >= cb.request.data[cb.request.index].buff.data.buz_ctrl.beeper_on)
+        if(CB_BUZ_CTRL_DATA1_BEEPER_ON_LOWER_LIMIT <= data->buz_ctrl.beeper_on &&
+           CB_BUZ_CTRL_DATA1_BEEPER_ON_UPPER_LIMIT >= data->buz_ctrl.beeper_on)
         {
-            if(CB_BUZ_CTRL_DATA2_BEEPER_OFF_LOWER_LIMIT <=
-                   cb.request.data[cb.request.index].buff.data.buz_ctrl.beeper_off &&
-               CB_BUZ_CTRL_DATA2_BEEPER_OFF_UPPER_LIMIT >=
-                   cb.request.data[cb.request.index].buff.data.buz_ctrl.beeper_off)
+            if(CB_BUZ_CTRL_DATA2_BEEPER_OFF_LOWER_LIMIT <= data->buz_ctrl.beeper_off &&
+               CB_BUZ_CTRL_DATA2_BEEPER_OFF_UPPER_LIMIT >= data->buz_ctrl.beeper_off)
             {
                 next_state = CB_RX_VALIDATE_CRC_STATE;
             }
@@ -726,7 +597,7 @@ static cbroker_rx_system_state_e cbroker_rx_validate_buz_ctrl_data(void)
     return next_state;
 }
 
-static uint8_t cbroker_rx_fill_data_buffer(const uint8_t *const pRxByte)
+static uint8_t cbroker_rx_fill_data_buffer(cbroker_t *const self, const uint8_t *const pRxByte)
 {
     /**
      * @brief Command ID to data size table.
@@ -742,18 +613,17 @@ static uint8_t cbroker_rx_fill_data_buffer(const uint8_t *const pRxByte)
         CB_RX_BYTES_IN_BUZ_PARAM_DATA,
         CB_RX_BYTES_IN_BUZ_CTRL_DATA,
     };
-    static uint8_t               nibbles_to_shiff = 0;
-    static uint8_t               saved_bytes_cnt  = 0;
-    uint8_t                      remaining_bytes  = 0;
-    cbroker_cmd_id_e             cmd_id_bits = (CB_CMD_ID_BITS_MASK & cb.request.data[cb.request.index].buff.cmd.id);
+    uint8_t                      remaining_bytes = 0;
+    cbroker_cmd_id_e             cmd_id_bits =
+        (CB_CMD_ID_BITS_MASK & self->request.data[self->request.index].buff.cmd.id);
     cbroker_cmd_id_status_bits_e status_bits =
-        (CB_CMD_ID_STATUS_BITS_MASK & cb.request.data[cb.request.index].buff.cmd.status);
+        (CB_CMD_ID_STATUS_BITS_MASK & self->request.data[self->request.index].buff.cmd.status);
 
     // This flag indicates that an invalid rxByte was detected during AsciiHex to Bin conversion.
     if(CB_CMD_ID_STATUS_BIT_ERR == status_bits)
     {
-        nibbles_to_shiff = 0;
-        saved_bytes_cnt  = 0;
+        self->request.nibbles_to_shiff = 0;
+        self->request.saved_bytes_cnt  = 0;
         return remaining_bytes;
     }
 
@@ -763,28 +633,28 @@ static uint8_t cbroker_rx_fill_data_buffer(const uint8_t *const pRxByte)
     }
 
     // Shifting from/to Most Significant Nibble to Less Significant Nibble.
-    nibbles_to_shiff ^= ((uint8_t)0x01);
+    self->request.nibbles_to_shiff ^= ((uint8_t)0x01);
 
     // Saving the rxByte in to the request buffer data union.
-    cb.request.data[cb.request.index].buff.data.raw[saved_bytes_cnt] =
-        cb.request.data[cb.request.index].buff.data.raw[saved_bytes_cnt] |
-        ((*pRxByte) << (CB_BITS_IN_A_NIBBLE * nibbles_to_shiff));
+    self->request.data[self->request.index].buff.data.raw[self->request.saved_bytes_cnt] =
+        self->request.data[self->request.index].buff.data.raw[self->request.saved_bytes_cnt] |
+        ((*pRxByte) << (CB_BITS_IN_A_NIBBLE * self->request.nibbles_to_shiff));
 
-    if(0 == nibbles_to_shiff)
+    if(0 == self->request.nibbles_to_shiff)
     {
-        saved_bytes_cnt++;
-        remaining_bytes = remaining_bytes - saved_bytes_cnt;
+        self->request.saved_bytes_cnt++;
+        remaining_bytes = remaining_bytes - self->request.saved_bytes_cnt;
         if(0 == remaining_bytes)
         {
-            saved_bytes_cnt = 0;
+            self->request.saved_bytes_cnt = 0;
         }
     }
     return remaining_bytes;
 }
 
-static cbroker_rx_system_state_e cbroker_rx_validate_payload(const uint8_t *const pRxByte)
+static cbroker_rx_system_state_e cbroker_rx_validate_payload(cbroker_t *const self, const uint8_t *const pRxByte)
 {
-    typedef cbroker_rx_system_state_e (*cbroker_payload_validation_handler)(void);
+    typedef cbroker_rx_system_state_e (*cbroker_payload_validation_handler)(const cbroker_request_data_t *const data);
     // clang-format off
     static const cbroker_payload_validation_handler validate_data_functions_table[DISP_CMD_ID_MAX] = {
         NULL, // CB_CMD_ID_UNUSED:       
@@ -803,10 +673,10 @@ static cbroker_rx_system_state_e cbroker_rx_validate_payload(const uint8_t *cons
     uint8_t                      remaining_bytes = 0;
     cbroker_rx_system_state_e    next_state      = CB_RX_VALIDATE_PAYLOAD_STATE;
     cbroker_cmd_id_status_bits_e status_bits =
-        (CB_CMD_ID_STATUS_BITS_MASK & cb.request.data[cb.request.index].buff.cmd.status);
-    cbroker_cmd_id_e cmd_id_bits = (CB_CMD_ID_BITS_MASK & cb.request.data[cb.request.index].buff.cmd.id);
+        (CB_CMD_ID_STATUS_BITS_MASK & self->request.data[self->request.index].buff.cmd.status);
+    cbroker_cmd_id_e cmd_id_bits = (CB_CMD_ID_BITS_MASK & self->request.data[self->request.index].buff.cmd.id);
 
-    remaining_bytes = cbroker_rx_fill_data_buffer(pRxByte);
+    remaining_bytes = cbroker_rx_fill_data_buffer(self, pRxByte);
 
     if(CB_CMD_ID_STATUS_BIT_NO_ERR == status_bits)
     {
@@ -817,7 +687,8 @@ static cbroker_rx_system_state_e cbroker_rx_validate_payload(const uint8_t *cons
             if(validate_data_functions_table[cmd_id_bits] != NULL)
             {
                 // Call the data validation function assigned to the current command id.
-                next_state = ((*validate_data_functions_table[cmd_id_bits]))();
+                next_state =
+                    ((*validate_data_functions_table[cmd_id_bits]))(&self->request.data[self->request.index].buff.data);
             }
         }
     }
@@ -828,34 +699,35 @@ static cbroker_rx_system_state_e cbroker_rx_validate_payload(const uint8_t *cons
     if(CB_RX_IDLE_STATE == next_state)
     {
         // Set error flag to unexpected payload data.
-        cbroker_rx_set_status_bit(CB_CMD_ID_STATUS_BIT_ERR);
+        cbroker_rx_set_status_bit(self, CB_CMD_ID_STATUS_BIT_ERR);
         CB_PRINTF("CB - [Rx]: PN=0x%.4X, ST=0x%.2X, ID=0x%.2X, Err=Unexpected payload data\r\n",
-                  cb.request.data[cb.request.index].buff.packet_number,
-                  (CB_CMD_ID_STATUS_BITS_MASK & cb.request.data[cb.request.index].buff.cmd.id_with_status),
-                  (CB_CMD_ID_BITS_MASK & cb.request.data[cb.request.index].buff.cmd.id));
+                  self->request.data[self->request.index].buff.packet_number,
+                  (CB_CMD_ID_STATUS_BITS_MASK & self->request.data[self->request.index].buff.cmd.id_with_status),
+                  (CB_CMD_ID_BITS_MASK & self->request.data[self->request.index].buff.cmd.id));
         // Queue ACK response with error bit flag.
-        cbroker_tx_send_response();
+        cbroker_tx_send_response(self);
     }
     return next_state;
 }
 
-static cbroker_rx_system_state_e cbroker_rx_validate_crc16(const uint8_t *const pRxByte)
+static cbroker_rx_system_state_e cbroker_rx_validate_crc16(cbroker_t *const self, const uint8_t *const pRxByte)
 {
-    static uint8_t            nibbles_cnt = (CB_BYTES_IN_CRC16_ARC * CB_NIBBLES_IN_A_BYTE);
-    cbroker_rx_system_state_e next_state  = CB_RX_VALIDATE_CRC_STATE;
+    cbroker_rx_system_state_e next_state = CB_RX_VALIDATE_CRC_STATE;
 
-    nibbles_cnt--;
+    self->request.remaining_crc_nibbles--;
 
     // Adding every single nibble to crc16 received.
-    cb.request.data[cb.request.index].buff.crc16_received =
-        cb.request.data[cb.request.index].buff.crc16_received | ((*pRxByte) << (CB_BITS_IN_A_NIBBLE * nibbles_cnt));
+    self->request.data[self->request.index].buff.crc16_received =
+        self->request.data[self->request.index].buff.crc16_received |
+        ((*pRxByte) << (CB_BITS_IN_A_NIBBLE * self->request.remaining_crc_nibbles));
 
-    if(0 == nibbles_cnt)
+    if(0 == self->request.remaining_crc_nibbles)
     {
-        // Restart nibbles_cnt for the next request message.
-        nibbles_cnt = (CB_BYTES_IN_CRC16_ARC * CB_NIBBLES_IN_A_BYTE);
+        // Restart self->request.remaining_crc_nibbles for the next request message.
+        self->request.remaining_crc_nibbles = (CB_BYTES_IN_CRC16_ARC * CB_NIBBLES_IN_A_BYTE);
 
-        if(cb.request.data[cb.request.index].buff.crc16_received == cb.request.data[cb.request.index].crc16_calc)
+        if(self->request.data[self->request.index].buff.crc16_received ==
+           self->request.data[self->request.index].crc16_calc)
         {
             // Next state waits for ETX byte.
             next_state = CB_RX_VALIDATE_FRAME_STATE;
@@ -863,15 +735,16 @@ static cbroker_rx_system_state_e cbroker_rx_validate_crc16(const uint8_t *const
         else
         {
             // Set error flag to CRC mismatching.
-            cbroker_rx_set_status_bit(CB_CMD_ID_STATUS_BIT_ERR);
+            cbroker_rx_set_status_bit(self, CB_CMD_ID_STATUS_BIT_ERR);
             CB_PRINTF(
                 "CB - [Rx]: PN=0x%.4X, ST=0x%.2X,  ID=0x%.2X, Err=CRC mismatching (Rec:0x%.4X vs Calc: 0x%.4X)\r\n",
-                cb.request.data[cb.request.index].buff.packet_number,
-                (CB_CMD_ID_STATUS_BITS_MASK & cb.request.data[cb.request.index].buff.cmd.id_with_status),
-                (CB_CMD_ID_BITS_MASK & cb.request.data[cb.request.index].buff.cmd.id),
-                cb.request.data[cb.request.index].buff.crc16_received, cb.request.data[cb.request.index].crc16_calc);
+                self->request.data[self->request.index].buff.packet_number,
+                (CB_CMD_ID_STATUS_BITS_MASK & self->request.data[self->request.index].buff.cmd.id_with_status),
+                (CB_CMD_ID_BITS_MASK & self->request.data[self->request.index].buff.cmd.id),
+                self->request.data[self->request.index].buff.crc16_received,
+                self->request.data[self->request.index].crc16_calc);
             // Queue ACK response with error bit flag.
-            cbroker_tx_send_response();
+            cbroker_tx_send_response(self);
             next_state = CB_RX_IDLE_STATE;
         }
     }
@@ -879,7 +752,7 @@ static cbroker_rx_system_state_e cbroker_rx_validate_crc16(const uint8_t *const
     return next_state;
 }
 
-static void cbroker_rx_byte(uint8_t rxByte)
+static void cbroker_rx_byte(cbroker_t *const self, uint8_t rxByte)
 {
     /**
      * @brief Initialize array of structure with states with proper handler.
@@ -891,31 +764,33 @@ static void cbroker_rx_byte(uint8_t rxByte)
         {CB_RX_VALIDATE_CMD_ID_STATE, cbroker_rx_validate_cmd_id},
         {CB_RX_VALIDATE_PAYLOAD_STATE, cbroker_rx_validate_payload},
         {CB_RX_VALIDATE_CRC_STATE, cbroker_rx_validate_crc16}};
+    PERF_PROBE_BEGIN(PERF_PROBE_CBROKER_RX_BYTE)
 
-    if((CB_RX_MAX_STATE > cb.request.next_state) && (state_machine[cb.request.next_state].handler != NULL))
+    if((CB_RX_MAX_STATE > self->request.next_state) && (state_machine[self->request.next_state].handler != NULL))
     {
         // Command frame bytes are already in binary format.
-        if(state_machine[cb.request.next_state].handler != cbroker_rx_validate_frame)
+        if(state_machine[self->request.next_state].handler != cbroker_rx_validate_frame)
         {
             // CRC is calculated over Packet Number to end of Data.
-            if(state_machine[cb.request.next_state].handler != cbroker_rx_validate_crc16)
+            if(state_machine[self->request.next_state].handler != cbroker_rx_validate_crc16)
             {
                 // Compute incoming byte CRC.
-                cb.request.data[cb.request.index].crc16_calc =
-                    cborker_calc_crc16arc(cb.request.data[cb.request.index].crc16_calc, &rxByte, 1);
+                self->request.data[self->request.index].crc16_calc =
+                    cborker_calc_crc16arc(self->request.data[self->request.index].crc16_calc, &rxByte, 1);
             }
 
             // Casting the rxByte from AsciiHex format to binary format. (Only from Packet Number to end of CRC)
-            cbroker_rx_asciihex_to_bin(&rxByte);
+            cbroker_rx_asciihex_to_bin(self, &rxByte);
         }
 
         // Function call as per the state and event and return the next state of the finite state machine.
-        cb.request.next_state = ((*state_machine[cb.request.next_state].handler)(&rxByte));
+        self->request.next_state = ((*state_machine[self->request.next_state].handler)(self, &rxByte));
     }
     else
     {
         // Invalid
     }
+    PERF_PROBE_END(PERF_PROBE_CBROKER_RX_BYTE)
 }
 
 /******************************************** SERIAL COMMUNICATION FUNCTIONS *****************************************/
@@ -923,20 +798,30 @@ static void cbroker_rx_byte(uint8_t rxByte)
 static uint8_t cbroker_sercom_rx_callback(uint8_t status, uint8_t *data, size_t size)
 {
     (void)size;
-    cbroker_rx_byte(data[0]);
-    cb.sercomm->read_non_blocking(cb.sercomm->handle, &cb.request.rxbyte, 1, cbroker_sercom_rx_callback);
+    cbroker_t *self = CB_SELF_FROM_MEMBER(data, request.rxbyte);
+
+    cbroker_rx_byte(self, data[0]);
+    self->sercomm->read_non_blocking(self->sercomm->handle, &self->request.rxbyte, 1, cbroker_sercom_rx_callback);
     return status;
 }
 
-uint8_t cbroker_init(base_driver *sercomm, cbroker_request_callback_t callback)
+uint8_t cbroker_init(cbroker_t *self, base_driver *sercomm, cbroker_request_callback_t callback, void *arg)
 {
-    uint8_t err         = 0;
-    cb.sercomm          = sercomm;
-    cb.request.callback = callback;
+    uint8_t err = 0;
+
+    memset(self, 0x00, sizeof(cbroker_t));
+    self->sercomm                          = sercomm;
+    self->request.callback                 = callback;
+    self->request.arg                      = arg;
+    self->request.next_state               = CB_RX_IDLE_STATE;
+    self->request.remaining_frame_bytes    = CB_BYTES_IN_FRAME;
+    self->request.remaining_pn_nibbles     = (CB_BYTES_IN_PACKET_NUMBER * CB_NIBBLES_IN_A_BYTE);
+    self->request.remaining_cmd_id_nibbles = (CB_BYTES_IN_CMD_ID * CB_NIBBLES_IN_A_BYTE);
+    self->request.remaining_crc_nibbles    = (CB_BYTES_IN_CRC16_ARC * CB_NIBBLES_IN_A_BYTE);
 
-    if(NULL != cb.sercomm->handle && NULL != cb.request.callback)
+    if(NULL != self->sercomm->handle && NULL != self->request.callback)
     {
-        cb.sercomm->read_non_blocking(cb.sercomm->handle, &cb.request.rxbyte, 1, cbroker_sercom_rx_callback);
+        self->sercomm->read_non_blocking(self->sercomm->handle, &self->request.rxbyte, 1, cbroker_sercom_rx_callback);
     }
     else
     {
@@ -17,104 +17,124 @@
  * at no charge.
  */
 #include <stdarg.h>
+#include <stddef.h>
 #include "debug_log.h"
 
-#define DEBUG_LOG_BUFF_SIZE ((size_t)1024)
 /**
- * @brief Main Debug Logger Struct.
+ * @brief Recovers the logger that owns the byte handed back by the serial communication driver.
  */
-typedef struct debug_log
-{
-    int8_t       buff[DEBUG_LOG_BUFF_SIZE];
-    int32_t      start;           ///<  Read index.
-    int32_t      end;             ///<  Write index.
-    uint8_t      is_transmitting; ///< Flag to indicate if sercomm is transmitting.
-    base_driver *sercomm;         ///< Pointer to structure represents, base serial communication driver.
-} debug_log_t;
+#define DEBUG_LOG_SELF_FROM_TX_BYTE(ptr) ((debug_log_t *)(void *)((uint8_t *)(ptr)-offsetof(debug_log_t, tx_byte)))
 
 #if DEBUG_LOG_ENABLE == true
 
-static debug_log_t logger = {.start = 0, .end = 0, .is_transmitting = false};
+//"default_logger" is the logger used by debug_log_print() and the *_PRINTF macros.
+static debug_log_t *default_logger = NULL;
 
-static int8_t *debug_log_get_char()
+static uint8_t *debug_log_get_char(debug_log_t *const self)
 {
-    int8_t *pItem = &logger.buff[logger.start++];
-    logger.start %= DEBUG_LOG_BUFF_SIZE;
-    return pItem;
+    self->tx_byte = (uint8_t)self->buff[self->start++];
+    self->start %= DEBUG_LOG_BUFF_SIZE;
+    return &self->tx_byte;
 }
 
-static void debug_log_put_char(int8_t item)
+static void debug_log_put_char(debug_log_t *const self, int8_t item)
 {
-    logger.buff[logger.end++] = item;
-    logger.end %= DEBUG_LOG_BUFF_SIZE;
+    self->buff[self->end++] = item;
+    self->end %= DEBUG_LOG_BUFF_SIZE;
 }
 
-static uint8_t debug_log_tx_callback(uint8_t status, size_t size)
+static uint8_t debug_log_tx_callback(uint8_t status, uint8_t *data, size_t size)
 {
     (void)size;
-    if(logger.start != logger.end)
+    debug_log_t *self = DEBUG_LOG_SELF_FROM_TX_BYTE(data);
+
+    if(self->start != self->end)
     {
-        logger.sercomm->write_non_blocking(logger.sercomm->handle, debug_log_get_char(), 1, debug_log_tx_callback);
+        self->sercomm->write_non_blocking(self->sercomm->handle, debug_log_get_char(self), 1, debug_log_tx_callback);
     }
     else
     {
-        logger.is_transmitting = false;
+        self->is_transmitting = false;
     }
 
     return status;
 }
 
-static void debug_log_start_transmission(void)
+static void debug_log_start_transmission(debug_log_t *const self)
 {
     // If the response state machine is already transmitting this response will be sent in FIFO order.
-    if(false == logger.is_transmitting)
+    if(false == self->is_transmitting)
     {
-        if(logger.start != logger.end)
+        if(self->start != self->end)
         {
-            logger.is_transmitting = true;
-            logger.sercomm->write_non_blocking(logger.sercomm->handle, debug_log_get_char(), 1, debug_log_tx_callback);
+            self->is_transmitting = true;
+            self->sercomm->write_non_blocking(self->sercomm->handle, debug_log_get_char(self), 1,
+                                              debug_log_tx_callback);
         }
     }
 }
 
-static void debug_log_queue_msg(const int8_t *str)
+static void debug_log_queue_msg(debug_log_t *const self, const int8_t *str)
 {
     uint32_t c = 0;
     while(str[c])
     {
-        debug_log_put_char(str[c++]);
-        debug_log_start_transmission();
+        debug_log_put_char(self, str[c++]);
+        debug_log_start_transmission(self);
     }
 }
-#endif /* DEBUG_LOG_ENABLE */
 
-void debug_log_print(const int8_t *format, ...)
+static void debug_log_vwrite(debug_log_t *const self, const int8_t *format, va_list args)
 {
-#if DEBUG_LOG_ENABLE == true
-    if(NULL != logger.sercomm)
+    if((NULL != self) && (NULL != self->sercomm))
     {
-        int8_t  str[DEBUG_LOG_BUFF_SIZE];
-        va_list args;
-        va_start(args, format);
+        int8_t str[DEBUG_LOG_BUFF_SIZE];
         vsnprintf((char *)str, DEBUG_LOG_BUFF_SIZE, (const char *)format, args);
-        va_end(args);
-        debug_log_queue_msg(str);
+        debug_log_queue_msg(self, str);
     }
+}
+#endif /* DEBUG_LOG_ENABLE */
+
+void debug_log_write(debug_log_t *const self, const int8_t *format, ...)
+{
+#if DEBUG_LOG_ENABLE == true
+    va_list args;
+    va_start(args, format);
+    debug_log_vwrite(self, format, args);
+    va_end(args);
+#else
+    (void)self;
+    (void)format;
+#endif /* DEBUG_LOG_ENABLE */
+}
+
+void debug_log_print(const int8_t *format, ...)
+{
+#if DEBUG_LOG_ENABLE == true
+    va_list args;
+    va_start(args, format);
+    debug_log_vwrite(default_logger, format, args);
+    va_end(args);
 #else
     (void)format;
 #endif /* DEBUG_LOG_ENABLE */
 }
 
-uint8_t debug_log_init(base_driver *sercomm)
+uint8_t debug_log_init(debug_log_t *const self, base_driver *sercomm)
 {
     uint8_t err = 1;
 #if DEBUG_LOG_ENABLE == true
-    logger.sercomm = sercomm;
-    if(NULL != logger.sercomm)
+    self->start           = 0;
+    self->end             = 0;
+    self->is_transmitting = false;
+    self->sercomm         = sercomm;
+    if(NULL != self->sercomm)
     {
-        err = 0;
+        default_logger = self;
+        err            = 0;
     }
 #else
+    (void)self;
     (void)sercomm;
 #endif /* DEBUG_LOG_ENABLE */
 
@@ -17,6 +17,7 @@
  * at no charge.
  */
 
+#include <stddef.h>
 #include <string.h>
 #include <stdlib.h>
 
@@ -27,28 +28,12 @@
 #include "lcd.h"
 
 #include "em_common.h"
+#include "em_core.h"
 #include "sl_sleeptimer.h"
 #include "lcd_font_4_22.h"
+#include "perf_probe.h"
 /*--------------------------- UC1601s display driver for 5 predefined lines: -----------------------------------*/
 
-typedef struct
-{
-    uint8_t line[NUM_PIX_COL_PER_ROW_BYTES];
-    uint8_t state;
-} line_def;
-
-typedef struct
-{
-    bool    is_blinking;
-    uint8_t my_char;
-    uint8_t state;
-    uint8_t buffer_shift;
-    uint8_t line_size;
-    uint8_t position;
-} char_context_t;
-
-static base_driver * lcd_sercomm_instance;
-
 #define LCD_SET_COL_L 0x00 // set column address LSB, CA[3:0]
 #define LCD_SET_COL_H 0x10 // set column address MSB, CA[7:4]
 #define LCD_SET_TC 0x24    // set temperature compensation, TC[1:0]
@@ -123,13 +108,19 @@ static base_driver * lcd_sercomm_instance;
 #define ASCII_CHAR_ENABLED (0xFF) // Definition for enabled byte value
 #define PIXELS_BEF_RIGHT_BUTTON (3) //definition for pixels before rightmost button
 #define INVERTED_LINE_GAP ((LCD_LINE_PIXEL_HEIGHT - CHARACTER_HEIGHT)/2) // Defintion for inverted line gap between character and a border of line
+#define GLYPH_ROWS_MAX (16) // Rows of a column value, an inverted line taller than that is not inverted whole
 
 #define LEFT_ALIGNMENT_BYTE (0) // Definition of number left alignment thing/button
 #define RIGHT_ALIGNMENT_BYTE (LCD_CHAR_NUM - 1) // Definition of number right alignment thing/button
 #define FORMAT_BYTE_CHAR (1) // Definition of number format byte position
 #define PRINT_LINE_CHARS (2) // Definition start number of printable characters
 #define BIT_SHIFT_COMPENSATION (2)
-#define SCREEN_UPDATE_INTERLEAVE_CNT (8) // It requires to not update lcd buffer lines very frequently to avoid data racing
+#define LCD_DATA_FRAME (0x100) // 9th bit of a SPI frame drives the CD line: display data instead of a command
+#define LCD_DIRTY_BIT(col) ((uint16_t)(1U << ((col) / LCD_DIRTY_BLOCK_COLS))) // Dirty bitmap bit of a column
+#define LCD_DIRTY_ALL (0xFFFF) // Every block of a page
+#define LCD_ROWS (NUM_PIX_ROW_PER_COL_BYTES * 8) // Panel rows
+#define LCD_RAM_ROWS (64) // Panel RAM rows the scroll line wraps on
+#define LCD_SELF_FROM_BURST(ptr) ((lcd_t *)(void *)((uint8_t *)(ptr)-offsetof(lcd_t, burst.frames))) // Display owning a page transfer
 
 #define DEFAULT_ALIGNMENT (al_left) // Default alignment value def
 
@@ -141,126 +132,507 @@ static base_driver * lcd_sercomm_instance;
 #define LINE_ALIGNMENT_CENTER   (LINE_ALIGNMENT_LEFT + LINE_ALIGNMENT_RIGHT) // definition for center alignment flag - combination of left and right
 #define LINE_BLINKED            (1 << 7)    // definition for line blinking flag
 
+// Rows of a text line in a column word: bit n is row n, the 6 pages of a column fit in 48 bits
+typedef struct
+{
+    uint64_t mask;  // Rows of the line
+    uint8_t  shift; // First row of the line
+    uint8_t  first; // First page the line covers
+    uint8_t  last;  // Last page, first > last for none
+} lcd_span_t;
+
 /*Local Prototypes*/
 
 // Default display layout definition
-static lcd_line_t internal_lcd_layout[LCD_LINE_NUM] = {{0, LCD_LINE_PIXEL_HEIGHT}, {4, LCD_LINE_PIXEL_HEIGHT}, {0, LCD_LINE_PIXEL_HEIGHT}, {2, LCD_LINE_PIXEL_HEIGHT}};
+static const lcd_line_t default_lcd_layout[LCD_LINE_NUM] = {{0, LCD_LINE_PIXEL_HEIGHT}, {4, LCD_LINE_PIXEL_HEIGHT}, {0, LCD_LINE_PIXEL_HEIGHT}, {2, LCD_LINE_PIXEL_HEIGHT}};
 
-// Just a buffer to prevent display from unwanted update
-static uint8_t cached_str[LCD_LINE_NUM][LCD_CHAR_NUM] = {0};
+/* static uint8_t reverse_byte(uint8_t value)
+{
+    // The hack was brought from here - https://graphics.stanford.edu/~seander/bithacks.html#BitReverseObvious
+    return (value * 0x0202020202ULL & 0x010884422010ULL) % 1023;
+} */
 
-// Buffer for 8 bit rows screen
-static line_def line_buf[NUM_PIX_ROW_PER_COL_BYTES];
+static bool burst_next(lcd_t *self);
 
-// Buffer to save lines states
-static uint8_t line_update_state[NUM_PIX_ROW_PER_COL_BYTES] = {1,1,1,1,1,1};
+// Flags blocks of a page to be sent again, from the main loop or from the SPI completion
+static void burst_redirty(lcd_t *self, uint8_t page, uint16_t dirty)
+{
+    CORE_DECLARE_IRQ_STATE;
 
-// blinking tasks - 1 per line
-static char_context_t blink_tasks[LCD_LINE_NUM] = {0};
+    CORE_ENTER_ATOMIC();
+    self->front_dirty[page] |= dirty;
+    self->shadow_valid &= ~(1 << page);
+    CORE_EXIT_ATOMIC();
+}
 
-static sl_sleeptimer_timer_handle_t task_timer_handler;
+// The transfer did not make it to the panel, what it carried is sent again on the next pass and in full
+static void burst_failed(lcd_t *self)
+{
+    if(self->burst.effects)
+    {
+        self->effects_valid = false;
+    }
+    else
+    {
+        burst_redirty(self, self->burst.page, self->burst.dirty);
+    }
+}
 
-/* static uint8_t reverse_byte(uint8_t value)
+// SPI DMA completion of a page transfer, interrupt context
+static uint8_t burst_done(uint8_t status, uint8_t *data, size_t size)
 {
-    // The hack was brought from here - https://graphics.stanford.edu/~seander/bithacks.html#BitReverseObvious
-    return (value * 0x0202020202ULL & 0x010884422010ULL) % 1023;
-} */
+    lcd_t *self = LCD_SELF_FROM_BURST(data);
+    (void)size;
+
+    if(status != 0)
+    {
+        burst_failed(self);
+    }
+    self->burst.busy = false;
 
-static void wr_8bit_command(uint8_t data)
+    // A failed transfer ends the flush instead of retrying from the interrupt
+    if(self->burst.flushing && (status != 0 || !burst_next(self)))
+    {
+        self->burst.flushing = false;
+        if(self->burst.callback)
+        {
+            self->burst.callback(self, self->burst.callback_arg);
+        }
+    }
+    return 0;
+}
+
+// Frames that move the column address from one column to another: COL_L and COL_H are separate registers
+static uint8_t burst_address_cost(uint8_t from, uint8_t to)
 {
-    uint16_t _data = data;
-    EFM_ASSERT(lcd_sercomm_instance->write_non_blocking(lcd_sercomm_instance->handle, (uint8_t *)&_data, 1, 0) == 0);
+    return (((from ^ to) & 0x0F) ? 1 : 0) + (((from ^ to) >> 4) ? 1 : 0);
 }
 
-static void wr_9bit_data(const uint8_t * data)
+// Builds the cheapest frames taking the panel from the shadow to the line buffer, the shadow is updated on the way.
+// Every frame costs the same 9 bits: a run of unchanged columns shorter than a re-address is streamed through.
+// Each gap is decided on its own since both choices end on the same column: the sum of the choices is the optimum.
+// Only the dirty blocks can differ from the shadow, the others are skipped without being read
+static size_t burst_encode(lcd_t *self, uint8_t page, const uint8_t *line, uint16_t dirty)
 {
-    uint16_t _data = 0x100 | *data;
-    EFM_ASSERT(lcd_sercomm_instance->write_non_blocking(lcd_sercomm_instance->handle, (uint8_t *)&_data, 1, 0) == 0);
+    uint8_t       *shadow    = self->shadow[page];
+    uint16_t      *frame     = self->burst.frames;
+    bool           full      = !(self->shadow_valid & (1 << page));
+    bool           addressed = false;
+    uint8_t        col_next  = 0; // Column the controller writes next
+
+    for(uint8_t col = 0; col < NUM_PIX_COL_PER_ROW_BYTES; col++)
+    {
+        if(!full && !(dirty & LCD_DIRTY_BIT(col)))
+        {
+            col |= LCD_DIRTY_BLOCK_COLS - 1; // Last column of the block, the loop goes on with the next one
+            continue;
+        }
+        if(!full && line[col] == shadow[col])
+        {
+            continue;
+        }
+
+        if(!addressed)
+        {
+            *frame++  = LCD_SET_PAGE | page;
+            *frame++  = LCD_SET_COL_L | (col & 0x0F);
+            *frame++  = LCD_SET_COL_H | (col >> 4);
+            addressed = true;
+        }
+        else if((col - col_next) <= burst_address_cost(col_next, col))
+        {
+            for(; col_next < col; col_next++)
+            {
+                *frame++ = LCD_DATA_FRAME | line[col_next];
+            }
+        }
+        else
+        {
+            if((col ^ col_next) & 0x0F)
+            {
+                *frame++ = LCD_SET_COL_L | (col & 0x0F);
+            }
+            if((col ^ col_next) >> 4)
+            {
+                *frame++ = LCD_SET_COL_H | (col >> 4);
+            }
+        }
+
+        *frame++    = LCD_DATA_FRAME | line[col];
+        shadow[col] = line[col];
+        col_next    = col + 1;
+    }
+
+    if(!addressed)
+    {
+        return 0;
+    }
+
+    *frame++ = LCD_SET_EN | LCD_ENABLE; // turn display on
+    self->shadow_valid |= (1 << page);
+    return frame - self->burst.frames;
 }
 
-static uint8_t generate_mask(uint8_t start_value, uint8_t size)
+static bool burst_send(lcd_t *self, uint8_t page, uint16_t dirty, size_t size)
 {
-    uint8_t res = 0;
-    for(uint8_t cnt = 0; cnt < size; cnt++)
+    // Busy before the transfer starts: the completion may run before write_non_blocking() returns
+    self->burst.page  = page;
+    self->burst.dirty = dirty;
+    self->burst.busy  = true;
+    if(self->sercomm->write_non_blocking(self->sercomm->handle, (uint8_t *)self->burst.frames, size, burst_done) != 0)
     {
-        res += 1 << (start_value + cnt);
+        self->burst.busy = false;
+        burst_failed(self);
+        return false;
     }
-    return res;
+    return true;
 }
 
-// the function writes 10 bits value to 6x8x128 bits array
-static void write_buff_8_bits(uint16_t value, uint8_t start_bit, uint8_t size, uint8_t pos)
+// Sends commands as one page transfer: SPIDRV refuses a transfer while the previous one is on the wire, and the flush
+// waits for the end of the burst before it sends a page
+static bool burst_commands(lcd_t *self, const uint16_t *frames, size_t count)
 {
-    #define BIT_8_CONVERSION_DEF (8)
-    #define RECURSION_LEVEL (2)
+    memcpy(self->burst.frames, frames, count * sizeof(frames[0]));
+    self->burst.effects = true;
+    return burst_send(self, self->burst.page, 0, count);
+}
 
-    static uint8_t current_line[RECURSION_LEVEL] = {255, 255};
-    static uint8_t start_mask[RECURSION_LEVEL];
-    static uint8_t bits_to_write[RECURSION_LEVEL];
-    static uint8_t mask[RECURSION_LEVEL];
-    uint8_t rlevel = 0;
-    static div_t div_context;
+#if LCD_GRAY_ENABLE == true
+// Pixels of a grayscale sub-frame: light pixels are dark in the first one, dark pixels in the first two. Sub-frame 0 is
+// line_buf alone, gray pixels included: light ones are white, dark ones black
+static void gray_compose(const lcd_t *self, uint8_t page, uint8_t *line)
+{
+    uint8_t        subframe = self->gray_blocks[page] ? self->gray_subframe : 0;
+    const uint8_t *gray     = self->front_gray[page];
 
-    if(size <= 0)
+    if(subframe == 0)
     {
         return;
     }
+    for(uint8_t col = 0; col < NUM_PIX_COL_PER_ROW_BYTES; col++)
+    {
+        line[col] = (subframe == 1) ? (line[col] | gray[col]) : (line[col] & ~gray[col]);
+    }
+}
+
+// Commits a block of the gray plane with its line_buf block
+static void gray_commit_block(lcd_t *self, uint8_t page, uint8_t col)
+{
+    uint64_t gray;
+
+    memcpy(&gray, &self->gray_buf[page][col], sizeof(gray));
+    memcpy(&self->front_gray[page][col], &gray, sizeof(gray));
+    if(gray != 0)
+    {
+        self->gray_blocks[page] |= LCD_DIRTY_BIT(col);
+    }
+    else
+    {
+        self->gray_blocks[page] &= ~LCD_DIRTY_BIT(col);
+    }
+}
+
+// Clears the gray plane, the blocks that held gray pixels are flagged
+static void gray_plane_clear(lcd_t *self)
+{
+    for(uint8_t page = 0; page < NUM_PIX_ROW_PER_COL_BYTES; page++)
+    {
+        if(!(self->gray_pages & (1U << page)))
+        {
+            continue;
+        }
+        for(uint8_t col = 0; col < NUM_PIX_COL_PER_ROW_BYTES; col += LCD_DIRTY_BLOCK_COLS)
+        {
+            uint64_t gray;
+
+            memcpy(&gray, &self->gray_buf[page][col], sizeof(gray));
+            if(gray != 0)
+            {
+                memset(&self->gray_buf[page][col], 0, LCD_DIRTY_BLOCK_COLS);
+                self->line_dirty[page] |= LCD_DIRTY_BIT(col);
+            }
+        }
+    }
+    self->gray_pages = 0;
+}
+
+// Text is black and white: the gray levels under a text line go with its render
+static void gray_clear(lcd_t *self, const lcd_span_t *span)
+{
+    for(uint8_t page = span->first; page <= span->last; page++)
+    {
+        uint8_t rows = (uint8_t)(span->mask >> (page * 8));
 
-    if (size < LCD_LINE_PIXEL_HEIGHT) {
-        rlevel = 1;
+        if(!(self->gray_pages & (1U << page)))
+        {
+            continue;
+        }
+        for(uint8_t col = 0; col < NUM_PIX_COL_PER_ROW_BYTES; col++)
+        {
+            if(self->gray_buf[page][col] & rows)
+            {
+                self->gray_buf[page][col] &= (uint8_t)~rows;
+                self->line_dirty[page] |= LCD_DIRTY_BIT(col);
+            }
+        }
     }
+}
+#else
+// Black and white only: the frames go out as drawn
+static void gray_compose(const lcd_t *self, uint8_t page, uint8_t *line)
+{
+    (void)self;
+    (void)page;
+    (void)line;
+}
+
+static void gray_commit_block(lcd_t *self, uint8_t page, uint8_t col)
+{
+    (void)self;
+    (void)page;
+    (void)col;
+}
+
+static void gray_plane_clear(lcd_t *self)
+{
+    (void)self;
+}
 
-    div_context = div(start_bit, BIT_8_CONVERSION_DEF);
-    uint8_t line_num   = div_context.quot;
+static void gray_clear(lcd_t *self, const lcd_span_t *span)
+{
+    (void)self;
+    (void)span;
+}
+#endif /* LCD_GRAY_ENABLE */
 
-    if(line_num != current_line[rlevel])
+// Sends the blocks of the page committed since it was last sent
+static bool burst_page(lcd_t *self, uint8_t page)
+{
+    uint8_t  line[NUM_PIX_COL_PER_ROW_BYTES];
+    uint16_t dirty;
+    size_t   size;
+    CORE_DECLARE_IRQ_STATE;
+
+    if(self->front_dirty[page] == 0)
     {
-        current_line[rlevel] = line_num;
+        return false;
+    }
 
-        start_mask[rlevel] = div_context.rem;
+    // A commit from an interrupt can not land in the middle of the page: it is copied out with its dirty blocks
+    CORE_ENTER_ATOMIC();
+    dirty                   = self->front_dirty[page];
+    self->front_dirty[page] = 0;
+    memcpy(line, self->front_buf[page], sizeof(line));
+    gray_compose(self, page, line);
+    CORE_EXIT_ATOMIC();
 
-        bits_to_write[rlevel] = BIT_8_CONVERSION_DEF - start_mask[rlevel];
+    size = burst_encode(self, page, line, dirty);
+    if(size == 0)
+    {
+        // Written over with the same pixels, the panel already shows them
+        return false;
+    }
+    self->burst.effects = false;
+    return burst_send(self, page, dirty, size);
+}
 
-        if(bits_to_write[rlevel] > size)
+// Sends the controller effects changed since they were last sent, a few commands and no display data
+static bool burst_effects(lcd_t *self)
+{
+    lcd_effects_t  wanted;
+    lcd_effects_t *sent  = &self->effects_sent;
+    uint16_t      *frame = self->burst.frames;
+    bool           all   = !self->effects_valid;
+    CORE_DECLARE_IRQ_STATE;
+
+    CORE_ENTER_ATOMIC();
+    wanted = self->effects;
+    CORE_EXIT_ATOMIC();
+
+    if(all || wanted.inverse != sent->inverse)
+    {
+        *frame++ = LCD_SET_INV | (wanted.inverse ? LCD_INVERSE : 0);
+    }
+    if(all || wanted.all_on != sent->all_on)
+    {
+        *frame++ = LCD_SET_PON | (wanted.all_on ? LCD_ALL_ON : 0);
+    }
+    if(all || wanted.scroll_line != sent->scroll_line)
+    {
+        *frame++ = LCD_SET_SL | wanted.scroll_line;
+    }
+    if(all || wanted.window != sent->window || wanted.window_first != sent->window_first ||
+       wanted.window_last != sent->window_last)
+    {
+        if(wanted.window)
         {
-            bits_to_write[rlevel] = size;
+            *frame++ = LCD_SET_DST;
+            *frame++ = wanted.window_first;
+            *frame++ = LCD_SET_DEN;
+            *frame++ = wanted.window_last;
         }
+        *frame++ = LCD_SET_PART | (wanted.window ? LCD_ENA_PD : LCD_DIS_PD);
+    }
+    if(wanted.contrast_set && (all || !sent->contrast_set || wanted.contrast != sent->contrast))
+    {
+        *frame++ = LCD_SET_BIAS;
+        *frame++ = wanted.contrast;
+    }
 
-        mask[rlevel] = generate_mask(start_mask[rlevel], bits_to_write[rlevel]);
+    if(frame == self->burst.frames)
+    {
+        return false;
     }
+    *sent               = wanted;
+    self->effects_valid = true;
+    self->burst.effects = true;
+    return burst_send(self, self->burst.page, 0, frame - self->burst.frames);
+}
 
-    line_buf[line_num].line[pos] &= ~mask[rlevel];
-    line_buf[line_num].line[pos] ^= (value << start_mask[rlevel]) & mask[rlevel];
+// Sends the next changed page, round robin from the last one checked
+static bool burst_next(lcd_t *self)
+{
+    bool return_code;
+    PERF_PROBE_BEGIN(PERF_PROBE_LCD_FLUSH_PAGE)
 
-    if (!(pos % SCREEN_UPDATE_INTERLEAVE_CNT)) {
-        line_buf[line_num].state++;
+    // The effects go first, they are a handful of frames
+    return_code = burst_effects(self);
+    for(uint8_t cnt = 0; (cnt < NUM_PIX_ROW_PER_COL_BYTES) && !return_code; cnt++)
+    {
+        if(++self->i_lin_s >= NUM_PIX_ROW_PER_COL_BYTES)
+        {
+            self->i_lin_s = 0;
+        }
+        return_code = burst_page(self, self->i_lin_s);
     }
 
-    write_buff_8_bits(value >> bits_to_write[rlevel], start_bit + bits_to_write[rlevel], size - bits_to_write[rlevel], pos);
+    PERF_PROBE_END(PERF_PROBE_LCD_FLUSH_PAGE)
+    return return_code;
 }
 
-//The function checks the icon borders
-static bool get_icon_borders(const font_char *in_icon, uint8_t *left_border, uint8_t *right_border)
+// Rows of a text line in the column word, computed once per line. Rows below the panel are left out
+static lcd_span_t span_of(uint8_t start_bit, uint8_t size)
 {
-    if(!in_icon || !in_icon->trimmable)
+    lcd_span_t span = {.mask = 0, .shift = start_bit, .first = 1, .last = 0}; // No page
+
+    if(size == 0 || start_bit >= LCD_ROWS)
     {
-        return false;
+        return span;
+    }
+    span.mask  = ((((uint64_t)1) << size) - 1) << start_bit;
+    span.mask &= (((uint64_t)1) << LCD_ROWS) - 1;
+    span.first = start_bit / 8;
+    span.last  = (start_bit + size - 1) / 8;
+    if(span.last >= NUM_PIX_ROW_PER_COL_BYTES)
+    {
+        span.last = NUM_PIX_ROW_PER_COL_BYTES - 1;
+    }
+    return span;
+}
+
+// Stores a column of a page, only a change flags its block
+static void frame_put(lcd_t *self, uint8_t page, uint8_t col, uint8_t pixels)
+{
+    if(self->line_buf[page][col] != pixels)
+    {
+        self->line_buf[page][col] = pixels;
+        self->line_dirty[page] |= LCD_DIRTY_BIT(col);
+    }
+}
+
+// Dirty bits of the blocks a run of columns touches, the run is clipped to the page
+static uint16_t frame_dirty_run(uint8_t col, uint8_t count)
+{
+    uint8_t last = ((col + count) < NUM_PIX_COL_PER_ROW_BYTES) ? (col + count - 1) : (NUM_PIX_COL_PER_ROW_BYTES - 1);
+
+    return (uint16_t)((LCD_DIRTY_BIT(last) << 1) - LCD_DIRTY_BIT(col));
+}
+
+// Merges a column of a text line into the pages the line covers: the column is built as one word, a bit per row
+static void blit_column(lcd_t *self, const lcd_span_t *span, uint16_t value, uint8_t pos)
+{
+    // Right and center alignment of a line wider than the panel start past the last column
+    if(pos >= NUM_PIX_COL_PER_ROW_BYTES)
+    {
+        return;
+    }
+
+    uint64_t word = ((uint64_t)value << span->shift) & span->mask;
+
+    for(uint8_t page = span->first; page <= span->last; page++)
+    {
+        uint8_t mask = (uint8_t)(span->mask >> (page * 8));
+
+        frame_put(self, page, pos, (self->line_buf[page][pos] & ~mask) | (uint8_t)(word >> (page * 8)));
+    }
+}
+
+//The function returns the character glyph, characters without a glyph are drawn as a space
+static const font_glyph_t *get_font(uint8_t my_char)
+{
+    const font_glyph_t *font = font_glyph(my_char);
+
+    return font ? font : font_glyph(' ');
+}
+
+// The glyph pre-shifted to the rows of a line, shifted into its cache slot on a miss. 0 when the cache does not hold
+// it: a glyph wider than a slot, a line taller than a column value or covering more pages than a slot
+static const lcd_glyph_t *glyph_of(lcd_t *self, const font_glyph_t *font, const lcd_span_t *span, uint8_t rows)
+{
+    uint8_t index = (uint8_t)(font - font_glyphs);
+    uint8_t size  = font->right - font->left;
+
+    if(size == 0 || size > LCD_GLYPH_COLS || rows > GLYPH_ROWS_MAX || span->first > span->last ||
+       (span->last - span->first) >= LCD_GLYPH_PAGES)
+    {
+        return 0;
+    }
+
+    lcd_glyph_t *glyph = &self->glyph_cache[(uint16_t)(index * LCD_ROWS + span->shift) % LCD_GLYPH_CACHE_SLOTS];
+
+    if(glyph->size != 0 && glyph->glyph == index && glyph->shift == span->shift && glyph->rows == rows)
+    {
+        return glyph;
     }
-    uint8_t right = in_icon->size;
-    uint8_t left  = 0;
+    for(uint8_t col = 0; col < size; col++)
+    {
+        uint64_t word =
+            ((uint64_t)(uint16_t)(font_columns[font->offset + col] << INVERTED_LINE_GAP) << span->shift) & span->mask;
+
+        for(uint8_t page = 0; page < LCD_GLYPH_PAGES; page++)
+        {
+            glyph->cols[col][page] = (uint8_t)(word >> ((span->first + page) * 8));
+        }
+    }
+    glyph->glyph = index;
+    glyph->shift = span->shift;
+    glyph->rows  = rows;
+    glyph->size  = size;
+    return glyph;
+}
 
-    while(!in_icon->arr[left] && !in_icon->arr[right])
+// Copies a pre-shifted glyph into the pages of its line, a page at a time. An inverted line flips the rows of the line
+static void glyph_put(lcd_t *self, const lcd_glyph_t *glyph, const lcd_span_t *span, bool inverted, uint8_t pos)
+{
+    for(uint8_t page = 0; page <= span->last - span->first; page++)
     {
-        if(right <= left)
+        uint8_t *row   = self->line_buf[span->first + page];
+        uint8_t  mask  = (uint8_t)(span->mask >> ((span->first + page) * 8));
+        uint8_t  flip  = inverted ? mask : 0;
+        uint16_t dirty = 0;
+
+        for(uint8_t col = 0, at = pos; col < glyph->size; col++, at++)
         {
-            return false;
+            uint8_t pixels = (row[at] & ~mask) | (glyph->cols[col][page] ^ flip);
+
+            if(row[at] != pixels)
+            {
+                row[at] = pixels;
+                dirty |= LCD_DIRTY_BIT(at);
+            }
         }
-        left++;
-        right--;
+        self->line_dirty[span->first + page] |= dirty;
     }
-    *left_border  = left;
-    *right_border = right;
-    return true;
 }
 
 static uint16_t get_inversion(const uint8_t *state)
@@ -296,105 +668,115 @@ static alignment_t get_alignment(const uint8_t *state)
 }
 
 // the function fills specific range of the lcd pixel line buffer with characters font specific information
-static uint8_t stuff_char(const char_context_t * context, uint8_t max_pos)
+static uint8_t stuff_char(lcd_t *self, const char_context_t * context, uint8_t max_pos)
 {
-    uint16_t text_inversion = get_inversion(&context->state); // inverted line definition
-    uint8_t  i_font         = 0;                                                     // byte number index
-    uint8_t  left_border    = 0;                                                     // leftmost byte index
-    uint8_t  right_border   = font_array[context->my_char]->size;                             // rightmost byte index
-    uint8_t  blink_byte     = ASCII_CHAR_ENABLED;                                    // All pixels are on by default;
-    uint8_t  pos            = context->position;
-    // To get icons borders without spaces
-    if(context->my_char > LAST_ASCII_CHAR_DEF)
+    const font_glyph_t *font   = get_font(context->my_char);
+    uint16_t text_inversion    = get_inversion(&context->state); // inverted line definition
+    uint8_t  i_font            = 0;                              // drawn column index
+    uint8_t  size              = font->right - font->left;       // drawn columns, trimmed icons skip their blank ones
+    uint8_t  blink_byte        = ASCII_CHAR_ENABLED;             // All pixels are on by default;
+    uint8_t  pos               = context->position;
+    lcd_span_t span            = span_of(context->buffer_shift, context->line_size);
+
+    if((context->state & LINE_BLINKED) && (font->flags & FONT_GLYPH_BLINKING))
     {
-        get_icon_borders(font_array[context->my_char], &left_border, &right_border);
-        if((context->state & LINE_BLINKED) && font_array[context->my_char]->size && font_array[context->my_char]->is_blinking)
-        {
-            blink_byte = 0;
-        }
+        blink_byte = 0;
     }
 
     // To check a character pixels length is not exceeds a line pixels length
-    if(right_border + pos > max_pos)
+    if(font->right + pos > max_pos)
     {
-        return right_border - left_border;
+        return size;
     }
 
-    // foreach font value in the character
-    for(i_font = left_border; i_font < right_border; i_font++)
+    // A lit glyph is copied pre-shifted, only a blinked icon or a glyph the cache does not hold is shifted here
+    const lcd_glyph_t *glyph =
+        (blink_byte == ASCII_CHAR_ENABLED) ? glyph_of(self, font, &span, context->line_size) : 0;
+
+    if(glyph)
+    {
+        glyph_put(self, glyph, &span, text_inversion != 0, pos);
+        return size;
+    }
+
+    // foreach drawn column of the glyph
+    for(i_font = 0; i_font < size; i_font++)
     {
-        write_buff_8_bits(text_inversion ^
-                              (uint16_t)((uint8_t)(blink_byte & font_array[context->my_char]->arr[i_font]) << (uint8_t)INVERTED_LINE_GAP),
-                          context->buffer_shift, context->line_size, pos);
+        blit_column(self, &span, text_inversion ^
+                        (uint16_t)((uint8_t)(blink_byte & font_columns[font->offset + i_font]) << (uint8_t)INVERTED_LINE_GAP),
+                    pos);
         pos++;
     }
 
-    return right_border - left_border;
+    return size;
 }
 
 // callback for periodic timer
 static void task_callback(sl_sleeptimer_timer_handle_t *handle, void *data)
 {
-    *(uint8_t*)data = (uint8_t)0;
-    if(handle == &task_timer_handler)
+    lcd_t *self = (lcd_t *)data;
+
+    if(handle == &self->task_timer_handler)
     {
         // lookup for blinking task and blinking task current state
         for(uint8_t cnt = 0; cnt < LCD_LINE_NUM; cnt++)
         {
-            if(blink_tasks[cnt].my_char)
+            if(self->blink_tasks[cnt].my_char)
             {
-                if(blink_tasks[cnt].is_blinking)
+                if(self->blink_tasks[cnt].is_blinking)
                 {
                     // to hide char
-                    blink_tasks[cnt].state |= LINE_BLINKED;
-                    blink_tasks[cnt].is_blinking = false;
+                    self->blink_tasks[cnt].state |= LINE_BLINKED;
+                    self->blink_tasks[cnt].is_blinking = false;
                 }
                 else
                 {
                     // to display char
-                    blink_tasks[cnt].is_blinking = true;
-                    blink_tasks[cnt].state &= ~LINE_BLINKED;
+                    self->blink_tasks[cnt].is_blinking = true;
+                    self->blink_tasks[cnt].state &= ~LINE_BLINKED;
                 }
-                stuff_char(&blink_tasks[cnt], NUM_PIX_COL_PER_ROW_BYTES);
+                lcd_draw_begin(self);
+                stuff_char(self, &self->blink_tasks[cnt], NUM_PIX_COL_PER_ROW_BYTES);
+                lcd_commit(self);
             }
         }
     }
 }
 
-static void task_worker(bool enable)
+static void task_worker(lcd_t *self, bool enable)
 {
     if(enable)
     {
-        sl_sleeptimer_start_periodic_timer_ms(&task_timer_handler, 1000, &task_callback, 0, 0, 0);
+        sl_sleeptimer_start_periodic_timer_ms(&self->task_timer_handler, 1000, &task_callback, self, 0, 0);
     }
     else
     {
-        sl_sleeptimer_stop_timer(&task_timer_handler);
+        sl_sleeptimer_stop_timer(&self->task_timer_handler);
     }
 }
 
 // the function add blinking task from the task definiton buffer
-static bool blink_task_add(const char_context_t * context, uint8_t line)
+static bool blink_task_add(lcd_t *self, const char_context_t * context, uint8_t line)
 {
     bool ret = false;
 
     if(line < LCD_LINE_NUM)
     {
-        blink_tasks[line] = *context;
-        task_worker(true);
+        self->blink_tasks[line] = *context;
+        task_worker(self, true);
         ret = true;
     }
 
     return ret;
 }
 
-bool blink_task_remove(uint8_t line)
+bool blink_task_remove(lcd_t *self, uint8_t line)
 {
     bool ret = false;
 
     if(line < LCD_LINE_NUM)
     {
-        blink_tasks[line].my_char = 0;
+        self->blink_tasks[line].my_char = 0;
         ret = true;
     }
 
@@ -406,8 +788,6 @@ static uint8_t pixel_distant_measure(const uint8_t *lpc_line_index)
 {
     uint8_t cnt          = 0;
     uint8_t res          = 0;
-    uint8_t left_border  = 0;
-    uint8_t right_border = 0;
     uint8_t my_char      = 0;
     uint8_t un_cnt_space = 0;
 
@@ -415,33 +795,201 @@ static uint8_t pixel_distant_measure(const uint8_t *lpc_line_index)
     {
         my_char = lpc_line_index[cnt];
 
-        if(get_icon_borders(font_array[my_char], &left_border, &right_border))
+        // to cnt spaces
+        if(my_char == ' ')
         {
-            res += (right_border - left_border);
-            res++;
-            un_cnt_space = 0;
+            res += font_widths[my_char];
+            un_cnt_space += font_widths[my_char];
         }
         else
         {
-            // to cnt spaces
-            if(my_char == ' ')
-            {
-                res += font_array[my_char]->size;
-                un_cnt_space += font_array[my_char]->size;
-            }
-            else
-            {
-                res += font_array[my_char]->size;
-                un_cnt_space = 0;
-                res++;
-            }
+            // trimmed icons count their drawn columns only
+            res += font_widths[my_char];
+            un_cnt_space = 0;
+            res++;
         }
     }
 
     return res - un_cnt_space;
 }
 
-static uint16_t stuff_font(uint8_t        line,
+// Columns a character adds to the length of a print line, the gap after it included unless it is a space
+static uint8_t text_advance(uint8_t my_char)
+{
+    return font_widths[my_char] + (my_char != ' ');
+}
+
+// Length of a print line from its layout, as pixel_distant_measure() counts it: without the trailing spaces
+static uint8_t text_measure(const lcd_text_t *text)
+{
+    return (uint8_t)(text->width - (RIGHT_ALIGNMENT_BYTE - 1 - text->last) * font_widths[' ']);
+}
+
+// Text columns of a line: past the leftmost character, and short of the rightmost icon and the space before it
+static void text_borders(const uint8_t *lpc_line_index, uint8_t *left_border, uint8_t *right_border)
+{
+    const font_glyph_t *leftmost = get_font(lpc_line_index[LEFT_ALIGNMENT_BYTE]);
+
+    *left_border  = (lpc_line_index[LEFT_ALIGNMENT_BYTE] != ' ') ? (uint8_t)(leftmost->right - leftmost->left) : 0;
+    *right_border = NUM_PIX_COL_PER_ROW_BYTES;
+    if(lpc_line_index[RIGHT_ALIGNMENT_BYTE] > LAST_ASCII_CHAR_DEF)
+    {
+        *right_border -= get_font(lpc_line_index[RIGHT_ALIGNMENT_BYTE])->size + PIXELS_BEF_RIGHT_BUTTON;
+    }
+}
+
+// Column of the first character gap, for the alignment of the format byte and the length of the print line
+static uint8_t text_align(const uint8_t *lpc_line_index, uint8_t length, uint8_t left_border)
+{
+    switch(get_alignment(&lpc_line_index[FORMAT_BYTE_CHAR]))
+    {
+        case al_right:
+            return NUM_PIX_COL_PER_ROW_BYTES - length - BIT_SHIFT_COMPENSATION;
+        case al_center:
+            return (NUM_PIX_COL_PER_ROW_BYTES - length) / 2 - BIT_SHIFT_COMPENSATION;
+        default:
+            return left_border;
+    }
+}
+
+// Lays the characters of a line out into text as stuff_font() draws them, each from the gap before it, from character
+// first on the column text holds for it. Past character last, a character found on the column text already holds for
+// it ends the layout: the ones after it did not move, and the end of the text neither. False unless every character is
+// drawn whole and none blinks: a character that does not fit leaves stale columns behind and a blinking one owns a
+// blink task, both lines are only exact when rendered whole
+static bool text_layout(const uint8_t *lpc_line_index, lcd_text_t *text, uint8_t first, uint8_t last,
+                        uint8_t right_border)
+{
+    uint16_t position = text->pos[first];
+
+    for(uint8_t i_char = first; i_char < RIGHT_ALIGNMENT_BYTE; i_char++)
+    {
+        if(i_char > last && position == text->pos[i_char])
+        {
+            return true;
+        }
+
+        const font_glyph_t *font = get_font(lpc_line_index[i_char]);
+
+        text->pos[i_char] = (uint8_t)position;
+        position++;
+        if((font->right + position > right_border) || (font->flags & FONT_GLYPH_BLINKING))
+        {
+            return false;
+        }
+        position += font->right - font->left;
+        if(position >= right_border)
+        {
+            return false;
+        }
+    }
+    text->end = (uint8_t)position;
+    return true;
+}
+
+// Measures and lays out a rendered line into self->text. False when the line is not laid out whole by text_layout()
+static bool text_track(lcd_t *self, uint8_t line, const uint8_t *lpc_line_index)
+{
+    lcd_text_t *text         = &self->text[line];
+    uint8_t     left_border  = 0;
+    uint8_t     right_border = 0;
+
+    text->width = 0;
+    text->last  = PRINT_LINE_CHARS - 1;
+    for(uint8_t i_char = PRINT_LINE_CHARS; i_char < RIGHT_ALIGNMENT_BYTE; i_char++)
+    {
+        text->width += text_advance(lpc_line_index[i_char]);
+        if(lpc_line_index[i_char] != ' ')
+        {
+            text->last = i_char;
+        }
+    }
+    text_borders(lpc_line_index, &left_border, &right_border);
+    text->start                 = text_align(lpc_line_index, text_measure(text), left_border);
+    text->pos[PRINT_LINE_CHARS] = text->start;
+    return text_layout(lpc_line_index, text, PRINT_LINE_CHARS, RIGHT_ALIGNMENT_BYTE, right_border);
+}
+
+// Re-renders the characters of a line whose glyph or column differs from the text it replaces, the rest of the line is
+// left as drawn. The length of the line follows the changed characters, and only the characters from the first change
+// up to the last moved one are laid out again. False, with nothing drawn, when the line has to be rendered whole:
+// other borders or format, another text start, or a text not laid out whole by text_layout()
+static bool stuff_changed(lcd_t *self, uint8_t line, const uint8_t *previous, const uint8_t *lpc_line_index)
+{
+    lcd_text_t *text         = &self->text[line];
+    lcd_text_t  next         = *text;
+    uint8_t     first        = RIGHT_ALIGNMENT_BYTE;
+    uint8_t     last         = 0;
+    uint8_t     left_border  = 0;
+    uint8_t     right_border = 0;
+
+    if(previous[LEFT_ALIGNMENT_BYTE] != lpc_line_index[LEFT_ALIGNMENT_BYTE] ||
+       previous[FORMAT_BYTE_CHAR] != lpc_line_index[FORMAT_BYTE_CHAR] ||
+       previous[RIGHT_ALIGNMENT_BYTE] != lpc_line_index[RIGHT_ALIGNMENT_BYTE])
+    {
+        return false;
+    }
+    for(uint8_t i_char = PRINT_LINE_CHARS; i_char < RIGHT_ALIGNMENT_BYTE; i_char++)
+    {
+        if(previous[i_char] != lpc_line_index[i_char])
+        {
+            next.width += text_advance(lpc_line_index[i_char]) - text_advance(previous[i_char]);
+            first = (first == RIGHT_ALIGNMENT_BYTE) ? i_char : first;
+            last  = i_char;
+        }
+    }
+    if(first == RIGHT_ALIGNMENT_BYTE)
+    {
+        return true;
+    }
+    // The characters past the last change are those of the previous text: its last one other than a space stays
+    if(last >= next.last)
+    {
+        next.last = last;
+        while(next.last >= PRINT_LINE_CHARS && lpc_line_index[next.last] == ' ')
+        {
+            next.last--;
+        }
+    }
+    text_borders(lpc_line_index, &left_border, &right_border);
+    if(text_align(lpc_line_index, text_measure(&next), left_border) != text->start ||
+       !text_layout(lpc_line_index, &next, first, last, right_border))
+    {
+        return false;
+    }
+
+    char_context_t char_context = {.my_char      = 0,
+                                   .state        = lpc_line_index[FORMAT_BYTE_CHAR],
+                                   .line_size    = (uint8_t)self->layout[line].height,
+                                   .position     = 0,
+                                   .buffer_shift = self->line_top[line],
+                                   .is_blinking  = 0};
+    uint16_t       text_inversion = get_inversion(&char_context.state);
+    lcd_span_t     span           = span_of(char_context.buffer_shift, char_context.line_size);
+
+    for(uint8_t i_char = first; i_char < RIGHT_ALIGNMENT_BYTE; i_char++)
+    {
+        if(previous[i_char] == lpc_line_index[i_char] && text->pos[i_char] == next.pos[i_char])
+        {
+            continue;
+        }
+        // space between characters, then the character
+        blit_column(self, &span, text_inversion, next.pos[i_char]);
+        char_context.my_char  = lpc_line_index[i_char];
+        char_context.position = next.pos[i_char] + 1;
+        stuff_char(self, &char_context, right_border);
+    }
+    // A shorter text leaves the end of the previous one to clear, a longer one was drawn over it
+    for(uint8_t cnt = next.end; cnt < text->end; cnt++)
+    {
+        blit_column(self, &span, text_inversion, cnt);
+    }
+    *text = next;
+    return true;
+}
+
+static uint16_t stuff_font(lcd_t         *self,
+                           uint8_t        line,
                            const uint8_t *lpc_line_index,
                            size_t         size,
                            bool           internal,
@@ -459,9 +1007,9 @@ static uint16_t stuff_font(uint8_t        line,
     uint8_t cnt = 0; // array index
     // uint16_t i_font, font1, fontN; // font lookup
     bool task_existed = false; // definition for blinking character in a line - true if any blinking character was found
-    alignment_t alignment = DEFAULT_ALIGNMENT;
     uint8_t right_border = NUM_PIX_COL_PER_ROW_BYTES;
     uint8_t left_border = 0;
+    lcd_span_t span; // rows of the line in a column word
 
     // caller of this function sets the starting count, normally zero
     // pixel_column_count = start; // (non-zero from the recursive call)
@@ -471,26 +1019,26 @@ static uint16_t stuff_font(uint8_t        line,
     // No characters found
     if(size < 1)
         return 0;
+    PERF_PROBE_BEGIN(PERF_PROBE_STUFF_FONT)
 
     char1 = PRINT_LINE_CHARS;
 
     charN = RIGHT_ALIGNMENT_BYTE; // incomming string
 
     // Calculating buffer shift
-    char_context.line_size = (uint8_t)internal_lcd_layout[line].height; // current line height
+    char_context.line_size = (uint8_t)self->layout[line].height; // current line height
 
     // Calculating a height shift for the current line
-    for(cnt = 0; cnt < line; cnt++)
-    {
-        char_context.buffer_shift += internal_lcd_layout[cnt].upper_indent + internal_lcd_layout[cnt].height;
-    }
-    char_context.buffer_shift += internal_lcd_layout[line].upper_indent;
+    char_context.buffer_shift = self->line_top[line];
+    span = span_of(char_context.buffer_shift, char_context.line_size);
+    gray_clear(self, &span);
+    text_borders(lpc_line_index, &left_border, &right_border);
 
     // To process leftmost character
     char_context.my_char = lpc_line_index[LEFT_ALIGNMENT_BYTE];
     // To check if we don't have alignment character before
     if (char_context.my_char != ' ') {
-        left_border = stuff_char(&char_context, right_border);
+        stuff_char(self, &char_context, NUM_PIX_COL_PER_ROW_BYTES);
     }
 
     // To process rightmost character
@@ -498,66 +1046,44 @@ static uint16_t stuff_font(uint8_t        line,
     if(char_context.my_char > LAST_ASCII_CHAR_DEF)
     {
         char_context_t rightmost_icon = char_context;
-        right_border                  = NUM_PIX_COL_PER_ROW_BYTES - font_array[rightmost_icon.my_char]->size;
-        rightmost_icon.position       = right_border;
+        rightmost_icon.position       = right_border + PIXELS_BEF_RIGHT_BUTTON;
         // To clear a space before rightmost button
-        for(cnt = right_border - PIXELS_BEF_RIGHT_BUTTON; cnt < right_border; cnt++)
+        for(cnt = right_border; cnt < rightmost_icon.position; cnt++)
         {
-            write_buff_8_bits(text_inversion, rightmost_icon.buffer_shift, rightmost_icon.line_size, cnt);
+            blit_column(self, &span, text_inversion, cnt);
         }
-        stuff_char(&rightmost_icon, NUM_PIX_COL_PER_ROW_BYTES);
-        right_border -= PIXELS_BEF_RIGHT_BUTTON;
+        stuff_char(self, &rightmost_icon, NUM_PIX_COL_PER_ROW_BYTES);
     }
 
     char_context.state = lpc_line_index[FORMAT_BYTE_CHAR]; // retrieving format byte value
 
-    alignment = get_alignment(&char_context.state); // gets alignment value
-
     text_inversion = get_inversion(&char_context.state); // gets contrast value of text
 
-    // To process different alignment
-    switch(alignment)
+    // Right and center alignment clear the columns ahead of the text
+    char_context.position = text_align(lpc_line_index, pixel_distant_measure(lpc_line_index), left_border);
+    for(cnt = left_border; cnt < char_context.position; cnt++)
     {
-        case al_left:
-            char_context.position = left_border;
-            break;
-        case al_right:
-            char_context.position = NUM_PIX_COL_PER_ROW_BYTES - pixel_distant_measure(lpc_line_index) - BIT_SHIFT_COMPENSATION;
-            for(cnt = left_border; cnt < char_context.position; cnt++)
-            {
-                write_buff_8_bits(text_inversion, char_context.buffer_shift, char_context.line_size, cnt);
-            }
-            break;
-        case al_center:
-            char_context.position = (NUM_PIX_COL_PER_ROW_BYTES - pixel_distant_measure(lpc_line_index)) / 2 - BIT_SHIFT_COMPENSATION;
-            for(cnt = left_border; cnt < char_context.position; cnt++)
-            {
-                write_buff_8_bits(text_inversion, char_context.buffer_shift, char_context.line_size, cnt);
-            }
-            break;
-        default:
-            char_context.position = left_border;
-            break;
+        blit_column(self, &span, text_inversion, cnt);
     }
 
     // foreach character in the line...
     for(i_char = char1; i_char < charN; i_char++)
     {
         // space between characters
-        write_buff_8_bits(text_inversion, char_context.buffer_shift, char_context.line_size, char_context.position);
+        blit_column(self, &span, text_inversion, char_context.position);
         char_context.position++;
 
         char_context.my_char = lpc_line_index[i_char];
 
         // To check if blinking character exists
-        if(!internal && font_array[char_context.my_char]->size && font_array[char_context.my_char]->is_blinking)
+        if(!internal && (get_font(char_context.my_char)->flags & FONT_GLYPH_BLINKING))
         {
             task_existed           = true;
-            blink_task_add(&char_context, line);
+            blink_task_add(self, &char_context, line);
         }
 
         // incrementing pixel column count by the character size
-        char_context.position += stuff_char(&char_context, right_border);
+        char_context.position += stuff_char(self, &char_context, right_border);
 
         // checking for the current line overflow
         if (char_context.position >= right_border) {
@@ -571,125 +1097,226 @@ static uint16_t stuff_font(uint8_t        line,
 
     for(cnt = char_context.position; cnt < right_border; cnt++)
     {
-        write_buff_8_bits(text_inversion, char_context.buffer_shift, char_context.line_size, cnt);
+        blit_column(self, &span, text_inversion, cnt);
     }
 
     if(!internal && line == 0 && !task_existed)
     {
         if(task_existed)
         {
-            task_worker(true);
+            task_worker(self, true);
         }
         else
         {
-            blink_task_remove(line);
+            blink_task_remove(self, line);
         }
     }
 
+    PERF_PROBE_END(PERF_PROBE_STUFF_FONT)
     // return count of font data added, not extra space nor the starting offset
     return 0;
 }
 
-void lcd_init(base_driver *sercomm_instance, const lcd_line_t *lcd_layout)
-{
-    if(lcd_sercomm_instance == 0)
-    {
-        lcd_sercomm_instance = sercomm_instance;
-        sl_sleeptimer_delay_millisecond(LCD_INIT_TIMEOUT);
-        lcd_gpio_reset_on();
-        lcd_gpio_reset_off();
-        sl_sleeptimer_delay_millisecond(LCD_INIT_TIMEOUT);
-        wr_8bit_command(LCD_RESET);  // System Reset
-        wr_8bit_command(LCD_SET_SL); // cmd #10: set start / scroll line = 0
-        //------------------------------------------------------------------------------
-        // bit3 CUM=1 CA increment on write only
-        // bit2 PID=1 and don't understand the description ... H:-1 ???????
-        // bit1 auto-increment order=0 means Column (CA) first
-        // bit0 WA=1 means automatic column/page wrap around (ON)
-        //------------------------------------------------------------------------------
-        wr_8bit_command(LCD_SET_RAMA | LCD_PID | LCD_WA); // cmd #13: set ram address control (see above description)
-        wr_8bit_command(LCD_SET_FR); // cmd #14: set frame rate:a0 80pbs;a1 100pbs (Frame rates don't match latest spec)
-        wr_8bit_command(LCD_SET_PON);           // cmd #15: set all pixells on:OFF
-        wr_8bit_command(LCD_SET_INV);           // cmd #16: set inverse display:OFF
-        wr_8bit_command(LCD_SET_EN);            // cmd #17: turn display on
-        wr_8bit_command(LCD_SET_MAP | LCD_MX);  // cmd #18: set lcd mapping control:mx=1;my=0
-        wr_8bit_command(LCD_SET_BR | LCD_BR_8); // cmd #22: 0xea:bias=1/8;0xeb:bias=1/9;
-        wr_8bit_command(LCD_SET_TC);            // cmd #6: set temp compensation tc1:tc0=0,0:-0.05%/c
-        sl_sleeptimer_delay_millisecond(LCD_INIT_TIMEOUT);
-        wr_8bit_command(LCD_SET_EN); // display enable
+// Configuration sent once the reset pulse is over
+static const uint16_t configure_commands[] = {
+    LCD_RESET,  // System Reset
+    LCD_SET_SL, // cmd #10: set start / scroll line = 0
+    //------------------------------------------------------------------------------
+    // bit3 CUM=1 CA increment on write only
+    // bit2 PID=1 and don't understand the description ... H:-1 ???????
+    // bit1 auto-increment order=0 means Column (CA) first
+    // bit0 WA=1 means automatic column/page wrap around (ON)
+    //------------------------------------------------------------------------------
+    LCD_SET_RAMA | LCD_PID | LCD_WA, // cmd #13: set ram address control (see above description)
+    LCD_SET_FR,                      // cmd #14: set frame rate:a0 80pbs;a1 100pbs (Frame rates don't match latest spec)
+    LCD_SET_PON,                     // cmd #15: set all pixells on:OFF
+    LCD_SET_INV,                     // cmd #16: set inverse display:OFF
+    LCD_SET_EN,                      // cmd #17: turn display on
+    LCD_SET_MAP | LCD_MX,            // cmd #18: set lcd mapping control:mx=1;my=0
+    LCD_SET_BR | LCD_BR_8,           // cmd #22: 0xea:bias=1/8;0xeb:bias=1/9;
+    LCD_SET_TC,                      // cmd #6: set temp compensation tc1:tc0=0,0:-0.05%/c
+};
+
+// Sent once the configuration settled
+static const uint16_t enable_commands[] = {
+    LCD_SET_EN, // display enable
+};
+
+// Bring-up step, from the init timer. The delays between the steps leave the CPU to the rest of the boot
+static void init_callback(sl_sleeptimer_timer_handle_t *handle, void *data)
+{
+    lcd_t *self = (lcd_t *)data;
+
+    switch(self->init_state)
+    {
+        case LCD_INIT_POWER_UP:
+            lcd_gpio_reset_on();
+            lcd_gpio_reset_off();
+            self->init_state = LCD_INIT_RESET;
+            sl_sleeptimer_start_timer_ms(handle, LCD_INIT_TIMEOUT, &init_callback, self, 0, 0);
+            break;
+        case LCD_INIT_RESET:
+            EFM_ASSERT(
+                burst_commands(self, configure_commands, sizeof(configure_commands) / sizeof(configure_commands[0])));
+            self->init_state = LCD_INIT_CONFIGURE;
+            sl_sleeptimer_start_timer_ms(handle, LCD_INIT_TIMEOUT, &init_callback, self, 0, 0);
+            break;
+        case LCD_INIT_CONFIGURE:
+            EFM_ASSERT(burst_commands(self, enable_commands, sizeof(enable_commands) / sizeof(enable_commands[0])));
+            // The reset left the effects off, the first flush only sends the ones set meanwhile
+            self->effects_valid = true;
+            self->init_state    = LCD_INIT_READY;
+            break;
+        default:
+            break;
+    }
+}
+
+void lcd_init(lcd_t *self, base_driver *sercomm_instance, const lcd_line_t *lcd_layout)
+{
+    if(self->sercomm == 0)
+    {
+        self->sercomm = sercomm_instance;
+        memcpy(self->layout, default_lcd_layout, sizeof(self->layout));
+        // All the lines are sent on the first update.
+        memset(self->front_dirty, 0xFF, sizeof(self->front_dirty));
+        self->init_state = LCD_INIT_POWER_UP;
+        sl_sleeptimer_start_timer_ms(&self->init_timer, LCD_INIT_TIMEOUT, &init_callback, self, 0, 0);
     };
 
     if(lcd_layout != 0)
     {
         for(size_t cnt = 0; cnt < LCD_LINE_NUM; cnt++)
         {
-            internal_lcd_layout[cnt] = lcd_layout[cnt];
+            self->layout[cnt] = lcd_layout[cnt];
         }
+        // The glyphs were shifted to the rows of the previous layout, and the lines drawn on them
+        memset(self->glyph_cache, 0, sizeof(self->glyph_cache));
+        self->line_rendered = 0;
+    }
+
+    // The rows of the lines only move with the layout
+    size_t shift = 0;
+    for(size_t cnt = 0; cnt < LCD_LINE_NUM; cnt++)
+    {
+        shift += self->layout[cnt].upper_indent;
+        self->line_top[cnt] = (uint8_t)shift;
+        shift += self->layout[cnt].height;
     }
 }
 
+bool lcd_is_ready(lcd_t *self)
+{
+    return self->init_state == LCD_INIT_READY;
+}
+
 /*Local Prototypes end*/
 
-bool lcd_update(bool lcd_status)
+bool lcd_update(lcd_t *self, bool lcd_status)
 {
-    static uint16_t i_col_s = 0;
-    static uint8_t  i_lin_s = 0;
-    bool            return_code;
+    bool return_code;
+    PERF_PROBE_BEGIN(PERF_PROBE_LCD_UPDATE)
 
-    if(i_col_s == 0)
+    // The previous page is still on the wire, its frames can not be reused yet
+    if(self->burst.busy || self->burst.flushing || !lcd_is_ready(self) || lcd_status != true)
     {
-        if(++i_lin_s >= NUM_PIX_ROW_PER_COL_BYTES)
-        {
-            i_lin_s = 0;
-        }
-
-        if(line_update_state[i_lin_s] == line_buf[i_lin_s].state)
-        {
-            return false;
-        }
-        else
-        {
-            line_update_state[i_lin_s] = line_buf[i_lin_s].state;
-            // wr_8bit_command(LCD_SET_EN); //if it requires to off the display while it's updating
-            wr_8bit_command(LCD_SET_PAGE | i_lin_s); // top page/row
-        }
-
-        // wr_8bit_command(LCD_SET_RAMA | LCD_AINC);
+        PERF_PROBE_END(PERF_PROBE_LCD_UPDATE)
+        return false;
     }
 
-    if(lcd_status == true)
+    return_code = burst_effects(self);
+    if(!return_code)
     {
-        if(i_col_s < NUM_PIX_COL_PER_ROW_BYTES) // protect because this function is entered multiple times
+        if(++self->i_lin_s >= NUM_PIX_ROW_PER_COL_BYTES)
         {
-            wr_8bit_command(LCD_SET_COL_L + (i_col_s & 0xF));
-
-            wr_8bit_command(LCD_SET_COL_H + (i_col_s >> 4));
-
-            wr_9bit_data(&line_buf[i_lin_s].line[i_col_s]);
+            self->i_lin_s = 0;
         }
+        return_code = burst_page(self, self->i_lin_s);
     }
 
-    if(i_col_s == NUM_PIX_COL_PER_ROW_BYTES)
+    PERF_PROBE_END(PERF_PROBE_LCD_UPDATE)
+    return return_code;
+}
+
+bool lcd_flush_async(lcd_t *self, lcd_flush_callback_t callback, void *arg)
+{
+    bool return_code;
+    bool running;
+    CORE_DECLARE_IRQ_STATE;
+
+    // The grayscale timer, when built in, flushes too: whoever sets flushing owns the transfer chain
+    CORE_ENTER_ATOMIC();
+    running = self->burst.busy || self->burst.flushing || !lcd_is_ready(self);
+    if(!running)
     {
-        wr_8bit_command(LCD_SET_EN | LCD_ENABLE); // turn display on
-        i_col_s     = 0;
-        return_code = true;
+        self->burst.flushing = true;
     }
-    else if(i_col_s > NUM_PIX_COL_PER_ROW_BYTES) // just a boundry protection
+    CORE_EXIT_ATOMIC();
+    if(running)
     {
-        i_col_s     = 0;
-        return_code = false;
+        return false;
     }
-    else
+
+    // Flushing before the first page goes out: its completion chains the next one
+    self->burst.callback     = callback;
+    self->burst.callback_arg = arg;
+    return_code              = burst_next(self);
+    if(!return_code)
     {
-        i_col_s++;
-        return_code = false;
+        self->burst.flushing = false;
     }
-
     return return_code;
 }
 
-bool lcd_put_line(const uint8_t *str, const size_t size, const uint8_t line, language_e language)
+void lcd_draw_begin(lcd_t *self)
+{
+    // Interrupts open and close their frames before returning: the increment needs no atomic section
+    self->draw_depth++;
+}
+
+bool lcd_commit(lcd_t *self)
+{
+    CORE_DECLARE_IRQ_STATE;
+
+    if(--self->draw_depth != 0)
+    {
+        return false;
+    }
+
+    // Only the changed blocks are copied and flagged, a redraw of the same pixels sends nothing
+    CORE_ENTER_ATOMIC();
+    for(uint8_t page = 0; page < NUM_PIX_ROW_PER_COL_BYTES; page++)
+    {
+        const lcd_area_t *area  = &self->invert_area;
+        uint16_t          dirty = self->line_dirty[page];
+
+        for(uint8_t col = 0; dirty != 0; col += LCD_DIRTY_BLOCK_COLS, dirty >>= 1)
+        {
+            if(dirty & 1)
+            {
+                memcpy(&self->front_buf[page][col], &self->line_buf[page][col], LCD_DIRTY_BLOCK_COLS);
+                gray_commit_block(self, page, col);
+            }
+        }
+        // A local inversion lives in the front buffer only, the renderers keep drawing plain pixels
+        if(self->line_dirty[page] && page >= area->page && page < area->page + area->pages)
+        {
+            for(uint8_t col = area->col; col < area->col + area->cols; col++)
+            {
+                if(self->line_dirty[page] & LCD_DIRTY_BIT(col))
+                {
+                    self->front_buf[page][col] ^= 0xFF;
+                }
+            }
+        }
+        self->front_dirty[page] |= self->line_dirty[page];
+        self->line_dirty[page] = 0;
+    }
+    CORE_EXIT_ATOMIC();
+    return true;
+}
+
+bool lcd_put_line(lcd_t *self, const uint8_t *str, const size_t size, const uint8_t line, language_e language)
 {
     (void)language;
     // Setup indexing into the text "line_index_table"
@@ -703,10 +1330,27 @@ bool lcd_put_line(const uint8_t *str, const size_t size, const uint8_t line, lan
         return false; // line doens't match to lines supported number
     }
 
-    if(strncmp((const char *)cached_str[line], (const char *)str, size))
+    if(strncmp((const char *)self->cached_str[line], (const char *)str, size))
     {
-        memcpy(cached_str[line], str, size);
-        stuff_font(line, cached_str[line], size, 0, false);
+        uint8_t previous[LCD_CHAR_NUM];
+
+        memcpy(previous, self->cached_str[line], sizeof(previous));
+        lcd_draw_begin(self);
+        memcpy(self->cached_str[line], str, size);
+        // A line still showing its last render only needs the characters that changed
+        if(!(self->line_rendered & (1U << line)) || !stuff_changed(self, line, previous, self->cached_str[line]))
+        {
+            stuff_font(self, line, self->cached_str[line], size, 0, false);
+            if(text_track(self, line, self->cached_str[line]))
+            {
+                self->line_rendered |= (uint8_t)(1U << line);
+            }
+            else
+            {
+                self->line_rendered &= (uint8_t)~(1U << line);
+            }
+        }
+        lcd_commit(self);
     }
 
     return true;
@@ -731,7 +1375,7 @@ bool lcd_put_line(const uint8_t *str, const size_t size, const uint8_t line, lan
     return true;
 } */
 
-bool lcd_put_raw_data(uint8_t data, uint8_t line, uint8_t offset)
+bool lcd_put_raw_data(lcd_t *self, uint8_t data, uint8_t line, uint8_t offset)
 {
     if(line > LCD_LINE_NUM)
     {
@@ -742,19 +1386,176 @@ bool lcd_put_raw_data(uint8_t data, uint8_t line, uint8_t offset)
         return false;
     }
 
-    line_buf[line].line[offset] = data;
+    lcd_draw_begin(self);
+    frame_put(self, line, offset, data);
+    self->line_rendered = 0; // The text lines may be drawn over
+    lcd_commit(self);
+    return true;
+}
+
+#if LCD_GRAY_ENABLE == true
+bool lcd_put_gray_data(lcd_t *self, uint8_t high, uint8_t low, uint8_t page, uint8_t offset)
+{
+    if(page >= NUM_PIX_ROW_PER_COL_BYTES)
+    {
+        return false;
+    }
+    if(offset >= NUM_PIX_COL_PER_ROW_BYTES)
+    {
+        return false;
+    }
+
+    // Black is set in line_buf alone, dark in both planes and light in the gray plane alone
+    lcd_draw_begin(self);
+    frame_put(self, page, offset, high);
+    self->line_rendered = 0; // The text lines may be drawn over
+    if(self->gray_buf[page][offset] != (uint8_t)(high ^ low))
+    {
+        self->gray_buf[page][offset] = high ^ low;
+        self->line_dirty[page] |= LCD_DIRTY_BIT(offset);
+    }
+    if(high ^ low)
+    {
+        self->gray_pages |= (uint8_t)(1U << page);
+    }
+    lcd_commit(self);
+    return true;
+}
+
+// Flags the blocks holding gray pixels, the flush sends them with the current sub-frame
+static void gray_redirty(lcd_t *self)
+{
+    for(uint8_t page = 0; page < NUM_PIX_ROW_PER_COL_BYTES; page++)
+    {
+        self->front_dirty[page] |= self->gray_blocks[page];
+    }
+}
+
+// Sub-frame period elapsed, interrupt context
+static void gray_callback(sl_sleeptimer_timer_handle_t *handle, void *data)
+{
+    lcd_t *self = (lcd_t *)data;
+    CORE_DECLARE_IRQ_STATE;
+    (void)handle;
+
+    CORE_ENTER_ATOMIC();
+    for(uint8_t page = 0; page < NUM_PIX_ROW_PER_COL_BYTES; page++)
+    {
+        if(self->front_dirty[page] & self->gray_blocks[page])
+        {
+            // The previous sub-frame is not on the panel yet, the cadence is faster than the flush
+            self->gray_late++;
+            break;
+        }
+    }
+    self->gray_subframes++;
+    self->gray_subframe = (self->gray_subframe + 1) % LCD_GRAY_SUBFRAMES;
+    gray_redirty(self);
+    CORE_EXIT_ATOMIC();
+
+    // A running flush picks the blocks up before it ends
+    lcd_flush_async(self, 0, 0);
+}
+
+void lcd_gray_start(lcd_t *self, uint32_t subframe_ms)
+{
+    self->gray_subframes = 0;
+    self->gray_late      = 0;
+    sl_sleeptimer_start_periodic_timer_ms(&self->gray_timer, subframe_ms, &gray_callback, self, 0, 0);
+}
+
+void lcd_gray_stop(lcd_t *self)
+{
+    CORE_DECLARE_IRQ_STATE;
+
+    sl_sleeptimer_stop_timer(&self->gray_timer);
+    CORE_ENTER_ATOMIC();
+    self->gray_subframe = 0;
+    gray_redirty(self);
+    CORE_EXIT_ATOMIC();
+}
+#endif /* LCD_GRAY_ENABLE */
+
+void lcd_clear(lcd_t *self)
+{
+    // The lines are gone from the screen: the next lcd_put_line() draws them again, even with the same text
+    memset(self->cached_str, 0, sizeof(self->cached_str));
+    self->line_rendered = 0;
+    lcd_draw_begin(self);
+    // A block of 8 columns is checked as one word, clearing a blank screen flags nothing
+    for(uint8_t page = 0; page < NUM_PIX_ROW_PER_COL_BYTES; page++)
+    {
+        for(uint8_t col = 0; col < NUM_PIX_COL_PER_ROW_BYTES; col += LCD_DIRTY_BLOCK_COLS)
+        {
+            uint64_t block;
+
+            memcpy(&block, &self->line_buf[page][col], sizeof(block));
+            if(block != 0)
+            {
+                memset(&self->line_buf[page][col], 0, LCD_DIRTY_BLOCK_COLS);
+                self->line_dirty[page] |= LCD_DIRTY_BIT(col);
+            }
+        }
+    }
+    gray_plane_clear(self);
+    lcd_commit(self);
+}
+
+bool lcd_save_frame(lcd_t *self, lcd_frame_t *frame)
+{
+    for(uint8_t line = 0; line < LCD_LINE_NUM; line++)
+    {
+        if(self->blink_tasks[line].my_char)
+        {
+            return false;
+        }
+    }
+    memcpy(frame->pixels, self->line_buf, sizeof(frame->pixels));
+    memcpy(frame->cached_str, self->cached_str, sizeof(frame->cached_str));
     return true;
 }
 
-void lcd_clear()
+void lcd_load_frame(lcd_t *self, const lcd_frame_t *frame)
 {
-    memset(line_buf, 0, sizeof(line_buf));
+    // The glyphs blinking on the current picture would be drawn over the loaded one
+    for(uint8_t line = 0; line < LCD_LINE_NUM; line++)
+    {
+        blink_task_remove(self, line);
+    }
+    memcpy(self->cached_str, frame->cached_str, sizeof(self->cached_str));
+    // The frame may hold more than the render of its text, the next text of a line is rendered whole
+    self->line_rendered = 0;
+    lcd_draw_begin(self);
+    // Blocks of 8 columns are compared as one word, as lcd_clear() does
+    for(uint8_t page = 0; page < NUM_PIX_ROW_PER_COL_BYTES; page++)
+    {
+        for(uint8_t col = 0; col < NUM_PIX_COL_PER_ROW_BYTES; col += LCD_DIRTY_BLOCK_COLS)
+        {
+            uint64_t block;
+            uint64_t loaded;
+
+            memcpy(&block, &self->line_buf[page][col], sizeof(block));
+            memcpy(&loaded, &frame->pixels[page][col], sizeof(loaded));
+            if(block != loaded)
+            {
+                memcpy(&self->line_buf[page][col], &loaded, sizeof(loaded));
+                self->line_dirty[page] |= LCD_DIRTY_BIT(col);
+            }
+        }
+    }
+    gray_plane_clear(self);
+    lcd_commit(self);
 }
 
-void lcd_adjust_contrast(uint8_t value)
+void lcd_adjust_contrast(lcd_t *self, uint8_t value)
 {
-    wr_8bit_command(LCD_SET_BIAS); // set Vbias
-    wr_8bit_command(value);
+    CORE_DECLARE_IRQ_STATE;
+
+    // Sent by the flush with the other effects, a command of its own could land in the middle of a page transfer
+    CORE_ENTER_ATOMIC();
+    self->effects.contrast_set = true;
+    self->effects.contrast     = value;
+    CORE_EXIT_ATOMIC();
 }
 
 void lcd_backlight_on()
@@ -767,17 +1568,117 @@ void lcd_backlight_off()
     lcd_gpio_backlight_off();
 }
 
-void lcd_all_pixels_on()
+void lcd_all_pixels_on(lcd_t *self)
+{
+    self->effects.all_on = true;
+}
+
+void lcd_all_pixels_off(lcd_t *self)
+{
+    self->effects.all_on = false;
+}
+
+// Flags the blocks of an area, the next commit copies them again
+static void area_redirty(lcd_t *self, const lcd_area_t *area)
+{
+    if(area->cols == 0)
+    {
+        return;
+    }
+    for(uint8_t page = area->page; page < area->page + area->pages; page++)
+    {
+        self->line_dirty[page] |= frame_dirty_run(area->col, area->cols);
+    }
+}
+
+// Switches the inverted area: the whole screen is the controller's job, anything smaller is composed by the commit
+static void invert_apply(lcd_t *self, const lcd_area_t *area)
+{
+    static const lcd_area_t none   = {0, 0, 0, 0};
+    const lcd_area_t       *wanted = (area != 0 && area->pages != 0 && area->cols != 0) ? area : &none;
+    bool                    whole  = (wanted->page == 0 && wanted->pages >= NUM_PIX_ROW_PER_COL_BYTES &&
+                                      wanted->col == 0 && wanted->cols >= NUM_PIX_COL_PER_ROW_BYTES);
+    CORE_DECLARE_IRQ_STATE;
+
+    lcd_draw_begin(self);
+    // The blocks inverted so far and the new ones are copied again, with the area the commit will see
+    CORE_ENTER_ATOMIC();
+    area_redirty(self, &self->invert_area);
+    self->invert_area = whole ? none : *wanted;
+    area_redirty(self, &self->invert_area);
+    self->effects.inverse = whole;
+    CORE_EXIT_ATOMIC();
+    lcd_commit(self);
+}
+
+// The part of an area on the screen, empty for NULL
+static lcd_area_t area_clip(const lcd_area_t *area)
+{
+    lcd_area_t clipped = {0, 0, 0, 0};
+
+    if(area != 0 && area->page < NUM_PIX_ROW_PER_COL_BYTES && area->col < NUM_PIX_COL_PER_ROW_BYTES)
+    {
+        clipped       = *area;
+        clipped.pages = (area->pages < NUM_PIX_ROW_PER_COL_BYTES - area->page) ? area->pages : NUM_PIX_ROW_PER_COL_BYTES - area->page;
+        clipped.cols  = (area->cols < NUM_PIX_COL_PER_ROW_BYTES - area->col) ? area->cols : NUM_PIX_COL_PER_ROW_BYTES - area->col;
+    }
+    return clipped;
+}
+
+void lcd_invert(lcd_t *self, const lcd_area_t *area)
+{
+    lcd_area_t clipped = area_clip(area);
+
+    sl_sleeptimer_stop_timer(&self->flash_timer);
+    invert_apply(self, &clipped);
+}
+
+// Flash period elapsed, interrupt context
+static void flash_callback(sl_sleeptimer_timer_handle_t *handle, void *data)
 {
-    wr_8bit_command(LCD_SET_PON | LCD_ENABLE);
+    lcd_t *self = (lcd_t *)data;
+    (void)handle;
+
+    self->flash_phase = !self->flash_phase;
+    invert_apply(self, self->flash_phase ? &self->flash_area : 0);
+}
+
+void lcd_flash(lcd_t *self, const lcd_area_t *area, uint32_t period_ms)
+{
+    // Starts inverted
+    lcd_invert(self, area);
+    self->flash_area = area_clip(area);
+    if(self->flash_area.pages == 0 || self->flash_area.cols == 0 || period_ms == 0)
+    {
+        return;
+    }
+    self->flash_phase = true;
+    sl_sleeptimer_start_periodic_timer_ms(&self->flash_timer, period_ms, &flash_callback, self, 0, 0);
 }
 
-void lcd_all_pixels_off()
+void lcd_scroll(lcd_t *self, uint8_t row)
 {
-    wr_8bit_command(LCD_SET_PON);
+    self->effects.scroll_line = row % LCD_RAM_ROWS;
+}
+
+bool lcd_window(lcd_t *self, uint8_t first_row, uint8_t last_row)
+{
+    CORE_DECLARE_IRQ_STATE;
+
+    if(first_row > last_row || last_row >= LCD_ROWS)
+    {
+        return false;
+    }
+    // The flush reads the three fields together
+    CORE_ENTER_ATOMIC();
+    self->effects.window       = (first_row != 0 || last_row != LCD_ROWS - 1);
+    self->effects.window_first = first_row;
+    self->effects.window_last  = last_row;
+    CORE_EXIT_ATOMIC();
+    return true;
 }
 
-bool lcd_put_qr_code(uint8_t qr_version_number, uint16_t num, uint8_t offset, uint8_t index, uint8_t contrast)
+bool lcd_put_qr_code(lcd_t *self, uint8_t qr_version_number, uint16_t num, uint8_t offset, uint8_t index, uint8_t contrast)
 {
     if(index > BIG_FONT_NUM_COL)
     {
@@ -817,6 +1718,8 @@ bool lcd_put_qr_code(uint8_t qr_version_number, uint16_t num, uint8_t offset, ui
             break;
 
     }
+    lcd_draw_begin(self);
+    self->line_rendered = 0; // The text lines are drawn over
     for (uint8_t line = 0; line < QR_CODE_NUM_ROW; line++)
     {
         for (uint8_t ix = 0; ix < QR_CODE_NUM_COL; ix++)
@@ -826,11 +1729,14 @@ bool lcd_put_qr_code(uint8_t qr_version_number, uint16_t num, uint8_t offset, ui
             // line_buf[line][index + offset] = \
             //         qr_code_myq[num].value[line][index] ^ contrast;  ///// qr_code_myq [][] ES EL PIXEL MAP
 
-            line_buf[line].line[index + offset] = \
+            self->line_buf[line][index + offset] = \
                     qr_to_print[num].value[line][index] ^ contrast;  ///// qr_code_myq [][] ES EL PIXEL MAP
 
         }
+        // The whole run is flagged, the flush skips the columns the panel already shows
+        self->line_dirty[line] |= frame_dirty_run(offset, QR_CODE_NUM_COL);
     }
+    lcd_commit(self);
 
     return true;
 
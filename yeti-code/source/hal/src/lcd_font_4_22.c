@@ -124,148 +124,6 @@ const lcd_character_t LCD_EMINV = {0x04, 0x00, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0
     0xC0, 0x80, 0x0,  0x0,  0x0,  0x0
 }; */
 
-const font_char Space = {2, {MSB2LSB(0x00), MSB2LSB(0x00)}, false, false};
-const font_char Dash  = {4, {MSB2LSB(0x10), MSB2LSB(0x10), MSB2LSB(0x10), MSB2LSB(0x10)}, false, false};
-const font_char Point = {1, {MSB2LSB(0x01)}, false, false};
-const font_char Slash = {4, {MSB2LSB(0x03), MSB2LSB(0x0C), MSB2LSB(0x30), MSB2LSB(0xC0)}, false, false};
-
-// Numeric
-const font_char Zero  = {5, {MSB2LSB(0x7E), MSB2LSB(0x81), MSB2LSB(0x81), MSB2LSB(0x81), MSB2LSB(0x7E)}, false, false};
-const font_char One   = {3, {MSB2LSB(0x20), MSB2LSB(0x40), MSB2LSB(0xFF)}, false, false};
-const font_char Two   = {5, {MSB2LSB(0x43), MSB2LSB(0x85), MSB2LSB(0x89), MSB2LSB(0x91), MSB2LSB(0x61)}, false, false};
-const font_char Three = {4, {MSB2LSB(0x42), MSB2LSB(0x81), MSB2LSB(0x91), MSB2LSB(0x6E)}, false, false};
-const font_char Four  = {6, {MSB2LSB(0x0C), MSB2LSB(0x14), MSB2LSB(0x24), MSB2LSB(0x44), MSB2LSB(0xFF), MSB2LSB(0x04)}, false, false};
-const font_char Five  = {5, {MSB2LSB(0x02), MSB2LSB(0xF1), MSB2LSB(0x91), MSB2LSB(0x91), MSB2LSB(0x8E)}, false, false};
-const font_char Six   = {5, {MSB2LSB(0x7E), MSB2LSB(0x91), MSB2LSB(0x91), MSB2LSB(0x91), MSB2LSB(0x8E)}, false, false};
-const font_char Seven = {5, {MSB2LSB(0x80), MSB2LSB(0x87), MSB2LSB(0x98), MSB2LSB(0xA0), MSB2LSB(0xC0)}, false, false};
-const font_char Eight = {5, {MSB2LSB(0x6E), MSB2LSB(0x91), MSB2LSB(0x91), MSB2LSB(0x91), MSB2LSB(0x6E)}, false, false};
-const font_char Nine  = {5, {MSB2LSB(0x72), MSB2LSB(0x89), MSB2LSB(0x89), MSB2LSB(0x89), MSB2LSB(0x7E)}, false, false};
-
-// Letters
-const font_char A = {5, {MSB2LSB(0x03), MSB2LSB(0x7c), MSB2LSB(0x84), MSB2LSB(0x7c), MSB2LSB(0x03)}, false, false};
-const font_char B = {5, {MSB2LSB(0xFF), MSB2LSB(0x91), MSB2LSB(0x91), MSB2LSB(0x91), MSB2LSB(0x6E)}, false, false};
-const font_char C = {6, {MSB2LSB(0x3C), MSB2LSB(0x42), MSB2LSB(0x81), MSB2LSB(0x81), MSB2LSB(0x81), MSB2LSB(0x66)}, false, false};
-const font_char D = {5, {MSB2LSB(0xFF), MSB2LSB(0x81), MSB2LSB(0x81), MSB2LSB(0x42), MSB2LSB(0x3C)}, false, false};
-const font_char E = {5, {MSB2LSB(0xFF), MSB2LSB(0x91), MSB2LSB(0x91), MSB2LSB(0x91), MSB2LSB(0x91)}, false, false};
-const font_char F = {4, {MSB2LSB(0xFF), MSB2LSB(0x90), MSB2LSB(0x90), MSB2LSB(0x80)}, false, false};
-const font_char G = {6, {MSB2LSB(0x3C), MSB2LSB(0x42), MSB2LSB(0x81), MSB2LSB(0x89), MSB2LSB(0x89), MSB2LSB(0x6E)}, false, false};
-const font_char H = {5, {MSB2LSB(0xFF), MSB2LSB(0x10), MSB2LSB(0x10), MSB2LSB(0x10), MSB2LSB(0xFF)}, false, false};
-const font_char I = {1, {MSB2LSB(0xFF)}, false, false};
-const font_char J = {4, {MSB2LSB(0x06), MSB2LSB(0x01), MSB2LSB(0x01), MSB2LSB(0xFE)}, false, false};
-const font_char K = {5, {MSB2LSB(0xFF), MSB2LSB(0x10), MSB2LSB(0x38), MSB2LSB(0x46), MSB2LSB(0x81)}, false, false};
-const font_char L = {4, {MSB2LSB(0xFF), MSB2LSB(0x01), MSB2LSB(0x01), MSB2LSB(0x01)}, false, false};
-const font_char M = {7, {MSB2LSB(0xFF), MSB2LSB(0x60), MSB2LSB(0x1E), MSB2LSB(0x01), MSB2LSB(0x1E), MSB2LSB(0x60), MSB2LSB(0xFF)}, false, false};
-const font_char N = {6, {MSB2LSB(0xFF), MSB2LSB(0x40), MSB2LSB(0x30), MSB2LSB(0x0C), MSB2LSB(0x02), MSB2LSB(0xFF)}, false, false};
-const font_char O = {6, {MSB2LSB(0x3C), MSB2LSB(0x42), MSB2LSB(0x81), MSB2LSB(0x81), MSB2LSB(0x42), MSB2LSB(0x3C)}, false, false};
-const font_char P = {5, {MSB2LSB(0xFF), MSB2LSB(0x88), MSB2LSB(0x88), MSB2LSB(0x88), MSB2LSB(0x70)}, false, false};
-const font_char Q = {6, {MSB2LSB(0x3C), MSB2LSB(0x42), MSB2LSB(0x81), MSB2LSB(0x83), MSB2LSB(0x42), MSB2LSB(0x3D)}, false, false};
-const font_char R = {5, {MSB2LSB(0xFF), MSB2LSB(0x98), MSB2LSB(0x94), MSB2LSB(0x92), MSB2LSB(0x61)}, false, false};
-const font_char S = {5, {MSB2LSB(0x66), MSB2LSB(0x91), MSB2LSB(0x91), MSB2LSB(0x91), MSB2LSB(0x4E)}, false, false};
-const font_char T = {5, {MSB2LSB(0x80), MSB2LSB(0x80), MSB2LSB(0xFF), MSB2LSB(0x80), MSB2LSB(0x80)}, false, false};
-const font_char U = {6, {MSB2LSB(0xFC), MSB2LSB(0x02), MSB2LSB(0x01), MSB2LSB(0x01), MSB2LSB(0x02), MSB2LSB(0xFC)}, false, false};
-const font_char V = {5, {MSB2LSB(0xC0), MSB2LSB(0x3E), MSB2LSB(0x01), MSB2LSB(0x3E), MSB2LSB(0xC0)}, false, false};
-const font_char W = {5, {MSB2LSB(0xFE), MSB2LSB(0x01), MSB2LSB(0x7E), MSB2LSB(0x01), MSB2LSB(0xFE)}, false, false};
-const font_char X = {6, {MSB2LSB(0x81), MSB2LSB(0x66), MSB2LSB(0x18), MSB2LSB(0x18), MSB2LSB(0x66), MSB2LSB(0x81)}, false, false};
-const font_char Y = {5, {MSB2LSB(0x80), MSB2LSB(0x60), MSB2LSB(0x1F), MSB2LSB(0x60), MSB2LSB(0x80)}, false, false};
-const font_char Z = {5, {MSB2LSB(0x83), MSB2LSB(0x85), MSB2LSB(0x99), MSB2LSB(0xA1), MSB2LSB(0xC1)}, false, false};
-
-const font_char Wifi_Full = {32,
-                             {MSB2LSB(0x0),  MSB2LSB(0x0),  MSB2LSB(0x0),  MSB2LSB(0x0),  MSB2LSB(0x0),  MSB2LSB(0x0),
-                              MSB2LSB(0x0),  MSB2LSB(0x0),  MSB2LSB(0x0),  MSB2LSB(0x0),  MSB2LSB(0x40), MSB2LSB(0x50),
-                              MSB2LSB(0x50), MSB2LSB(0x54), MSB2LSB(0x54), MSB2LSB(0x55), MSB2LSB(0x54), MSB2LSB(0x54),
-                              MSB2LSB(0x50), MSB2LSB(0x50), MSB2LSB(0x40), MSB2LSB(0x0),  MSB2LSB(0x0),  MSB2LSB(0x0),
-                              MSB2LSB(0x0),  MSB2LSB(0x0),  MSB2LSB(0x0),  MSB2LSB(0x0),  MSB2LSB(0x0),  MSB2LSB(0x0),
-                              MSB2LSB(0x0),  MSB2LSB(0x0)}, false, true};
-
-const font_char Wifi_Half = {32,
-                             {MSB2LSB(0x0),  MSB2LSB(0x0),  MSB2LSB(0x0),  MSB2LSB(0x0),  MSB2LSB(0x0),  MSB2LSB(0x0),
-                              MSB2LSB(0x0),  MSB2LSB(0x0),  MSB2LSB(0x0),  MSB2LSB(0x0),  MSB2LSB(0x0),  MSB2LSB(0x10),
-                              MSB2LSB(0x10), MSB2LSB(0x14), MSB2LSB(0x14), MSB2LSB(0x15), MSB2LSB(0x14), MSB2LSB(0x14),
-                              MSB2LSB(0x10), MSB2LSB(0x10), MSB2LSB(0x0),  MSB2LSB(0x0),  MSB2LSB(0x0),  MSB2LSB(0x0),
-                              MSB2LSB(0x0),  MSB2LSB(0x0),  MSB2LSB(0x0),  MSB2LSB(0x0),  MSB2LSB(0x0),  MSB2LSB(0x0),
-                              MSB2LSB(0x0),  MSB2LSB(0x0)}, false, true};
-
-const font_char Wifi_Low = {32, {MSB2LSB(0x0), MSB2LSB(0x0), MSB2LSB(0x0), MSB2LSB(0x0), MSB2LSB(0x0), MSB2LSB(0x0),
-                                 MSB2LSB(0x0), MSB2LSB(0x0), MSB2LSB(0x0), MSB2LSB(0x0), MSB2LSB(0x0), MSB2LSB(0x0),
-                                 MSB2LSB(0x0), MSB2LSB(0x4), MSB2LSB(0x4), MSB2LSB(0x5), MSB2LSB(0x4), MSB2LSB(0x4),
-                                 MSB2LSB(0x0), MSB2LSB(0x0), MSB2LSB(0x0), MSB2LSB(0x0), MSB2LSB(0x0), MSB2LSB(0x0),
-                                 MSB2LSB(0x0), MSB2LSB(0x0), MSB2LSB(0x0), MSB2LSB(0x0), MSB2LSB(0x0), MSB2LSB(0x0),
-                                 MSB2LSB(0x0), MSB2LSB(0x0)}, false, true};
-
-const font_char Wifi_No = {32,
-                           {MSB2LSB(0x0),  MSB2LSB(0x0),  MSB2LSB(0x0),  MSB2LSB(0x0),  MSB2LSB(0x0),  MSB2LSB(0x0),
-                            MSB2LSB(0x0),  MSB2LSB(0x0),  MSB2LSB(0x0),  MSB2LSB(0x0),  MSB2LSB(0x40), MSB2LSB(0x51),
-                            MSB2LSB(0x52), MSB2LSB(0x54), MSB2LSB(0x5C), MSB2LSB(0x55), MSB2LSB(0x74), MSB2LSB(0x50),
-                            MSB2LSB(0xD0), MSB2LSB(0x50), MSB2LSB(0x40), MSB2LSB(0x0),  MSB2LSB(0x0),  MSB2LSB(0x0),
-                            MSB2LSB(0x0),  MSB2LSB(0x0),  MSB2LSB(0x0),  MSB2LSB(0x0),  MSB2LSB(0x0),  MSB2LSB(0x0),
-                            MSB2LSB(0x0),  MSB2LSB(0x0)}, false, true};
-
-const font_char Battery_Full = {32, {MSB2LSB(0xFF), MSB2LSB(0x81), MSB2LSB(0xBD), MSB2LSB(0xBD), MSB2LSB(0xBD),
-                                     MSB2LSB(0xBD), MSB2LSB(0xBD), MSB2LSB(0xBD), MSB2LSB(0xBD), MSB2LSB(0xBD),
-                                     MSB2LSB(0x81), MSB2LSB(0xBD), MSB2LSB(0xBD), MSB2LSB(0xBD), MSB2LSB(0xBD),
-                                     MSB2LSB(0xBD), MSB2LSB(0xBD), MSB2LSB(0xBD), MSB2LSB(0xBD), MSB2LSB(0x81),
-                                     MSB2LSB(0xBD), MSB2LSB(0xBD), MSB2LSB(0xBD), MSB2LSB(0xBD), MSB2LSB(0xBD),
-                                     MSB2LSB(0xBD), MSB2LSB(0xBD), MSB2LSB(0xBD), MSB2LSB(0x81), MSB2LSB(0xFF),
-                                     MSB2LSB(0x3C), MSB2LSB(0x3C)}, false, true};
-
-const font_char Battery_Medium = {32, {MSB2LSB(0xFF), MSB2LSB(0x81), MSB2LSB(0xBD), MSB2LSB(0xBD), MSB2LSB(0xBD),
-                                       MSB2LSB(0xBD), MSB2LSB(0xBD), MSB2LSB(0xBD), MSB2LSB(0xBD), MSB2LSB(0xBD),
-                                       MSB2LSB(0x81), MSB2LSB(0xBD), MSB2LSB(0xBD), MSB2LSB(0xBD), MSB2LSB(0xBD),
-                                       MSB2LSB(0x81), MSB2LSB(0x81), MSB2LSB(0x81), MSB2LSB(0x81), MSB2LSB(0x81),
-                                       MSB2LSB(0x81), MSB2LSB(0x81), MSB2LSB(0x81), MSB2LSB(0x81), MSB2LSB(0x81),
-                                       MSB2LSB(0x81), MSB2LSB(0x81), MSB2LSB(0x81), MSB2LSB(0x81), MSB2LSB(0xFF),
-                                       MSB2LSB(0x3C), MSB2LSB(0x3C)}, false, true};
-
-const font_char Battery_Low = {32, {MSB2LSB(0xFF), MSB2LSB(0x81), MSB2LSB(0x81), MSB2LSB(0x81), MSB2LSB(0x81),
-                                    MSB2LSB(0x81), MSB2LSB(0x81), MSB2LSB(0x81), MSB2LSB(0x81), MSB2LSB(0x81),
-                                    MSB2LSB(0x81), MSB2LSB(0x81), MSB2LSB(0x81), MSB2LSB(0x81), MSB2LSB(0x81),
-                                    MSB2LSB(0x81), MSB2LSB(0x81), MSB2LSB(0x81), MSB2LSB(0x81), MSB2LSB(0x81),
-                                    MSB2LSB(0x81), MSB2LSB(0x81), MSB2LSB(0x81), MSB2LSB(0x81), MSB2LSB(0x81),
-                                    MSB2LSB(0x81), MSB2LSB(0x81), MSB2LSB(0x81), MSB2LSB(0x81), MSB2LSB(0xFF),
-                                    MSB2LSB(0x3C), MSB2LSB(0x3C)}, false, true};
-
-const font_char Battery_Charging = {32, {MSB2LSB(0xFF), MSB2LSB(0x81), MSB2LSB(0xBD), MSB2LSB(0xBD), MSB2LSB(0xBD),
-                                         MSB2LSB(0xBD), MSB2LSB(0xBD), MSB2LSB(0xBD), MSB2LSB(0xBD), MSB2LSB(0xBD),
-                                         MSB2LSB(0x81), MSB2LSB(0xBD), MSB2LSB(0xBD), MSB2LSB(0xBD), MSB2LSB(0xBD),
-                                         MSB2LSB(0x91), MSB2LSB(0x89), MSB2LSB(0x85), MSB2LSB(0x89), MSB2LSB(0x91),
-                                         MSB2LSB(0xA1), MSB2LSB(0x91), MSB2LSB(0x89), MSB2LSB(0x85), MSB2LSB(0x89),
-                                         MSB2LSB(0x91), MSB2LSB(0xA1), MSB2LSB(0x81), MSB2LSB(0x81), MSB2LSB(0xFF),
-                                         MSB2LSB(0x3C), MSB2LSB(0x3C)}, false, true};
-
-const font_char MyQ_Connected = {32, {MSB2LSB(0x0),  MSB2LSB(0x0),  MSB2LSB(0x0),  MSB2LSB(0x1F), MSB2LSB(0x8),
-                                      MSB2LSB(0x10), MSB2LSB(0x10), MSB2LSB(0xF),  MSB2LSB(0x8),  MSB2LSB(0x10),
-                                      MSB2LSB(0x10), MSB2LSB(0xF),  MSB2LSB(0x0),  MSB2LSB(0x0),  MSB2LSB(0x11),
-                                      MSB2LSB(0xA),  MSB2LSB(0x4),  MSB2LSB(0x8),  MSB2LSB(0x10), MSB2LSB(0x0),
-                                      MSB2LSB(0x3C), MSB2LSB(0x42), MSB2LSB(0x81), MSB2LSB(0x85), MSB2LSB(0x42),
-                                      MSB2LSB(0x3D), MSB2LSB(0x0),  MSB2LSB(0x0),  MSB2LSB(0x0),  MSB2LSB(0x0),
-                                      MSB2LSB(0x0),  MSB2LSB(0x0)}, false, true};
-
-const font_char MyQ_Not_Connected = {32, {MSB2LSB(0x0),  MSB2LSB(0x0),  MSB2LSB(0x0),  MSB2LSB(0x1F), MSB2LSB(0x8),
-                                          MSB2LSB(0x10), MSB2LSB(0x10), MSB2LSB(0xF),  MSB2LSB(0x8),  MSB2LSB(0x10),
-                                          MSB2LSB(0x10), MSB2LSB(0xF),  MSB2LSB(0x0),  MSB2LSB(0x0),  MSB2LSB(0x11),
-                                          MSB2LSB(0xA),  MSB2LSB(0x4),  MSB2LSB(0x8),  MSB2LSB(0x10), MSB2LSB(0x0),
-                                          MSB2LSB(0x3C), MSB2LSB(0x42), MSB2LSB(0x81), MSB2LSB(0x85), MSB2LSB(0x42),
-                                          MSB2LSB(0x3D), MSB2LSB(0x0),  MSB2LSB(0x0),  MSB2LSB(0x0),  MSB2LSB(0x0),
-                                          MSB2LSB(0x0),  MSB2LSB(0x0)}, true, true};
-
-// Alignment specfic ICONs
-const font_char Arrow_Up = {15,{MSB2LSB(0x0), MSB2LSB(0x2), MSB2LSB(0x6), MSB2LSB(0xE), MSB2LSB(0x1E), MSB2LSB(0x3E),
-                                MSB2LSB(0x7E), MSB2LSB(0xFE), MSB2LSB(0x7E), MSB2LSB(0x3E), MSB2LSB(0x1E), MSB2LSB(0xE),
-                                MSB2LSB(0x6), MSB2LSB(0x2), MSB2LSB(0x0)}, false, false};
-
-const font_char Arrow_Down = {15,{MSB2LSB(0x0), MSB2LSB(0x40), MSB2LSB(0x60), MSB2LSB(0x70), MSB2LSB(0x78), MSB2LSB(0x7C),
-                               MSB2LSB(0x7E), MSB2LSB(0x7F), MSB2LSB(0x7E), MSB2LSB(0x7C), MSB2LSB(0x78), MSB2LSB(0x70),
-                               MSB2LSB(0x60), MSB2LSB(0x40), MSB2LSB(0x0)}, false, false};
-
-const font_char Empty_Menu_Shift = {15, {0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0}, false, false};
-
-const font_char Enter = {32, {MSB2LSB(0x7C), MSB2LSB(0x7C), MSB2LSB(0x7C), MSB2LSB(0x7C), MSB2LSB(0x7C), MSB2LSB(0x0),
-                              MSB2LSB(0xFF), MSB2LSB(0x91), MSB2LSB(0x91), MSB2LSB(0x91), MSB2LSB(0x0),  MSB2LSB(0xFF),
-                              MSB2LSB(0x60), MSB2LSB(0x3C), MSB2LSB(0x6),  MSB2LSB(0xFF), MSB2LSB(0x0),  MSB2LSB(0x80),
-                              MSB2LSB(0x80), MSB2LSB(0xFF), MSB2LSB(0x80), MSB2LSB(0x80), MSB2LSB(0x0),  MSB2LSB(0xFF),
-                              MSB2LSB(0x91), MSB2LSB(0x91), MSB2LSB(0x91), MSB2LSB(0x0),  MSB2LSB(0xFF), MSB2LSB(0x90),
-                              MSB2LSB(0x98), MSB2LSB(0x77)}, false, false};
-
 const /*__flash*/ qr_code_t qr_code_myq_v3[] = {
                                                 MSB2LSB(0xfe), MSB2LSB(0x82), MSB2LSB(0xba), MSB2LSB(0xba), MSB2LSB(0xba), MSB2LSB(0x82), MSB2LSB(0xfe), MSB2LSB(0x0), MSB2LSB(0xce), MSB2LSB(0x38), MSB2LSB(0x2b), MSB2LSB(0xfc), MSB2LSB(0x4b), MSB2LSB(0x54), MSB2LSB(0x43), MSB2LSB(0x68), MSB2LSB(0xf3), MSB2LSB(0xfd), MSB2LSB(0x33), MSB2LSB(0x3c), MSB2LSB(0xee), MSB2LSB(0x0), MSB2LSB(0xfe), MSB2LSB(0x82), MSB2LSB(0xba), MSB2LSB(0xba), MSB2LSB(0xba), MSB2LSB(0x82), MSB2LSB(0xfe), MSB2LSB(0x0), MSB2LSB(0x0), MSB2LSB(0x0), MSB2LSB(0x0), MSB2LSB(0x0), MSB2LSB(0x0), MSB2LSB(0x0), MSB2LSB(0x0), MSB2LSB(0x0), MSB2LSB(0x0), MSB2LSB(0x0), MSB2LSB(0x0), MSB2LSB(0x0), MSB2LSB(0x0), MSB2LSB(0x0), MSB2LSB(0x0), 
                                                 MSB2LSB(0xed), MSB2LSB(0xe4), MSB2LSB(0xb3), MSB2LSB(0xd7), MSB2LSB(0x5), MSB2LSB(0x9c), MSB2LSB(0xaa), MSB2LSB(0x4b), MSB2LSB(0x10), MSB2LSB(0xed), MSB2LSB(0x9b), MSB2LSB(0xb3), MSB2LSB(0xa8), MSB2LSB(0x45), MSB2LSB(0x63), MSB2LSB(0x8b), MSB2LSB(0xd8), MSB2LSB(0x8d), MSB2LSB(0x1b), MSB2LSB(0x7b), MSB2LSB(0x60), MSB2LSB(0xd5), MSB2LSB(0x7b), MSB2LSB(0xdb), MSB2LSB(0xe0), MSB2LSB(0x35), MSB2LSB(0x3b), MSB2LSB(0x9b), MSB2LSB(0x80), MSB2LSB(0x0), MSB2LSB(0x0), MSB2LSB(0x0), MSB2LSB(0x0), MSB2LSB(0x0), MSB2LSB(0x0), MSB2LSB(0x0), MSB2LSB(0x0), MSB2LSB(0x0), MSB2LSB(0x0), MSB2LSB(0x0), MSB2LSB(0x0), MSB2LSB(0x0), MSB2LSB(0x0), MSB2LSB(0x0), MSB2LSB(0x0), 
@@ -312,85 +170,12 @@ const /*__flash*/ qr_code_t qr_code_myq_v7[] = {
                                             };
 
 
-// Characters array definition
-const font_char *font_array[255] = {[' '] = &Space,
-                                    ['-'] = &Dash,
-                                    ['.'] = &Point,
-                                    ['/'] = &Slash,
-                                    ['0'] = &Zero,
-                                    &One,
-                                    &Two,
-                                    &Three,
-                                    &Four,
-                                    &Five,
-                                    &Six,
-                                    &Seven,
-                                    &Eight,
-                                    &Nine,
-                                    ['A'] = &A,
-                                    &B,
-                                    &C,
-                                    &D,
-                                    &E,
-                                    &F,
-                                    &G,
-                                    &H,
-                                    &I,
-                                    &J,
-                                    &K,
-                                    &L,
-                                    &M,
-                                    &N,
-                                    &O,
-                                    &P,
-                                    &Q,
-                                    &R,
-                                    &S,
-                                    &T,
-                                    &U,
-                                    &V,
-                                    &W,
-                                    &X,
-                                    &Y,
-                                    &Z,
-                                    ['a'] = &A,
-                                    &B,
-                                    &C,
-                                    &D,
-                                    &E,
-                                    &F,
-                                    &G,
-                                    &H,
-                                    &I,
-                                    &J,
-                                    &K,
-                                    &L,
-                                    &M,
-                                    &N,
-                                    &O,
-                                    &P,
-                                    &Q,
-                                    &R,
-                                    &S,
-                                    &T,
-                                    &U,
-                                    &V,
-                                    &W,
-                                    &X,
-                                    &Y,
-                                    &Z,
-                                    [128] = &Wifi_Full,
-                                    &Wifi_Half,
-                                    &Wifi_Low,
-                                    &Wifi_No,
-                                    [136] = &Battery_Full,
-                                    &Battery_Medium,
-                                    &Battery_Low,
-                                    &Battery_Charging,
-                                    [144] = &MyQ_Connected,
-                                    &MyQ_Not_Connected,
-                                    NULL,
-                                    [163] = &Arrow_Up,
-                                    &Arrow_Down,
-                                    &Empty_Menu_Shift,
-                                    &Enter};
+// The glyphs themselves are compiled from source/hal/font/lcd_font_4_22.font into lcd_font_packed.c at build time
+const font_glyph_t *font_glyph(uint8_t code)
+{
+    if(code < FONT_FIRST_CODE || code > FONT_LAST_CODE || font_map[code - FONT_FIRST_CODE] == FONT_GLYPH_NONE)
+    {
+        return 0;
+    }
+    return &font_glyphs[font_map[code - FONT_FIRST_CODE]];
+}
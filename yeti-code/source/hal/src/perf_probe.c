@@ -0,0 +1,157 @@
+/** @file perf_probe.c
+ *
+ * @brief Cycle profiling probes - named static slots, dumped through the debug logger
+ *
+ * @author Rene Delgado
+ *
+ * @copyright 2023 The Chamberlain Group, LLC. All rights reserved. All
+ * information within this file and associated files, including all
+ * information and files transmitted with this file are CONFIDENTIAL
+ * and the proprietary property of The Chamberlain Group, LLC.
+ *
+ * In using the Licensed Software, Company shall not use with, combine, or
+ * incorporate any viral open source software with or into any of the Licensed
+ * Software in a manner that would require any portion of the Licensed software to
+ * be (i) disclosed or distributed in source code form; (ii) licensed for the
+ * purpose of making derivative works; or (iii) distributable or redistributable
+ * at no charge.
+ */
+
+#include <inttypes.h>
+#include <string.h>
+#include "sl_sleeptimer.h"
+#include "debug_log.h"
+#include "perf_probe.h"
+
+#if PERF_PROBE_ENABLE == true
+
+/**
+ * @brief Probe names, in perf_probe_id_e order.
+ */
+static const char *const perf_probe_names[PERF_PROBE_NUM] = {
+    "cbroker_rx_byte", "cbroker_tx_set_next_byte", "stuff_font",         "lcd_update",
+    "lcd_flush_page",  "TIMER2_IRQHandler",        "app_process_action",
+};
+
+/**
+ * @brief Boot milestone names, in perf_probe_boot_e order.
+ */
+static const char *const perf_probe_boot_names[PERF_PROBE_BOOT_NUM] = {"first frame", "first ack"};
+
+static perf_probe_stats_t perf_probes[PERF_PROBE_NUM];
+static uint32_t           perf_probe_boot_ms[PERF_PROBE_BOOT_NUM]; ///< Milliseconds from reset, 0 until reached.
+static bool               perf_probe_boot_done[PERF_PROBE_BOOT_NUM];
+static uint32_t           perf_probe_last_dump = 0;
+
+static void perf_probe_clear(void)
+{
+    for(uint8_t id = 0; id < PERF_PROBE_NUM; id++)
+    {
+        perf_probes[id] = (perf_probe_stats_t){.count = 0, .min = UINT32_MAX, .max = 0, .sum = 0};
+    }
+}
+#endif /* PERF_PROBE_ENABLE */
+
+void perf_probe_init(void)
+{
+#if PERF_PROBE_ENABLE == true
+    cycle_counter_init();
+    perf_probe_clear();
+    perf_probe_last_dump = sl_sleeptimer_get_tick_count();
+#endif /* PERF_PROBE_ENABLE */
+}
+
+void perf_probe_record(perf_probe_id_e id, uint32_t cycles)
+{
+#if PERF_PROBE_ENABLE == true
+    if(PERF_PROBE_NUM > id)
+    {
+        perf_probe_stats_t *probe = &perf_probes[id];
+
+        probe->count++;
+        probe->sum += cycles;
+        if(cycles < probe->min)
+        {
+            probe->min = cycles;
+        }
+        if(cycles > probe->max)
+        {
+            probe->max = cycles;
+        }
+    }
+#else
+    (void)id;
+    (void)cycles;
+#endif /* PERF_PROBE_ENABLE */
+}
+
+void perf_probe_boot_mark(perf_probe_boot_e mark)
+{
+#if PERF_PROBE_ENABLE == true
+    // The sleeptimer starts counting at reset.
+    if((PERF_PROBE_BOOT_NUM > mark) && !perf_probe_boot_done[mark])
+    {
+        perf_probe_boot_ms[mark]   = sl_sleeptimer_tick_to_ms(sl_sleeptimer_get_tick_count());
+        perf_probe_boot_done[mark] = true;
+    }
+#else
+    (void)mark;
+#endif /* PERF_PROBE_ENABLE */
+}
+
+uint8_t perf_probe_get(perf_probe_id_e id, perf_probe_stats_t *stats)
+{
+    uint8_t err = 1;
+#if PERF_PROBE_ENABLE == true
+    if((PERF_PROBE_NUM > id) && (NULL != stats))
+    {
+        *stats = perf_probes[id];
+        err    = 0;
+    }
+#else
+    (void)id;
+    (void)stats;
+#endif /* PERF_PROBE_ENABLE */
+
+    return err;
+}
+
+void perf_probe_dump(void)
+{
+#if PERF_PROBE_ENABLE == true
+    for(uint8_t id = 0; id < PERF_PROBE_NUM; id++)
+    {
+        const perf_probe_stats_t probe = perf_probes[id];
+
+        if(probe.count)
+        {
+            debug_log_print((const int8_t *)"Perf - %s: n=%" PRIu32 " min=%" PRIu32 " max=%" PRIu32 " avg=%" PRIu32
+                                            "\r\n",
+                            perf_probe_names[id], probe.count, probe.min, probe.max,
+                            (uint32_t)(probe.sum / probe.count));
+        }
+    }
+    for(uint8_t mark = 0; mark < PERF_PROBE_BOOT_NUM; mark++)
+    {
+        if(perf_probe_boot_done[mark])
+        {
+            debug_log_print((const int8_t *)"Perf - boot %s: %" PRIu32 " ms\r\n", perf_probe_boot_names[mark],
+                            perf_probe_boot_ms[mark]);
+        }
+    }
+    perf_probe_clear();
+#endif /* PERF_PROBE_ENABLE */
+}
+
+void perf_probe_poll(void)
+{
+#if PERF_PROBE_ENABLE == true
+    uint32_t now = sl_sleeptimer_get_tick_count();
+
+    if((now - perf_probe_last_dump) >= sl_sleeptimer_ms_to_tick(PERF_PROBE_DUMP_PERIOD_MS))
+    {
+        perf_probe_last_dump = now;
+        perf_probe_dump();
+    }
+#endif /* PERF_PROBE_ENABLE */
+}
@@ -0,0 +1,221 @@
+/** @file screen.c
+ *
+ * @brief Retained screen model, drawn on the display only when it changes
+ *
+ * @author Rene Delgado
+ *
+ * @copyright 2023 The Chamberlain Group, LLC. All rights reserved. All
+ * information within this file and associated files, including all
+ * information and files transmitted with this file are CONFIDENTIAL
+ * and the proprietary property of The Chamberlain Group, LLC.
+ *
+ * In using the Licensed Software, Company shall not use with, combine, or
+ * incorporate any viral open source software with or into any of the Licensed
+ * Software in a manner that would require any portion of the Licensed software to
+ * be (i) disclosed or distributed in source code form; (ii) licensed for the
+ * purpose of making derivative works; or (iii) distributable or redistributable
+ * at no charge.
+ */
+#include <string.h>
+
+#include "em_core.h"
+#include "screen.h"
+
+#define SCREEN_ERROR_LINE (1) ///< Line number out of the layout.
+#define SCREEN_ERROR_SIZE (2) ///< Text longer than a line.
+
+// A QR code covers the whole screen, the text lines are only drawn without it. lcd_put_line() skips the lines that
+// still show the same text
+static void screen_draw(screen_t *const self, const screen_state_t *wanted, bool from_blank)
+{
+    if(from_blank)
+    {
+        lcd_clear(self->lcd);
+    }
+    if(SCREEN_QR_NONE != wanted->qr_version)
+    {
+        if(from_blank)
+        {
+            lcd_put_qr_code(self->lcd, wanted->qr_version, 0, 0, 0, 0);
+        }
+        return;
+    }
+    for(uint8_t line = 0; line < LCD_LINE_NUM; line++)
+    {
+        if(wanted->line_mask & (1U << line))
+        {
+            lcd_put_line(self->lcd, wanted->lines[line], LCD_CHAR_NUM, line, 0);
+        }
+    }
+}
+
+#if SCREEN_CACHE_ENTRIES > 0
+// The part of a state that makes the pixels: the backlight and the text a QR code or the line mask hides are left out
+static void screen_key(const screen_state_t *state, screen_state_t *key)
+{
+    memset(key, 0, sizeof(*key));
+    key->qr_version = state->qr_version;
+    if(SCREEN_QR_NONE != state->qr_version)
+    {
+        return;
+    }
+    key->line_mask = state->line_mask;
+    for(uint8_t line = 0; line < LCD_LINE_NUM; line++)
+    {
+        if(state->line_mask & (1U << line))
+        {
+            memcpy(key->lines[line], state->lines[line], LCD_CHAR_NUM);
+        }
+    }
+}
+
+static screen_cache_entry_t *screen_cache_find(screen_t *const self, const screen_state_t *key)
+{
+    for(uint8_t i = 0; i < SCREEN_CACHE_ENTRIES; i++)
+    {
+        if(self->cache[i].is_used && (0 == memcmp(&self->cache[i].key, key, sizeof(*key))))
+        {
+            return &self->cache[i];
+        }
+    }
+    return NULL;
+}
+
+// A free entry first, otherwise the least recently used one
+static screen_cache_entry_t *screen_cache_victim(screen_t *const self)
+{
+    screen_cache_entry_t *victim = &self->cache[0];
+
+    for(uint8_t i = 0; i < SCREEN_CACHE_ENTRIES; i++)
+    {
+        if(!self->cache[i].is_used)
+        {
+            return &self->cache[i];
+        }
+        if(self->cache[i].last_used < victim->last_used)
+        {
+            victim = &self->cache[i];
+        }
+    }
+    return victim;
+}
+#endif /* SCREEN_CACHE_ENTRIES */
+
+// Screens are switched to from blank: a cached one is loaded, another one is drawn and kept for the next switch
+static void screen_switch(screen_t *const self, const screen_state_t *wanted)
+{
+#if SCREEN_CACHE_ENTRIES > 0
+    screen_state_t        key;
+    screen_cache_entry_t *entry;
+
+    screen_key(wanted, &key);
+    entry = screen_cache_find(self, &key);
+    if(NULL != entry)
+    {
+        lcd_load_frame(self->lcd, &entry->frame);
+        entry->last_used = ++self->cache_uses;
+        self->cache_hits++;
+        return;
+    }
+#endif /* SCREEN_CACHE_ENTRIES */
+
+    self->cache_misses++;
+    screen_draw(self, wanted, true);
+#if SCREEN_CACHE_ENTRIES > 0
+    entry = screen_cache_victim(self);
+    entry->is_used = lcd_save_frame(self->lcd, &entry->frame);
+    if(entry->is_used)
+    {
+        entry->key       = key;
+        entry->last_used = ++self->cache_uses;
+    }
+#endif /* SCREEN_CACHE_ENTRIES */
+}
+
+void screen_init(screen_t *const self, lcd_t *lcd)
+{
+    memset(self, 0, sizeof(*self));
+    self->lcd = lcd;
+}
+
+void screen_set_qr(screen_t *const self, uint8_t qr_version)
+{
+    self->wanted.qr_version = qr_version;
+    self->changes++;
+}
+
+uint8_t screen_set_line(screen_t *const self, uint8_t line, const uint8_t *str, size_t size)
+{
+    if(line >= LCD_LINE_NUM)
+    {
+        return SCREEN_ERROR_LINE;
+    }
+    if(size > LCD_CHAR_NUM)
+    {
+        return SCREEN_ERROR_SIZE;
+    }
+
+    memset(self->wanted.lines[line], ' ', LCD_CHAR_NUM);
+    memcpy(self->wanted.lines[line], str, size);
+    self->wanted.line_mask |= (1U << line);
+    self->changes++;
+    return 0;
+}
+
+void screen_set_backlight(screen_t *const self, bool on)
+{
+    self->wanted.backlight = on;
+    self->changes++;
+}
+
+bool screen_refresh(screen_t *const self)
+{
+    screen_state_t wanted;
+    CORE_DECLARE_IRQ_STATE;
+
+    // Steady state: no setter ran, nothing is copied nor compared
+    if(self->is_shown && (self->changes == self->shown_changes))
+    {
+        return false;
+    }
+
+    // The setters run from the UART callback too: the state is drawn from a copy taken in one go
+    CORE_ENTER_ATOMIC();
+    wanted              = self->wanted;
+    self->shown_changes = self->changes;
+    CORE_EXIT_ATOMIC();
+
+    // Set again to what is shown already
+    if(self->is_shown && (0 == memcmp(&wanted, &self->shown, sizeof(wanted))))
+    {
+        return false;
+    }
+
+    // A new QR code slot or a removed line switches screens, only the changed lines are drawn otherwise
+    lcd_draw_begin(self->lcd);
+    if(!self->is_shown || (wanted.qr_version != self->shown.qr_version) || (self->shown.line_mask & ~wanted.line_mask))
+    {
+        screen_switch(self, &wanted);
+    }
+    else
+    {
+        screen_draw(self, &wanted, false);
+    }
+    lcd_commit(self->lcd);
+
+    if(!self->is_shown || (wanted.backlight != self->shown.backlight))
+    {
+        if(wanted.backlight)
+        {
+            lcd_backlight_on();
+        }
+        else
+        {
+            lcd_backlight_off();
+        }
+    }
+
+    self->shown    = wanted;
+    self->is_shown = true;
+    return true;
+}
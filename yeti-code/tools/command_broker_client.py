@@ -8,12 +8,15 @@ Author:  Rene Delgado  - rene.delgado@chamberlain.com
 Python: 3.10.6
 """
 
+import sys
 import time
 import threading
 import serial
 from inputdata import display_boot_display_rx as inputdata
 
 port = 'COM4' # Define your Windows (COMx) or Linux uart port
+if len(sys.argv) > 1:
+    port = sys.argv[1] # e.g. the pseudo-terminal of yeti-display-host --pty-link /tmp/yeti
 
 print("|------------------------------------------------------------------------------|")
 print("|                                                                              |")
@@ -0,0 +1,224 @@
+#!/usr/bin/python3
+"""
+Compiles the LCD font source into the packed font tables the renderer reads from flash.
+
+The glyph columns are stored once in a column blob, a byte per column with bit 0 on the top row, trimmed icons without
+their blank columns. A glyph table holds the offset, width and drawn bounds of each glyph, and a code map gives the
+glyph of each character code in the range the font covers. A width table gives the drawn columns of every byte code,
+a space for the codes without a glyph, so a line is measured without looking its glyphs up.
+
+usage: font_compiler.py <font source> <output .c> <output .h>
+
+Python: 3.10.6
+"""
+
+import os
+import sys
+
+ROWS = 8            # Pixel rows of a glyph, a column fits a byte
+MAX_COLUMNS = 255   # Glyph widths and bounds are bytes
+MAX_CODE = 254      # Highest character code
+CODE_COUNT = 256    # Entries of the width table, every byte code
+GLYPH_NONE = 0xFF   # Code map entry of a code without a glyph
+BLOB_BYTES = 0xFFFF # Glyph offsets are 16 bit
+
+
+class FontError(Exception):
+    pass
+
+
+class Glyph:
+    def __init__(self, name, codes, blinking, trimmable, line):
+        self.name = name
+        self.codes = codes
+        self.blinking = blinking
+        self.trimmable = trimmable
+        self.line = line
+        self.rows = []
+        self.columns = []
+        self.left = 0
+        self.right = 0
+        self.offset = 0
+
+
+def parse(path):
+    glyphs = []
+    glyph = None
+
+    with open(path, encoding="ascii") as source:
+        for number, text in enumerate(source, 1):
+            text = text.strip()
+            if not text or text.startswith("//"):
+                continue
+            where = "%s:%u" % (path, number)
+            words = text.split()
+            if words[0] == "glyph":
+                if glyph is not None and len(glyph.rows) != ROWS:
+                    raise FontError("%s: glyph %s has %u rows instead of %u" % (glyph.line, glyph.name,
+                                                                                len(glyph.rows), ROWS))
+                if len(words) < 3:
+                    raise FontError("%s: a glyph needs a name and a code" % where)
+                codes = []
+                flags = set()
+                for word in words[2:]:
+                    if word in ("blinking", "trimmable"):
+                        flags.add(word)
+                        continue
+                    try:
+                        code = int(word, 0)
+                    except ValueError:
+                        raise FontError("%s: '%s' is neither a code nor a flag" % (where, word))
+                    if not 0 <= code <= MAX_CODE:
+                        raise FontError("%s: code %s out of 0..%u" % (where, word, MAX_CODE))
+                    codes.append(code)
+                if not codes:
+                    raise FontError("%s: glyph %s has no code" % (where, words[1]))
+                glyph = Glyph(words[1], codes, "blinking" in flags, "trimmable" in flags, where)
+                glyphs.append(glyph)
+                continue
+            if glyph is None:
+                raise FontError("%s: pixel row outside of a glyph" % where)
+            if len(glyph.rows) == ROWS:
+                raise FontError("%s: glyph %s has more than %u rows" % (where, glyph.name, ROWS))
+            if text.strip("#."):
+                raise FontError("%s: pixel rows take '#' and '.' only" % where)
+            if glyph.rows and len(text) != len(glyph.rows[0]):
+                raise FontError("%s: glyph %s rows differ in width" % (where, glyph.name))
+            if len(text) > MAX_COLUMNS:
+                raise FontError("%s: glyph %s is wider than %u columns" % (where, glyph.name, MAX_COLUMNS))
+            glyph.rows.append(text)
+
+    if glyph is not None and len(glyph.rows) != ROWS:
+        raise FontError("%s: glyph %s has %u rows instead of %u" % (glyph.line, glyph.name, len(glyph.rows), ROWS))
+    return glyphs
+
+
+def columns_of(glyph):
+    return [sum(1 << row for row in range(ROWS) if glyph.rows[row][col] == "#") for col in range(len(glyph.rows[0]))]
+
+
+def trim(glyph):
+    """
+    Drawn bounds of the glyph. A trimmable icon loses blank columns in pairs, one from each side, as long as both are
+    blank. The column past the right edge counts as blank, so the first pair also takes a single blank left column.
+    A blank icon keeps its width.
+    """
+    size = len(glyph.columns)
+    if not glyph.trimmable:
+        return 0, size
+    padded = glyph.columns + [0]
+    left, right = 0, size
+    while not padded[left] and not padded[right]:
+        if right <= left:
+            return 0, size
+        left += 1
+        right -= 1
+    return left, right
+
+
+def pack(glyphs):
+    blob = bytearray()
+
+    for glyph in glyphs:
+        glyph.columns = columns_of(glyph)
+        glyph.left, glyph.right = trim(glyph)
+        drawn = bytes(glyph.columns[glyph.left:glyph.right])
+        # Glyphs drawing the same columns share them
+        offset = blob.find(drawn) if drawn else len(blob)
+        if offset < 0:
+            offset = len(blob)
+            blob += drawn
+        glyph.offset = offset
+    if len(blob) > BLOB_BYTES:
+        raise FontError("%u columns, more than the %u a glyph offset reaches" % (len(blob), BLOB_BYTES))
+    if len(glyphs) >= GLYPH_NONE:
+        raise FontError("%u glyphs, the code map holds %u" % (len(glyphs), GLYPH_NONE - 1))
+    return blob
+
+
+def code_map(glyphs):
+    owners = {}
+
+    for index, glyph in enumerate(glyphs):
+        for code in glyph.codes:
+            if code in owners:
+                raise FontError("%s: code 0x%02X already belongs to glyph %s" % (glyph.line, code,
+                                                                                 glyphs[owners[code]].name))
+            owners[code] = index
+    if 0x20 not in owners:
+        raise FontError("the font has no space, codes without a glyph are drawn as one")
+    first, last = min(owners), max(owners)
+    return first, last, [owners.get(code, GLYPH_NONE) for code in range(first, last + 1)]
+
+
+def widths(glyphs, first, codes):
+    space = glyphs[codes[0x20 - first]]
+    table = [space.right - space.left] * CODE_COUNT
+
+    for offset, index in enumerate(codes):
+        if index != GLYPH_NONE:
+            table[first + offset] = glyphs[index].right - glyphs[index].left
+    return table
+
+
+def write_header(path, source, glyphs, blob, first, last):
+    guard = "HAL_" + os.path.basename(path).upper().replace(".", "_") + "_"
+    with open(path, "w", encoding="ascii") as out:
+        out.write("/* Generated by tools/font_compiler.py from %s, do not edit */\n\n" % os.path.basename(source))
+        out.write("#ifndef %s\n#define %s\n\n" % (guard, guard))
+        out.write("#define FONT_FIRST_CODE (%u) // Lowest code of the code map\n" % first)
+        out.write("#define FONT_LAST_CODE (%u) // Highest code of the code map\n" % last)
+        out.write("#define FONT_GLYPH_COUNT (%u) // Glyphs of the font\n" % len(glyphs))
+        out.write("#define FONT_COLUMN_COUNT (%u) // Bytes of the column blob\n" % len(blob))
+        out.write("\n#endif\n")
+
+
+def write_source(path, source, glyphs, blob, first, last, codes):
+    with open(path, "w", encoding="ascii") as out:
+        out.write("/* Generated by tools/font_compiler.py from %s, do not edit */\n\n" % os.path.basename(source))
+        out.write('#include "lcd_font_4_22.h"\n\n')
+
+        out.write("const uint8_t font_columns[FONT_COLUMN_COUNT] = {\n")
+        for start in range(0, len(blob), 12):
+            out.write("    " + " ".join("0x%02X," % byte for byte in blob[start:start + 12]) + "\n")
+        out.write("};\n\n")
+
+        out.write("const font_glyph_t font_glyphs[FONT_GLYPH_COUNT] = {\n")
+        for index, glyph in enumerate(glyphs):
+            flags = "FONT_GLYPH_BLINKING" if glyph.blinking else "0"
+            out.write("    {%4u, %3u, %3u, %3u, %s}, // %u: %s\n" % (glyph.offset, len(glyph.columns), glyph.left,
+                                                                     glyph.right, flags, index, glyph.name))
+        out.write("};\n\n")
+
+        out.write("const uint8_t font_map[FONT_LAST_CODE - FONT_FIRST_CODE + 1] = {\n")
+        for start in range(0, len(codes), 16):
+            out.write("    /* 0x%02X */ " % (first + start) +
+                      " ".join("0x%02X," % index for index in codes[start:start + 16]) + "\n")
+        out.write("};\n\n")
+
+        out.write("const uint8_t font_widths[FONT_CODE_COUNT] = {\n")
+        table = widths(glyphs, first, codes)
+        for start in range(0, CODE_COUNT, 16):
+            out.write("    /* 0x%02X */ " % start + " ".join("%3u," % width for width in table[start:start + 16]) + "\n")
+        out.write("};\n")
+
+
+def main(argv):
+    if len(argv) != 4:
+        sys.stderr.write(__doc__)
+        return 2
+    source, c_path, h_path = argv[1:]
+    try:
+        glyphs = parse(source)
+        blob = pack(glyphs)
+        first, last, codes = code_map(glyphs)
+    except (FontError, OSError) as error:
+        sys.stderr.write("font_compiler: %s\n" % error)
+        return 1
+    write_header(h_path, source, glyphs, blob, first, last)
+    write_source(c_path, source, glyphs, blob, first, last, codes)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))